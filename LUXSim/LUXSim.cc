@@ -28,6 +28,8 @@
 *				try to load if a second parameter weren't included (Kareem)
 *   28-Sep-15 - Added checks for SVN or Git repos (Kareem)
 *       06-Oct-15 - Added StackingAction class to the run manager (David W)
+*	19-Oct-26 - Added the run profiler
+*	19-Oct-26 - Added the light map builder
 */
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -62,6 +64,8 @@
 #include "LUXSimStackingAction.hh"
 #include "LUXSimOutput.hh"
 #include "LUXSimSourceCatalog.hh"
+#include "LUXSimProfiler.hh"
+#include "LUXSimLightMap.hh"
 #include "LUXSimManager.hh"
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -184,12 +188,16 @@ int main( int argc, char **argv )
 	runManager->SetUserAction( LUXSimStack );
 
 	LUXSimSourceCatalog *LUXSimSourceCat = new LUXSimSourceCatalog();
+	LUXSimProfiler *LUXSimProf = new LUXSimProfiler();
+	LUXSimLightMap *LUXSimMap = new LUXSimLightMap();
 	
 	//	This next lines are kludges so that the compiler doesn't complain about
 	//	unused variables.
 	LUXManager = LUXManager;
 	LUXSimSourceCat = LUXSimSourceCat;
 	LUXMaterials = LUXMaterials;
+	LUXSimProf = LUXSimProf;
+	LUXSimMap = LUXSimMap;
 	
 	//	Set up the visualization
 #ifdef G4VIS_USE
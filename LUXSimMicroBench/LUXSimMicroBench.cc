@@ -0,0 +1,1268 @@
+////////////////////////////////////////////////////////////////////////////////
+/*	LUXSimMicroBench.cc
+*
+* This is the main code file for the LUXSim microbenchmarks. Each of the inner
+* routines that dominates the cost of a simulation is driven on synthetic input,
+* without a run manager, geometry or physics list, and the time per call is
+* printed. This makes it practical to measure the effect of a change to one of
+* these routines without running a full simulation.
+*
+* The samplers and tables that replaced slower code are also checked against
+* what they replaced. A chi-square check fails if it's more than five standard
+* deviations above the number of degrees of freedom, and if any check fails
+* the microbench exits with a non-zero status.
+*
+* Build it with "make microbench" from the top-level LUXSim directory, which
+* also runs it. It has to be run from the top-level directory, because the
+* field maps and fast simulation library are loaded with relative paths.
+*
+********************************************************************************
+* Change log
+*	19-Oct-26 - Initial submission
+*	19-Oct-26 - Added the batched field map lookup
+*	19-Oct-26 - Added the Miller drift speed, and the accuracy of the field
+*				tables
+*	19-Oct-26 - Added PoisFluct, and chi-square tests of the binomial and
+*				Poisson samplers against the exact distributions
+*	19-Oct-26 - Added chi-square tests of the tabulated spectra and alias
+*				tables against the samplers they replaced
+*	19-Oct-26 - Added a comparison of the optical fast path with step by step
+*				tracking
+*	19-Oct-26 - The AmBe, CfFission gamma and MASN tables are tested as their
+*				generators build them
+*	19-Oct-26 - The checks now count failures, and main() returns non-zero if
+*				there are any
+*	19-Oct-26 - The optical fast path is also compared in a volume with a
+*				daughter and a reflecting wall
+*	19-Oct-26 - The field tables are checked against the fits at random
+*				fields and temperatures, through GetLiquidElectronDriftSpeed
+*
+*/
+////////////////////////////////////////////////////////////////////////////////
+
+//
+//	C/C++ includes
+//
+#include <stdio.h>
+#include <math.h>
+#include <sys/time.h>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+//
+//	GEANT4 includes
+//
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "G4Box.hh"
+#include "G4Tubs.hh"
+#include "G4LogicalVolume.hh"
+#include "G4PVPlacement.hh"
+#include "G4Material.hh"
+#include "G4NistManager.hh"
+#include "G4Region.hh"
+#include "Randomize.hh"
+
+//
+//	LUXSim includes
+//
+#include "LUXSimManager.hh"
+#include "LUXSimBST.hh"
+#include "LUXSimIsotope.hh"
+#include "LUXSimOutput.hh"
+#include "LUXSimDetectorComponent.hh"
+#include "LUXSimFastSim.hh"
+#include "LUXSimFunctionTable.hh"
+#include "LUXSimTabulatedDistribution.hh"
+#include "LUXSimOpticalFastModel.hh"
+#include "G4S1Light.hh"
+
+//
+//	Definitions
+//
+#define MIN_BENCH_TIME 0.5	//	seconds per kernel
+#define CALL_BLOCK 1000		//	calls between clock checks
+#define NUM_POSITIONS 4096
+#define BST_EVENTS 100000
+#define OUTPUT_STEPS 100
+#define FLUCT_SAMPLES 1000000
+#define TABLE_SAMPLES 1000000
+#define OPTICAL_PHOTONS 1000000
+#define OPTICAL_ABSORPTION_RATE (1./(1.*m))
+#define OPTICAL_RAYLEIGH_RATE (1./(30.*cm))
+#define TABLE_TOLERANCE 1e-5	//	as in G4S1Light.cc
+#define FIELD_SAMPLES 1000000
+
+//
+//	These are defined in G4S1Light.cc
+//
+extern FastSim fastSim;
+extern LUXSimFunctionTable millerDriftSpeedTable, liquidDriftSpeedTables[3];
+extern LUXSimFunctionTable recombinationLengthTable, dokeBirksTable;
+G4int BinomFluct( G4int, G4double );
+G4int PoisFluct( G4double );
+G4double MillerDriftSpeedFit( G4double );
+G4double LiquidDriftSpeedFit165K( G4double );
+G4double LiquidDriftSpeedFit200K( G4double );
+G4double LiquidDriftSpeedFit230K( G4double );
+G4double RecombinationLengthFit( G4double );
+G4double DokeBirksFit( G4double );
+
+//
+//	Results are accumulated here so that the compiler can't discard the calls
+//
+static G4double benchSink = 0;
+
+//
+//	The number of checks that failed
+//
+static G4int numFailures = 0;
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					Seconds()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static G4double Seconds()
+{
+	struct timeval tv;
+	gettimeofday( &tv, NULL );
+	return tv.tv_sec + 1.e-6*tv.tv_usec;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					PrintResult()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static void PrintResult( G4String kernel, long calls, G4double seconds )
+{
+	printf( "  %-48s %12ld %12.1f\n", kernel.c_str(), calls,
+			1.e9*seconds/calls );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					CheckChiSquare()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static void CheckChiSquare( const char *label, G4double chiSquare, G4int ndf )
+{
+	//	The chi-square has a mean of ndf and a standard deviation of
+	//	sqrt(2*ndf), so a correct sampler is very unlikely to pass five
+	//	standard deviations above the mean
+	G4bool failed = ( chiSquare > ndf + 5.*sqrt( 2.*ndf ) );
+	if( failed )
+		numFailures++;
+	printf( "  %-32s chi-square %8.1f for %4d degrees of freedom%s\n", label,
+			chiSquare, ndf, failed ? "  FAILED" : "" );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					RandomPositions()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static std::vector<G4ThreeVector> RandomPositions()
+{
+	//	Uniform in the area of the R-Z field maps, which cover 0-250 mm in
+	//	radius and 0-597 mm in height with 1 mm spacing
+	std::vector<G4ThreeVector> positions;
+	for( G4int i=0; i<NUM_POSITIONS; i++ ) {
+		G4double r = 249.*mm*sqrt( G4UniformRand() );
+		G4double phi = twopi*G4UniformRand();
+		G4double z = 596.*mm*G4UniformRand();
+		positions.push_back( G4ThreeVector( r*cos(phi), r*sin(phi), z ) );
+	}
+	return positions;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					BenchBST()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static void BenchBST()
+{
+	//	Same depth and time ordering as LUXSimManager::BuildEventList,
+	//	filled with Kr-83m decays at random times in a one-second window
+	std::vector<G4double> times;
+	for( G4int i=0; i<BST_EVENTS; i++ )
+		times.push_back( 1.e9*ns*G4UniformRand() );
+	Isotope *kr83m = new Isotope( "Kr83m", 36, 83, 1.83*hour );
+
+	G4double insertTime = 0, popTime = 0;
+	long inserts = 0, pops = 0;
+	while( insertTime + popTime < MIN_BENCH_TIME ) {
+		LUXSimBST *tree = new LUXSimBST( 20, 0., 1., BST_EVENTS );
+
+		G4double start = Seconds();
+		for( G4int i=0; i<BST_EVENTS; i++ )
+			tree->Insert( kr83m, times[i], G4ThreeVector(0,0,0), 0, 0 );
+		insertTime += Seconds() - start;
+		inserts += BST_EVENTS;
+
+		//	Pop everything in the same way the event list is consumed during a
+		//	run. The empty initialization nodes are popped along the way, and
+		//	their cost is charged to the events.
+		start = Seconds();
+		while( tree->GetNumNonemptyNodes() ) {
+			benchSink += tree->GetEarliest()->timeOfEvent;
+			tree->PopEarliest();
+		}
+		popTime += Seconds() - start;
+		pops += BST_EVENTS;
+
+		delete tree;
+	}
+	delete kr83m;
+
+	PrintResult( "LUXSimBST::Insert", inserts, insertTime );
+	PrintResult( "LUXSimBST::GetEarliest + PopEarliest (per event)", pops,
+			popTime );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					BenchFieldMaps()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static void BenchFieldMaps( LUXSimManager *luxManager,
+		std::vector<G4ThreeVector> &positions )
+{
+	luxManager->LoadXYZDependentEField( luxManager->GetEFieldFile() );
+	luxManager->LoadXYZDependentDriftTime( luxManager->GetDriftTimeFile() );
+	luxManager->LoadXYZDependentRadialDrift(
+			luxManager->GetRadialDriftFile() );
+
+	for( G4int kernel=0; kernel<3; kernel++ ) {
+		long calls = 0;
+		G4double start = Seconds(), elapsed = 0;
+		while( elapsed < MIN_BENCH_TIME ) {
+			for( G4int i=0; i<CALL_BLOCK; i++ ) {
+				G4ThreeVector &pos = positions[ (calls+i) % NUM_POSITIONS ];
+				if( kernel == 0 )
+					benchSink += luxManager->GetXYZDependentElectricField(pos);
+				else if( kernel == 1 )
+					benchSink += luxManager->GetXYZDependentDriftTime( pos );
+				else
+					benchSink += luxManager->GetXYZDependentRadialDrift( pos );
+			}
+			calls += CALL_BLOCK;
+			elapsed = Seconds() - start;
+		}
+
+		if( kernel == 0 )
+			PrintResult( "LUXSimManager::GetXYZDependentElectricField",
+					calls, elapsed );
+		else if( kernel == 1 )
+			PrintResult( "LUXSimManager::GetXYZDependentDriftTime", calls,
+					elapsed );
+		else
+			PrintResult( "LUXSimManager::GetXYZDependentRadialDrift", calls,
+					elapsed );
+	}
+
+	//	All three quantities at once, a block of points per call
+	std::vector<LUXSimManager::fieldMapValues> values( CALL_BLOCK );
+	G4int allQuantities = LUXSimManager::electricFieldQuantity |
+			LUXSimManager::driftTimeQuantity |
+			LUXSimManager::radialDriftQuantity;
+	long points = 0;
+	G4double start = Seconds(), elapsed = 0;
+	while( elapsed < MIN_BENCH_TIME ) {
+		luxManager->GetXYZDependentValues( CALL_BLOCK,
+				&positions[ points % (NUM_POSITIONS - CALL_BLOCK) ],
+				allQuantities, &values[0] );
+		benchSink += values[0].electricField + values[0].driftTime +
+				values[0].radialDrift;
+		points += CALL_BLOCK;
+		elapsed = Seconds() - start;
+	}
+	PrintResult( "LUXSimManager::GetXYZDependentValues (all three, per point)",
+			points, elapsed );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					TestFluctuations()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static void TestFluctuations( G4int n, G4double p, G4double mean )
+{
+	//	Binomial if n is positive, otherwise Poisson. The samples are
+	//	histogrammed and compared with the exact distribution, with the bins
+	//	merged until each expects at least 20 entries. The chi-square per
+	//	degree of freedom should be close to one.
+	G4int maxK = ( n > 0 ? n : (G4int)( mean + 20.*sqrt( mean ) + 30. ) );
+	std::vector<long> counts( maxK+1, 0 );
+	for( G4int i=0; i<FLUCT_SAMPLES; i++ ) {
+		G4int k = ( n > 0 ? BinomFluct( n, p ) : PoisFluct( mean ) );
+		counts[ k < maxK ? k : maxK ]++;
+	}
+
+	std::vector<G4double> expected, observed;
+	G4double binExpected = 0, binObserved = 0;
+	for( G4int k=0; k<=maxK; k++ ) {
+		G4double logProb = ( n > 0 ?
+				lgamma( n+1. ) - lgamma( k+1. ) - lgamma( n-k+1. ) +
+				k*log( p ) + ( n-k )*log( 1.-p ) :
+				-mean + k*log( mean ) - lgamma( k+1. ) );
+		binExpected += FLUCT_SAMPLES*exp( logProb );
+		binObserved += counts[k];
+		if( binExpected >= 20 ) {
+			expected.push_back( binExpected );
+			observed.push_back( binObserved );
+			binExpected = binObserved = 0;
+		}
+	}
+	expected.back() += binExpected;
+	observed.back() += binObserved;
+
+	G4double chiSquare = 0;
+	for( size_t i=0; i<expected.size(); i++ )
+		chiSquare += ( observed[i] - expected[i] )*( observed[i] - expected[i] ) /
+				expected[i];
+
+	char label[64];
+	if( n > 0 )
+		sprintf( label, "BinomFluct( %d, %g )", n, p );
+	else
+		sprintf( label, "PoisFluct( %g )", mean );
+	CheckChiSquare( label, chiSquare, (G4int)expected.size() - 1 );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					RandomField()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static G4double RandomField()
+{
+	//	Uniform in log(field) from 0.1 V/cm to 2e5 V/cm, which takes in the
+	//	formulas below the tables, the whole of each table, and the fits
+	//	above it
+	return( 0.1*pow( 2.e6, G4UniformRand() ) );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					ReferenceDriftSpeed()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static G4double ReferenceDriftSpeed( G4double temperature, G4double field,
+		G4bool miller, G4double &tabulatedPart )
+{
+	//	The liquid xenon drift speed in cm/s, as GetLiquidElectronDriftSpeed
+	//	worked it out from the fits before they were tabulated. The part of
+	//	the speed that now comes from the tables is returned as well, since
+	//	the tables are only accurate relative to that.
+	if( miller ) {
+		G4double speed;
+		if( field <= 40. )
+			speed = -0.13274 + 0.041082*field - 0.0006886*pow( field, 2. ) +
+					5.5503e-6*pow( field, 3. );
+		else if( field < 1e5 )
+			speed = MillerDriftSpeedFit( field );
+		else
+			speed = 2.7;
+		tabulatedPart = 1.e5*fabs( speed );
+		if( field >= 500 )
+			speed -= 0.017*( temperature - 163 );
+		else if( field < 100 )
+			speed += 0.017*( temperature - 163 );
+		return( 1.e5*speed );
+	}
+
+	G4double f[3];
+	if( field < 20 ) {
+		f[0] = 2951*field;
+		f[1] = 5312*field;
+		f[2] = 7101*field;
+	} else {
+		f[0] = LiquidDriftSpeedFit165K( field );
+		f[1] = LiquidDriftSpeedFit200K( field );
+		f[2] = LiquidDriftSpeedFit230K( field );
+	}
+	G4int low = ( temperature < 200. ? 0 : 1 );
+	G4double t1 = ( low ? 200. : 165. ), t2 = ( low ? 230. : 200. );
+	G4double weight = ( temperature - t1 )/( t2 - t1 );
+	tabulatedPart = ( 1. - weight )*fabs( f[low] ) + weight*fabs( f[low+1] );
+	return( ( 1. - weight )*f[low] + weight*f[low+1] );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					TestFieldTables()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static void TestFieldTables( G4S1Light *s1Light )
+{
+	//	The tabulated drift speed, recombination length and Doke-Birks term
+	//	against the fits at random fields, and for the drift speed at random
+	//	temperatures too, so that the interpolation between the three
+	//	temperature fits and the Miller temperature correction are included.
+	//	The worst relative error should be within the tolerance the tables
+	//	were built with.
+	for( G4int miller=0; miller<2; miller++ ) {
+		G4double worstError = 0;
+		for( G4int i=0; i<FIELD_SAMPLES; i++ ) {
+			G4double field = RandomField();
+			G4double temperature = ( miller ? 160. + 40.*G4UniformRand() :
+					165. + 65.*G4UniformRand() );
+			G4double tabulatedPart;
+			G4double reference = ReferenceDriftSpeed( temperature, field,
+					miller, tabulatedPart );
+			if( reference <= 0 || tabulatedPart <= 0 )
+				continue;
+			G4double energy = s1Light->GetLiquidElectronDriftSpeed(
+					temperature, field, miller, 54, false, 0., 0. );
+			G4double speed = sqrt( 2.*energy/EMASS )/( cm/s );
+			G4double error = fabs( speed - reference )/tabulatedPart;
+			if( error > worstError )
+				worstError = error;
+		}
+		G4bool failed = ( worstError > TABLE_TOLERANCE );
+		if( failed )
+			numFailures++;
+		printf( "  %-32s worst relative error %.2g%s\n", miller ?
+				"Miller drift speed vs fit" : "Drift speed vs fits",
+				worstError, failed ? "  FAILED" : "" );
+	}
+
+	const char *tableNames[2] = { "Recombination length vs fit",
+			"Doke-Birks A vs fit" };
+	const LUXSimFunctionTable *tables[2] = { &recombinationLengthTable,
+			&dokeBirksTable };
+	for( G4int table=0; table<2; table++ ) {
+		G4double worstError = 0;
+		for( G4int i=0; i<FIELD_SAMPLES; i++ ) {
+			G4double field = RandomField();
+			G4double reference = ( table ?
+					19.171*pow( field + 25.552, -0.83057 ) + 0.026772 :
+					69.492*pow( field, -0.50422 ) );
+			G4double error = fabs( tables[table]->Value( field ) - reference ) /
+					reference;
+			if( error > worstError )
+				worstError = error;
+		}
+		G4bool failed = ( worstError > TABLE_TOLERANCE );
+		if( failed )
+			numFailures++;
+		printf( "  %-32s worst relative error %.2g%s\n", tableNames[table],
+				worstError, failed ? "  FAILED" : "" );
+	}
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					BenchNEST()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static void BenchNEST()
+{
+	//	BinomFluct at a typical S1 photon detection probability, for a small
+	//	and a large number of quanta
+	G4int quanta[2] = { 50, 50000 };
+	for( G4int n=0; n<2; n++ ) {
+		long calls = 0;
+		G4double start = Seconds(), elapsed = 0;
+		while( elapsed < MIN_BENCH_TIME ) {
+			for( G4int i=0; i<CALL_BLOCK; i++ )
+				benchSink += BinomFluct( quanta[n], 0.14 );
+			calls += CALL_BLOCK;
+			elapsed = Seconds() - start;
+		}
+		char label[64];
+		sprintf( label, "G4S1Light BinomFluct (N = %d)", quanta[n] );
+		PrintResult( label, calls, elapsed );
+	}
+
+	//	PoisFluct, below and above the switch from inversion to rejection
+	G4double means[2] = { 5., 5000. };
+	for( G4int n=0; n<2; n++ ) {
+		long calls = 0;
+		G4double start = Seconds(), elapsed = 0;
+		while( elapsed < MIN_BENCH_TIME ) {
+			for( G4int i=0; i<CALL_BLOCK; i++ )
+				benchSink += PoisFluct( means[n] );
+			calls += CALL_BLOCK;
+			elapsed = Seconds() - start;
+		}
+		char label[64];
+		sprintf( label, "G4S1Light PoisFluct (mean = %g)", means[n] );
+		PrintResult( label, calls, elapsed );
+	}
+
+	//	Both samplers against the exact distributions, on either side of each
+	//	change of method and in the tails that a Gaussian gets wrong
+	TestFluctuations( 5, 0.3, 0 );
+	TestFluctuations( 40, 0.05, 0 );
+	TestFluctuations( 1000, 0.002, 0 );
+	TestFluctuations( 200, 0.9, 0 );
+	TestFluctuations( 50000, 0.14, 0 );
+	TestFluctuations( 0, 0, 0.5 );
+	TestFluctuations( 0, 0, 9.9 );
+	TestFluctuations( 0, 0, 16. );
+	TestFluctuations( 0, 0, 5000. );
+
+	//	Drift speed from the parameterization, over a range of fields, with
+	//	the three temperature fits and with the Miller fit
+	G4S1Light *s1Light = new G4S1Light( "S1" );
+	G4double fields[8] = { 50., 100., 180., 300., 500., 1000., 2000., 4000. };
+	for( G4int miller=0; miller<2; miller++ ) {
+		long calls = 0;
+		G4double start = Seconds(), elapsed = 0;
+		while( elapsed < MIN_BENCH_TIME ) {
+			for( G4int i=0; i<CALL_BLOCK; i++ )
+				benchSink += s1Light->GetLiquidElectronDriftSpeed( 173.,
+						fields[i%8], miller, 54, false, 0., 0. );
+			calls += CALL_BLOCK;
+			elapsed = Seconds() - start;
+		}
+		PrintResult( miller ? "G4S1Light::GetLiquidElectronDriftSpeed (Miller)" :
+				"G4S1Light::GetLiquidElectronDriftSpeed", calls, elapsed );
+	}
+
+	//	The size of each field table, and its accuracy against the fits
+	const char *tableNames[6] = { "Miller drift speed", "165 K drift speed",
+			"200 K drift speed", "230 K drift speed", "recombination length",
+			"Doke-Birks A" };
+	const LUXSimFunctionTable *tables[6] = { &millerDriftSpeedTable,
+			&liquidDriftSpeedTables[0], &liquidDriftSpeedTables[1],
+			&liquidDriftSpeedTables[2], &recombinationLengthTable,
+			&dokeBirksTable };
+	for( G4int i=0; i<6; i++ )
+		printf( "  %-24s table: %6d points\n", tableNames[i],
+				tables[i]->GetNumPoints() );
+	TestFieldTables( s1Light );
+	delete s1Light;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					HistogramBin()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static G4int HistogramBin( G4double x, G4double width, G4int numBins )
+{
+	G4int bin = (G4int)( x/width );
+	if( bin < 0 ) bin = 0;
+	if( bin >= numBins ) bin = numBins - 1;
+	return bin;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					CompareSamples()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static void CompareSamples( const char *label, const std::vector<long> &oldCounts,
+		const std::vector<long> &newCounts )
+{
+	//	Two histograms of the same number of samples. Neighbouring bins are
+	//	merged until each merged bin holds at least 40 entries between the
+	//	two, and the chi-square per degree of freedom should be close to one.
+	G4double chiSquare = 0, binOld = 0, binNew = 0;
+	G4int numBins = 0;
+	for( size_t i=0; i<oldCounts.size(); i++ ) {
+		binOld += oldCounts[i];
+		binNew += newCounts[i];
+		if( binOld + binNew >= 40 || i == oldCounts.size()-1 ) {
+			if( binOld + binNew > 0 ) {
+				chiSquare += ( binOld - binNew )*( binOld - binNew ) /
+						( binOld + binNew );
+				numBins++;
+			}
+			binOld = binNew = 0;
+		}
+	}
+
+	CheckChiSquare( label, chiSquare, numBins - 1 );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					WattRejection()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static G4double WattRejection()
+{
+	//	The Cf-252 neutron energy as LUXSimGeneratorCfFission used to draw it
+	G4double energy = G4UniformRand() * 15 + 1e-9;
+	G4double height = G4UniformRand() * 0.48;
+
+	while( height > (exp(-energy/1.209) * sinh( sqrt(0.836*energy))) ) {
+		energy = G4UniformRand() * 15;
+		height = G4UniformRand() * 0.48;
+	}
+
+	return( energy );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					TritiumSpectrum()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static G4double TritiumSpectrum( G4double energy )
+{
+	//	LUXSimGeneratorTritium::GetBetaSpectrum(), with the same constants
+	G4double Q = 18.5898, m_e = 511., a = 1./137, Z = 2.;
+	if( energy < 1.e-9 )
+		energy = 1.e-9;
+	if( energy >= Q )
+		return 0.;
+
+	G4double B = sqrt(energy*energy + 2*energy*m_e) / (energy + m_e);
+	G4double x = (2*pi*Z*a)*(energy + m_e)/sqrt(energy*energy + 2*energy*m_e);
+
+	return( sqrt(2*energy*m_e) * (energy + m_e) * (Q-energy) * (Q-energy) *
+			x*(1./(1-exp(-x)))*(1.002037-0.001427*(B)) );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					TritiumRejection()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static G4double TritiumRejection()
+{
+	//	The tritium beta energy as LUXSimGeneratorTritium used to draw it
+	G4double xTry = 18.5898*G4UniformRand();
+	G4double yTry = 1.1e7*G4UniformRand();
+	while( yTry > TritiumSpectrum( xTry ) ) {
+		xTry = 18.5898*G4UniformRand();
+		yTry = 1.1e7*G4UniformRand();
+	}
+	return( xTry );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					BisectCDF()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static G4double BisectCDF( const std::vector<G4double> &x,
+		const std::vector<G4double> &cdf, G4double prob )
+{
+	//	The inverse CDF as the AmBe, CfFission and MASN generators used to
+	//	find it
+	G4int indexLo = 0, indexHi = (G4int)x.size() - 1;
+
+	while( !(cdf[indexLo+1] > prob && cdf[indexHi-1] < prob) ) {
+		if( cdf[(indexLo+indexHi)/2] < prob )
+			indexLo = (indexLo + indexHi)/2;
+		else
+			indexHi = (indexLo + indexHi)/2;
+	}
+
+	G4double split = (prob - cdf[indexLo]) / (cdf[indexHi] - cdf[indexLo]);
+	return( x[indexLo] + split*(x[indexHi] - x[indexLo]) );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					ReadSourceTable()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static G4bool ReadSourceTable( G4String fileName, G4String arrayName,
+		std::vector<G4double> &values )
+{
+	//	Reads the initializer of "G4double arrayName[] = { ... };" out of a
+	//	generator's code file, so that the tests use the same numbers as the
+	//	generator without a second copy of them here
+	std::ifstream sourceFile( fileName.c_str() );
+	G4String start = arrayName + "[] = {";
+	std::string line;
+	G4bool found = false;
+	values.clear();
+	while( std::getline( sourceFile, line ) ) {
+		if( !found ) {
+			size_t position = line.find( start );
+			if( position == std::string::npos )
+				continue;
+			found = true;
+			line = line.substr( position + start.length() );
+		}
+		size_t end = line.find( "};" );
+		if( end != std::string::npos )
+			line = line.substr( 0, end );
+		for( size_t i=0; i<line.length(); i++ )
+			if( line[i] == ',' )
+				line[i] = ' ';
+		std::istringstream numbers( line );
+		G4double value;
+		while( numbers >> value )
+			values.push_back( value );
+		if( end != std::string::npos )
+			break;
+	}
+	sourceFile.close();
+
+	return( found && values.size() > 1 );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					TestCDFTable()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static void TestCDFTable( const char *label, const std::vector<G4double> &x,
+		const std::vector<G4double> &cdf, G4double xLimit, G4int numBins )
+{
+	//	A CDF table as a generator hands it to SetCDF, sampled with the
+	//	binary search the generator used to do and with the tabulated
+	//	distribution. The old search never returned for a random number
+	//	above the last entry of a CDF that stops short of one, so those are
+	//	redrawn. Values above xLimit are redrawn as well, which is how the
+	//	CfFission gammas used to be truncated.
+	LUXSimTabulatedDistribution distribution;
+	distribution.SetCDF( (G4int)x.size(), &x[0], &cdf[0] );
+
+	G4double xMax = ( xLimit < x.back() ? xLimit : x.back() );
+	G4double width = ( xMax - x.front() )/numBins;
+	std::vector<long> oldCounts( numBins, 0 ), newCounts( numBins, 0 );
+	for( G4int i=0; i<TABLE_SAMPLES; i++ ) {
+		G4double value = xLimit + 1.;
+		while( value > xLimit ) {
+			G4double prob = G4UniformRand();
+			if( prob < cdf.back() )
+				value = BisectCDF( x, cdf, prob );
+		}
+		oldCounts[ HistogramBin( value - x.front(), width, numBins ) ]++;
+
+		value = ( xLimit < x.back() ? distribution.Sample( xLimit ) :
+				distribution.Sample() );
+		newCounts[ HistogramBin( value - x.front(), width, numBins ) ]++;
+	}
+	CompareSamples( label, oldCounts, newCounts );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					NormalizedCDF()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static std::vector<G4double> NormalizedCDF( const std::vector<G4double> &pdf )
+{
+	//	The running sum that the CfFission and MASN generators turn their
+	//	PDFs into. It stops one point short of one, and the generators
+	//	force the last point to one in some cases but not others.
+	G4double area = 0;
+	for( size_t i=0; i<pdf.size(); i++ )
+		area += pdf[i];
+	std::vector<G4double> cdf( pdf.size(), 0. );
+	for( size_t i=1; i<pdf.size(); i++ )
+		cdf[i] = cdf[i-1] + pdf[i-1]/area;
+	return cdf;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					TestTabulatedDistributions()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static void TestTabulatedDistributions()
+{
+	//	Each spectrum that was converted to a LUXSimTabulatedDistribution is
+	//	built the way its generator builds it, and TABLE_SAMPLES values from
+	//	the table are histogrammed against the same number from the sampler
+	//	it replaced.
+	std::vector<long> oldCounts, newCounts;
+
+	//	CfFission neutrons: the Watt spectrum in 1 keV steps, against the
+	//	rejection sampler, in 0.1 MeV bins
+	G4int numWattPoints = 15001;
+	std::vector<G4double> wattEnergy( numWattPoints ), wattPDF( numWattPoints );
+	for( G4int i=0; i<numWattPoints; i++ ) {
+		wattEnergy[i] = 15.*i/(numWattPoints-1);
+		wattPDF[i] = exp(-wattEnergy[i]/1.209) * sinh( sqrt(0.836*wattEnergy[i]) );
+	}
+	LUXSimTabulatedDistribution wattSpectrum;
+	wattSpectrum.SetPDF( numWattPoints, &wattEnergy[0], &wattPDF[0] );
+
+	oldCounts.assign( 150, 0 );
+	newCounts.assign( 150, 0 );
+	for( G4int i=0; i<TABLE_SAMPLES; i++ ) {
+		oldCounts[ HistogramBin( WattRejection(), 0.1, 150 ) ]++;
+		newCounts[ HistogramBin( wattSpectrum.Sample(), 0.1, 150 ) ]++;
+	}
+	CompareSamples( "Watt spectrum", oldCounts, newCounts );
+
+	//	The guide table against the binary search, for the same random
+	//	numbers. These should agree to rounding.
+	std::vector<G4double> wattCDF( numWattPoints );
+	for( G4int i=0; i<numWattPoints; i++ )
+		wattCDF[i] = wattSpectrum.GetCDF( wattEnergy[i] );
+	G4double worstDifference = 0;
+	for( G4int i=0; i<TABLE_SAMPLES; i++ ) {
+		G4double prob = G4UniformRand();
+		G4double difference = fabs( BisectCDF( wattEnergy, wattCDF, prob ) -
+				wattSpectrum.GetInverseCDF( prob ) );
+		if( difference > worstDifference )
+			worstDifference = difference;
+	}
+	G4bool failed = ( worstDifference > 1.e-9 );
+	if( failed )
+		numFailures++;
+	printf( "  %-32s worst difference %.2g MeV%s\n",
+			"Binary search vs guide table", worstDifference,
+			failed ? "  FAILED" : "" );
+
+	//	AmBe: the neutron energy and gamma angle CDFs, read from the
+	//	generator
+	std::vector<G4double> tableX, tableCDF, tablePDF;
+	G4String ambeFile = "generator/src/LUXSimGeneratorAmBe.cc";
+	if( ReadSourceTable( ambeFile, "neutronEnergyTemp", tableX ) &&
+			ReadSourceTable( ambeFile, "neutronCDFTemp", tableCDF ) &&
+			tableX.size() == tableCDF.size() )
+		TestCDFTable( "AmBe neutron energy", tableX, tableCDF, 1.e9, 110 );
+	else
+		G4cout << "  AmBe neutron table not found, skipping it" << G4endl;
+
+	if( ReadSourceTable( ambeFile, "gammaCDFTemp", tableCDF ) ) {
+		tableX.resize( tableCDF.size() );
+		for( size_t i=0; i<tableX.size(); i++ )
+			tableX[i] = 3.14159265358979312*i/( tableX.size() - 1 );
+		TestCDFTable( "AmBe gamma angle", tableX, tableCDF, 1.e9, 100 );
+	} else
+		G4cout << "  AmBe gamma table not found, skipping it" << G4endl;
+
+	//	CfFission gammas: the digitized spectrum, read from the generator,
+	//	whole and truncated at 1 MeV as it is for the last gammas of a
+	//	fission
+	std::vector<G4double> gammaInfo;
+	if( ReadSourceTable( "generator/src/LUXSimGeneratorCfFission.cc",
+			"gammaInfo", gammaInfo ) ) {
+		tableX.resize( gammaInfo.size()/2 );
+		tablePDF.resize( gammaInfo.size()/2 );
+		for( size_t i=0; i<tableX.size(); i++ ) {
+			tableX[i] = gammaInfo[i*2];
+			tablePDF[i] = gammaInfo[i*2 + 1];
+		}
+		tableCDF = NormalizedCDF( tablePDF );
+		tableCDF.back() = 1.;
+		TestCDFTable( "CfFission gamma energy", tableX, tableCDF, 1.e9, 100 );
+		TestCDFTable( "CfFission gammas below 1 MeV", tableX, tableCDF,
+				1., 50 );
+	} else
+		G4cout << "  CfFission gamma table not found, skipping it" << G4endl;
+
+	//	MASN: the neutron energy and angle tables depend on a muon energy the
+	//	generator draws when it's built, so they're built here for a typical
+	//	300 GeV muon. The neutron energy CDF isn't forced to one.
+	G4double muonEnergy = 300.;
+	G4double B = 0.324 - 0.641*exp(-0.014*muonEnergy);
+	tableX.resize( 1001 );
+	tablePDF.resize( 1001 );
+	for( G4int i=0; i<1001; i++ ) {
+		tableX[i] = (i+2.5)/250;
+		tablePDF[i] = exp(-7.333*tableX[i])/tableX[i] +
+				B*exp(-2.105*tableX[i]) - 5.35e-15*pow(tableX[i],-2.893);
+	}
+	tableCDF = NormalizedCDF( tablePDF );
+	TestCDFTable( "MASN neutron energy", tableX, tableCDF, 1.e9, 100 );
+
+	G4double B_theta = 0.482*pow(muonEnergy,0.045);
+	G4double C_theta = 0.832*pow(muonEnergy,-0.152);
+	for( G4int i=0; i<1001; i++ ) {
+		tableX[i] = pi*i/1000.;
+		tablePDF[i] = 1./(pow(1.-cos(tableX[i]),B_theta)+C_theta);
+	}
+	tableCDF = NormalizedCDF( tablePDF );
+	tableCDF.back() = 1.;
+	TestCDFTable( "MASN neutron angle", tableX, tableCDF, 1.e9, 100 );
+
+	//	Tritium: the beta spectrum in 1 eV steps, against the rejection
+	//	sampler, in 0.1 keV bins
+	G4int numTritiumPoints = (G4int)(18.5898*1000) + 2;
+	std::vector<G4double> tritiumEnergy( numTritiumPoints ),
+			tritiumPDF( numTritiumPoints );
+	for( G4int i=0; i<numTritiumPoints; i++ ) {
+		tritiumEnergy[i] = 18.5898*i/(numTritiumPoints-1);
+		tritiumPDF[i] = TritiumSpectrum( tritiumEnergy[i] );
+	}
+	LUXSimTabulatedDistribution tritiumSpectrum;
+	tritiumSpectrum.SetPDF( numTritiumPoints, &tritiumEnergy[0],
+			&tritiumPDF[0] );
+
+	oldCounts.assign( 186, 0 );
+	newCounts.assign( 186, 0 );
+	for( G4int i=0; i<TABLE_SAMPLES; i++ ) {
+		oldCounts[ HistogramBin( TritiumRejection(), 0.1, 186 ) ]++;
+		newCounts[ HistogramBin( tritiumSpectrum.Sample(), 0.1, 186 ) ]++;
+	}
+	CompareSamples( "Tritium beta spectrum", oldCounts, newCounts );
+
+	//	LZbkgNeutrons: the alias tables of the energy spectrum and position
+	//	map against the old accept-a-random-bin loops, bin by bin
+	std::ifstream energyFile( "generator/src/LZbkgNeutronEnergies_all_new.dat" );
+	std::vector<G4double> energyWeights;
+	G4double energy, weight;
+	while( energyFile >> energy >> weight )
+		energyWeights.push_back( weight < 1. ? weight : 1. );
+	energyFile.close();
+
+	std::ifstream positionFile( "generator/src/LZbkgNeutrons_all_new.dat" );
+	std::vector<G4double> positionWeights;
+	G4double r2, z, firstR2 = 0;
+	G4int numZbins = 0;
+	while( positionFile >> r2 >> z >> weight ) {
+		if( positionWeights.empty() )
+			firstR2 = r2;
+		if( r2 == firstR2 )
+			numZbins++;
+		positionWeights.push_back( weight < 1. ? weight : 1. );
+	}
+	positionFile.close();
+
+	if( energyWeights.empty() || !numZbins ) {
+		G4cout << "  LZbkg maps not found, skipping the alias table tests"
+			   << G4endl;
+		return;
+	}
+
+	G4int numEnergies = (G4int)energyWeights.size();
+	LUXSimTabulatedDistribution energyDistribution;
+	energyDistribution.SetWeights( numEnergies, &energyWeights[0] );
+
+	oldCounts.assign( numEnergies, 0 );
+	newCounts.assign( numEnergies, 0 );
+	for( G4int i=0; i<TABLE_SAMPLES; i++ ) {
+		G4int bin = (G4int)floor( numEnergies*G4UniformRand() );
+		while( G4UniformRand() >= energyWeights[bin] )
+			bin = (G4int)floor( numEnergies*G4UniformRand() );
+		oldCounts[bin]++;
+		newCounts[ energyDistribution.SampleIndex() ]++;
+	}
+	CompareSamples( "LZbkg neutron energies", oldCounts, newCounts );
+
+	G4int numR2bins = (G4int)positionWeights.size() / numZbins;
+	LUXSimTabulatedDistribution positionDistribution;
+	positionDistribution.SetWeights( numR2bins, numZbins, &positionWeights[0] );
+
+	oldCounts.assign( numR2bins*numZbins, 0 );
+	newCounts.assign( numR2bins*numZbins, 0 );
+	for( G4int i=0; i<TABLE_SAMPLES; i++ ) {
+		G4int r2bin, zbin;
+		do {
+			r2bin = (G4int)floor( numR2bins*G4UniformRand() );
+			zbin = (G4int)floor( numZbins*G4UniformRand() );
+		} while( G4UniformRand() >= positionWeights[r2bin*numZbins + zbin] );
+		oldCounts[r2bin*numZbins + zbin]++;
+		positionDistribution.SampleIndex( r2bin, zbin );
+		newCounts[r2bin*numZbins + zbin]++;
+	}
+	CompareSamples( "LZbkg neutron positions", oldCounts, newCounts );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					ReferenceRayleighScatter()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static void ReferenceRayleighScatter( G4ThreeVector &direction,
+		G4ThreeVector &polarization )
+{
+	//	The sampling in G4OpRayleigh::PostStepDoIt
+	G4ThreeVector newDirection, newPolarization;
+	G4double cosTheta;
+
+	do {
+		G4double CosTheta = G4UniformRand();
+		G4double SinTheta = sqrt( 1. - CosTheta*CosTheta );
+		if( G4UniformRand() < 0.5 ) CosTheta = -CosTheta;
+
+		G4double phi = twopi*G4UniformRand();
+		newDirection.set( SinTheta*cos( phi ), SinTheta*sin( phi ), CosTheta );
+		newDirection.rotateUz( direction );
+		newDirection = newDirection.unit();
+
+		G4double constant = -1. / newDirection.dot( polarization );
+		newPolarization = ( newDirection + constant*polarization ).unit();
+
+		if( newPolarization.mag() == 0. ) {
+			phi = twopi*G4UniformRand();
+			newPolarization.set( cos( phi ), sin( phi ), 0. );
+			newPolarization.rotateUz( newDirection );
+		} else if( G4UniformRand() < 0.5 )
+			newPolarization = -newPolarization;
+
+		cosTheta = newPolarization.dot( polarization );
+	} while( cosTheta*cosTheta < G4UniformRand() );
+
+	direction = newDirection;
+	polarization = newPolarization;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					TrackOpticalPhoton()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static G4int TrackOpticalPhoton( G4LogicalVolume *volume,
+		G4double wallReflectivity, LUXSimOpticalFastModel *fastModel,
+		G4double &pathLength )
+{
+	//	One photon from a random point in the volume, until it's absorbed (0)
+	//	or stops at a surface directly (1) or after scattering (2). The steps
+	//	are taken the way the Geant4 stepping manager takes them, with an
+	//	interaction length left for each process. If there's a fast model,
+	//	it takes the photon whenever ModelTrigger would, and the lengths left
+	//	are drawn again afterwards, as they are when a fast step suspends the
+	//	track.
+	//
+	//	The top and bottom of the cylinder, and the daughter volume if there
+	//	is one, stop the photon. The side wall reflects it specularly with
+	//	the given probability, which stands in for G4OpBoundaryProcess on a
+	//	polished surface, and otherwise stops it.
+	G4Tubs *cylinder = (G4Tubs*)volume->GetSolid();
+	G4double radius = cylinder->GetOuterRadius();
+	G4double halfHeight = cylinder->GetZHalfLength();
+
+	G4VSolid *daughter = NULL;
+	G4ThreeVector daughterPosition;
+	if( volume->GetNoDaughters() ) {
+		daughter = volume->GetDaughter(0)->GetLogicalVolume()->GetSolid();
+		daughterPosition = volume->GetDaughter(0)->GetTranslation();
+	}
+
+	G4ThreeVector position;
+	do {
+		G4double r = radius*sqrt( G4UniformRand() );
+		G4double phi = twopi*G4UniformRand();
+		position.set( r*cos(phi), r*sin(phi),
+				halfHeight*( 2.*G4UniformRand() - 1. ) );
+	} while( daughter &&
+			daughter->Inside( position - daughterPosition ) != kOutside );
+	G4double phi = twopi*G4UniformRand();
+	G4double cosTheta = 2.*G4UniformRand() - 1.;
+	G4ThreeVector direction( sqrt( 1. - cosTheta*cosTheta )*cos(phi),
+			sqrt( 1. - cosTheta*cosTheta )*sin(phi), cosTheta );
+	G4ThreeVector polarization = direction.orthogonal().unit();
+	polarization.rotate( twopi*G4UniformRand(), direction );
+
+	G4double absorptionLeft = -log( G4UniformRand() );
+	G4double rayleighLeft = -log( G4UniformRand() );
+	G4bool scattered = false;
+	pathLength = 0;
+
+	while( true ) {
+		if( fastModel && fastModel->IsClearOfBoundary( volume, position,
+				direction ) ) {
+			if( fastModel->Transport( volume, OPTICAL_ABSORPTION_RATE,
+					OPTICAL_RAYLEIGH_RATE, position, direction, polarization,
+					pathLength ) )
+				return 0;
+			if( LUXSimOpticalFastModel::GetNumRayleigh() )
+				scattered = true;
+			absorptionLeft = -log( G4UniformRand() );
+			rayleighLeft = -log( G4UniformRand() );
+			continue;
+		}
+
+		G4bool validNormal;
+		G4ThreeVector normal;
+		G4double wallDistance = cylinder->DistanceToOut( position, direction,
+				true, &validNormal, &normal );
+		G4double daughterDistance = ( daughter ? daughter->DistanceToIn(
+				position - daughterPosition, direction ) : kInfinity );
+		G4double absorptionDistance = absorptionLeft/OPTICAL_ABSORPTION_RATE;
+		G4double rayleighDistance = rayleighLeft/OPTICAL_RAYLEIGH_RATE;
+		G4double step = wallDistance;
+		if( daughterDistance < step ) step = daughterDistance;
+		if( absorptionDistance < step ) step = absorptionDistance;
+		if( rayleighDistance < step ) step = rayleighDistance;
+
+		position += step*direction;
+		pathLength += step;
+		absorptionLeft -= step*OPTICAL_ABSORPTION_RATE;
+		rayleighLeft -= step*OPTICAL_RAYLEIGH_RATE;
+
+		if( step == daughterDistance )
+			return( scattered ? 2 : 1 );
+		if( step == wallDistance ) {
+			if( normal.z() == 0 && wallReflectivity > 0 &&
+					G4UniformRand() < wallReflectivity ) {
+				//	The lengths left carry on through a reflection, as they
+				//	do in the stepping manager
+				direction -= 2.*direction.dot( normal )*normal;
+				polarization = -polarization +
+						2.*polarization.dot( normal )*normal;
+				continue;
+			}
+			return( scattered ? 2 : 1 );
+		}
+		if( step == absorptionDistance )
+			return 0;
+
+		ReferenceRayleighScatter( direction, polarization );
+		rayleighLeft = -log( G4UniformRand() );
+		scattered = true;
+	}
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					TestOpticalFastPath()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static void TestOpticalFastPath()
+{
+	//	Photons in a liquid xenon cylinder the size of the LUX active volume,
+	//	tracked step by step and with the optical fast path. What happens to
+	//	each photon, and its path length to where it stopped or was absorbed,
+	//	in 10 mm bins up to 3 m, should agree between the two. This is done
+	//	once in a plain cylinder, and once with a daughter box in it and a
+	//	side wall that reflects, so that the photons are handed back short
+	//	of both kinds of boundary and taken again after a reflection.
+	G4Tubs *cylinder = new G4Tubs( "BenchCylinder", 0, 250.*mm, 275.*mm, 0,
+			twopi );
+	G4Material *liquidXenon =
+			G4NistManager::Instance()->FindOrBuildMaterial( "G4_lXe" );
+	G4LogicalVolume *cylinderLog = new G4LogicalVolume( cylinder, liquidXenon,
+			"BenchCylinder" );
+	G4LogicalVolume *reflectingLog = new G4LogicalVolume( cylinder,
+			liquidXenon, "BenchReflectingCylinder" );
+	G4Box *daughterBox = new G4Box( "BenchDaughterBox", 50.*mm, 50.*mm,
+			25.*mm );
+	G4LogicalVolume *daughterLog = new G4LogicalVolume( daughterBox,
+			liquidXenon, "BenchDaughterBox" );
+	new G4PVPlacement( 0, G4ThreeVector( 100.*mm, 0, -150.*mm ), daughterLog,
+			"BenchDaughterBox", reflectingLog, false, 0 );
+
+	G4Region *fastPathRegion = new G4Region( "BenchOpticalFastPathRegion" );
+	fastPathRegion->AddRootLogicalVolume( cylinderLog );
+	fastPathRegion->AddRootLogicalVolume( reflectingLog );
+	LUXSimOpticalFastModel *fastModel = new LUXSimOpticalFastModel(
+			"BenchOpticalFastPath", fastPathRegion );
+
+	G4LogicalVolume *volumes[2] = { cylinderLog, reflectingLog };
+	G4double reflectivities[2] = { 0., 0.95 };
+	const char *names[2] = { "Optical photon", "Reflected photon" };
+	for( G4int test=0; test<2; test++ ) {
+		std::vector<long> fates[2], pathLengths[2];
+		for( G4int useModel=0; useModel<2; useModel++ ) {
+			fates[useModel].assign( 3, 0 );
+			pathLengths[useModel].assign( 600, 0 );
+			G4double start = Seconds();
+			for( G4int i=0; i<OPTICAL_PHOTONS; i++ ) {
+				G4double pathLength;
+				G4int fate = TrackOpticalPhoton( volumes[test],
+						reflectivities[test], useModel ? fastModel : NULL,
+						pathLength );
+				fates[useModel][fate]++;
+				pathLengths[useModel][ HistogramBin( pathLength, 10.*mm, 300 )
+						+ ( fate ? 300 : 0 ) ]++;
+			}
+			G4String label = G4String( names[test] ) + ( useModel ?
+					" with the fast path" : " tracked step by step" );
+			PrintResult( label, OPTICAL_PHOTONS, Seconds() - start );
+		}
+
+		G4String label = G4String( names[test] ) + " direct fraction";
+		printf( "  %-32s %.4f step by step, %.4f fast\n", label.c_str(),
+				(G4double)fates[0][1]/OPTICAL_PHOTONS,
+				(G4double)fates[1][1]/OPTICAL_PHOTONS );
+		label = G4String( names[test] ) + " fates";
+		CompareSamples( label.c_str(), fates[0], fates[1] );
+		label = G4String( names[test] ) + " path lengths";
+		CompareSamples( label.c_str(), pathLengths[0], pathLengths[1] );
+	}
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					BenchFastSim()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static void BenchFastSim( std::vector<G4ThreeVector> &positions )
+{
+	//	Kr-83m sized signals at positions inside the fast simulation volume
+	//	(inscribed radius 234.85 mm, 1-546 mm high)
+	G4double hits[122];
+	for( G4int kernel=0; kernel<2; kernel++ ) {
+		long calls = 0;
+		G4double start = Seconds(), elapsed = 0;
+		while( elapsed < MIN_BENCH_TIME ) {
+			for( G4int i=0; i<CALL_BLOCK/10; i++ ) {
+				G4ThreeVector &pos = positions[ (calls+i) % NUM_POSITIONS ];
+				G4double origin[3];
+				origin[0] = pos.x()*0.94;
+				origin[1] = pos.y()*0.94;
+				origin[2] = 1. + pos.z()*0.91;
+				if( kernel == 0 )
+					fastSim.photonsToPHE( 2500, origin, hits );
+				else
+					fastSim.electronsToPHE( 1500, origin, hits );
+				benchSink += hits[0];
+			}
+			calls += CALL_BLOCK/10;
+			elapsed = Seconds() - start;
+		}
+
+		if( kernel == 0 )
+			PrintResult( "FastSim::photonsToPHE (2500 photons)", calls,
+					elapsed );
+		else
+			PrintResult( "FastSim::electronsToPHE (1500 electrons)", calls,
+					elapsed );
+	}
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					BenchOutput()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static void BenchOutput( LUXSimManager *luxManager )
+{
+	//	A stand-alone liquid xenon volume with a record level 2 event of
+	//	OUTPUT_STEPS energy depositions and one primary
+	G4Box *benchBox = new G4Box( "BenchBox", 10.*cm, 10.*cm, 10.*cm );
+	G4LogicalVolume *benchLog = new G4LogicalVolume( benchBox,
+			G4NistManager::Instance()->FindOrBuildMaterial( "G4_lXe" ),
+			"BenchBox" );
+	LUXSimDetectorComponent *benchVolume = new LUXSimDetectorComponent( 0,
+			G4ThreeVector(), benchLog, "BenchBox", 0, false, 0 );
+	benchVolume->SetID( 1 );
+	benchVolume->SetRecordLevel( 2 );
+
+	LUXSimManager::primaryParticleInfo primary;
+	primary.id = "e-";
+	primary.energy = 41.5*keV;
+	primary.time = 0;
+	primary.position = G4ThreeVector( 0, 0, 0 );
+	primary.direction = G4ThreeVector( 0, 0, 1 );
+	luxManager->AddPrimaryParticle( primary );
+
+	for( G4int i=0; i<OUTPUT_STEPS; i++ ) {
+		LUXSimManager::stepRecord aStepRecord;
+		aStepRecord.stepNumber = i+1;
+		aStepRecord.particleID = 11;
+		aStepRecord.particleName = "e-";
+		aStepRecord.creatorProcess = "eIoni";
+		aStepRecord.stepProcess = "eIoni";
+		aStepRecord.trackID = 1 + i/10;
+		aStepRecord.parentID = i/10;
+		aStepRecord.particleEnergy = 41.5*keV*(1. - 0.01*i);
+		aStepRecord.particleDirection[0] = 0;
+		aStepRecord.particleDirection[1] = 0;
+		aStepRecord.particleDirection[2] = 1;
+		aStepRecord.energyDeposition = 0.4*keV;
+		aStepRecord.position[0] = 0.01*mm*i;
+		aStepRecord.position[1] = 0;
+		aStepRecord.position[2] = 0;
+		aStepRecord.stepTime = 0.01*ns*i;
+		benchVolume->AddDeposition( aStepRecord );
+	}
+
+	//	The output file goes in /tmp and is removed afterwards
+	luxManager->SetOutputDir( "/tmp" );
+	luxManager->SetOutputName( "LUXSimMicroBench" );
+	G4String fileName = luxManager->GetOutputBaseName() + ".bin";
+	LUXSimOutput *output = new LUXSimOutput();
+
+	long calls = 0;
+	G4double start = Seconds(), elapsed = 0;
+	while( elapsed < MIN_BENCH_TIME ) {
+		for( G4int i=0; i<CALL_BLOCK; i++ )
+			output->RecordEventByVolume( benchVolume, calls+i );
+		calls += CALL_BLOCK;
+		elapsed = Seconds() - start;
+	}
+	benchSink += output->GetBytesWritten();
+
+	char label[64];
+	sprintf( label, "LUXSimOutput::RecordEventByVolume (%d steps)",
+			OUTPUT_STEPS );
+	PrintResult( label, calls, elapsed );
+
+	luxManager->SetRunEndedCleanly( true );
+	delete output;
+	luxManager->Register( (LUXSimOutput*)NULL );
+	remove( fileName.c_str() );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					main()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+int main()
+{
+	LUXSimManager *LUXManager = new LUXSimManager();
+	LUXManager->SetRandomSeed( 1001 );
+
+	std::vector<G4ThreeVector> positions = RandomPositions();
+
+	G4cout << G4endl << "LUXSim microbenchmarks" << G4endl;
+	printf( "  %-48s %12s %12s\n", "kernel", "calls", "ns/call" );
+
+	BenchBST();
+	BenchFieldMaps( LUXManager, positions );
+	BenchNEST();
+	TestTabulatedDistributions();
+	TestOpticalFastPath();
+	BenchFastSim( positions );
+	BenchOutput( LUXManager );
+
+	G4cout << "  (checksum " << benchSink << ")" << G4endl << G4endl;
+
+	delete LUXManager;
+
+	if( numFailures ) {
+		G4cout << numFailures << " of the checks failed" << G4endl << G4endl;
+		return 1;
+	}
+
+	return 0;
+}
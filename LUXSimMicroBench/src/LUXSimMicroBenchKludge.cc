@@ -0,0 +1,15 @@
+////////////////////////////////////////////////////////////////////////////////
+/*	LUXSimMicroBenchKludge.cc
+*
+* As with LUXSim/src/LUXSimKludge.cc, this file only exists to satisfy the
+* GEANT4 build process, which expects a src directory with at least one symbol
+* in it.
+*
+********************************************************************************
+* Change log
+*	19-Oct-26 - Initial submission
+*
+*/
+////////////////////////////////////////////////////////////////////////////////
+
+void kludge() {}
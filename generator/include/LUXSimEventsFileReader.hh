@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+/*	LUXSimEventsFileReader.hh
+*
+* This is the header file for the reader behind the EventsFile generator. The
+* events file is read a block at a time as the run goes along, rather than all
+* at once when the source is set, so memory use doesn't depend on the size of
+* the file.
+*
+* Two formats are read. The text format is the original one, a line per energy
+* deposit:
+*
+*	event particleID energy(keV) x(cm) y(cm) z(cm)
+*
+* with all the lines of an event next to each other. The particle ID is a PDG
+* code, and ions use the 10LZZZAAAI nuclear code.
+*
+* The binary format is meant for primaries written by other codes (cosmogenic
+* showers, neutron captures, ...), and also carries a direction and a time. It
+* is recognized by its first eight bytes, "LUXevt01", which are followed by
+* records of
+*
+*	int32		event
+*	int32		particleID (PDG code)
+*	double		energy (keV)
+*	double		x, y, z (cm)
+*	double		direction x, y, z (all zero for an isotropic direction)
+*	double		time (ns), relative to the start of the event
+*
+* in the byte order of the machine running LUXSim, until the end of the file.
+*
+* When the end of the file is reached, the reader goes back to the start and
+* says so once.
+*
+********************************************************************************
+* Change log
+*	19-Oct-26 - Initial submission
+*
+*/
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LUXSimEventsFileReader_HH
+#define LUXSimEventsFileReader_HH 1
+
+//
+//	C/C++ includes
+//
+#include <fstream>
+#include <vector>
+
+//
+//	GEANT4 includes
+//
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+
+//
+//	Definitions
+//
+struct eventsFileDeposit {
+	G4int eventNumber;
+	G4int particleID;
+	G4double energy;
+	G4ThreeVector position;
+	G4ThreeVector direction;
+	G4double time;
+};
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+class LUXSimEventsFileReader
+{
+	public:
+		LUXSimEventsFileReader();
+		~LUXSimEventsFileReader();
+
+	public:
+		void Open( G4String fileName );
+		G4bool IsOpen() { return file.is_open(); };
+
+		//	Reads the deposits of the next event, and returns how many there
+		//	are. They stay valid until the next call.
+		G4int ReadNextEvent();
+		const eventsFileDeposit &GetDeposit( G4int i )
+				{ return currentEvent[i]; };
+
+	private:
+		struct binaryRecord {
+			G4int eventNumber;
+			G4int particleID;
+			G4double energy;
+			G4double x, y, z;
+			G4double dirX, dirY, dirZ;
+			G4double time;
+		};
+
+		G4bool HaveDeposit();
+		G4int ReadTextBlock();
+		G4int ReadBinaryBlock();
+		void Rewind();
+
+	private:
+		G4String eventsFileName;
+		std::ifstream file;
+		G4bool binaryFormat;
+		std::streampos dataStart;
+		G4bool warnedAboutRewind;
+
+		//	The read-ahead buffer holds at most readAheadSize deposits, and
+		//	readAheadPosition is the next one to be used
+		G4int readAheadSize;
+		G4int readAheadPosition;
+		G4int readAheadEnd;
+		std::vector<eventsFileDeposit> readAhead;
+		std::vector<binaryRecord> binaryRecords;
+
+		G4int numCurrentDeposits;
+		std::vector<eventsFileDeposit> currentEvent;
+};
+
+#endif
@@ -9,6 +9,8 @@
 *    27-May-2009 - This generator now works (Kareem)
 *    17-Nov-2011 - Fixed the low-energy end of the neutron energy CDF (Kareem)
 *    14-Jul-2012 - Methods changed so as to use the binary search tree (Nick)
+*    19-Oct-2026 - The neutron energy and gamma angle tables are now
+*                  LUXSimTabulatedDistributions
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -25,6 +27,7 @@
 //    LUXSim includes
 //
 #include "LUXSimSource.hh"
+#include "LUXSimTabulatedDistribution.hh"
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 class LUXSimGeneratorAmBe : public LUXSimSource
@@ -50,11 +53,8 @@ class LUXSimGeneratorAmBe : public LUXSimSource
         G4ParticleDefinition *neutronDef;
         G4ParticleDefinition *gammaDef;
         
-        G4double neutronCDF[758];
-        G4double neutronEnergy[758];
-        
-        G4double gammaCDF[5001];
-        G4double gammaAngle[5001];
+        LUXSimTabulatedDistribution neutronEnergySpectrum;
+        LUXSimTabulatedDistribution gammaAngleDistribution;
 };
 
 #endif
@@ -8,6 +8,8 @@
 *    13 Sep 2010 - Initial submission (Kareem)
 *    03 Mar 2011 - Added support for fission gammas (Kareem)
 *    14-Jul-2012 - Methods changed so as to use the binary search tree (Nick)
+*    19-Oct-2026 - The neutron and gamma spectra are now
+*                  LUXSimTabulatedDistributions
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -24,6 +26,7 @@
 //    LUXSim includes
 //
 #include "LUXSimSource.hh"
+#include "LUXSimTabulatedDistribution.hh"
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 class LUXSimGeneratorCfFission : public LUXSimSource
@@ -48,8 +51,8 @@ class LUXSimGeneratorCfFission : public LUXSimSource
         G4ParticleDefinition *neutronDef;
         G4ParticleDefinition *gammaDef;
         
-        G4double gammaCDF[86];
-        G4double gammaEnergy[86];
+        LUXSimTabulatedDistribution neutronEnergySpectrum;
+        LUXSimTabulatedDistribution gammaEnergySpectrum;
         
         G4double Z;
         G4double A;
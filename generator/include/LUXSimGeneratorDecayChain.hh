@@ -8,6 +8,8 @@
 *    21 Jul 2011 - Initial submission (modified from Kareem's stand-alone code)
 *                 (Nick)
 *    24 Aug 2012 - Add time unit specification to variables (Nick)
+*    19 Oct 2026 - Added the parsed chain type and the table of chain member
+*                  rates
 */
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -26,6 +28,7 @@
 #include "LUXSimBST.hh"
 #include "LUXSimIsotope.hh"
 #include "LUXSimSource.hh"
+#include "LUXSimTabulatedDistribution.hh"
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 class LUXSimGeneratorDecayChain : public LUXSimSource
@@ -71,6 +74,17 @@ class LUXSimGeneratorDecayChain : public LUXSimSource
         G4double populationU[19], ratesU[19];
         Isotope *isoArrayU[19];
 
+    private:
+        enum decayChainType { unknownChain, thoriumChain, uraniumChain };
+        decayChainType ParseChain( G4String );
+
+        //  The chain of the source whose events are being generated, and the
+        //  rate of each of its members at the age of the source
+        decayChainType currentChain;
+        G4int numChainMembers;
+        Isotope **chainMembers;
+        LUXSimTabulatedDistribution memberDistribution;
+
     private:
         G4ParticleDefinition *ion;
         G4double originalRate;
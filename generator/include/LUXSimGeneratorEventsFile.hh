@@ -6,6 +6,8 @@
 ********************************************************************************
 * Change log
 *   12-May-14 - Initial submission (Kevin)
+*   19-Oct-26 - Replaced the fixed electron, gamma and ion definitions with a
+*               lookup of any particle ID, and added the shared event isotope
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -13,6 +15,11 @@
 #ifndef LUXSimGeneratorEventsFile_HH
 #define LUXSimGeneratorEventsFile_HH 1
 
+//
+//    C/C++ includes
+//
+#include <map>
+
 //
 //    GEANT4 includes
 //
@@ -38,10 +45,12 @@ class LUXSimGeneratorEventsFile : public LUXSimSource
         void GenerateFromEventList(G4GeneralParticleSource*,G4Event*,decayNode*);
 
     private:
-        G4ParticleDefinition *ionDef;
-        G4ParticleDefinition *electronDef;
-        G4ParticleDefinition *gammaDef;
-        
+        G4ParticleDefinition *FindParticleDefinition( G4int particleID );
+
+    private:
+        Isotope *eventIsotope;
+        std::map<G4int,G4ParticleDefinition*> particleDefinitions;
+
 };
 
 #endif
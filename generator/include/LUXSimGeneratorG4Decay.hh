@@ -6,6 +6,7 @@
 ********************************************************************************
 * Change log
 *    06-Oct-2015 - Initial submission (David W)
+*    19-Oct-2026 - Removed the unused uiString member
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -57,7 +58,6 @@ class LUXSimGeneratorG4Decay : public LUXSimSource
 
     private:
         G4ParticleDefinition *ion ;
-        G4String uiString;
         G4int nucleusA;
         G4int nucleusZ;
 };
@@ -6,6 +6,8 @@
 ********************************************************************************
 * Change log
 *    31 March 2015 - Initial submission (Scott Haselschwardt)
+*    19 Oct 2026 - Neutron energies are drawn from an alias table
+*    19 Oct 2026 - Positions and energies come from LUXSimLZbkgSampler
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -22,6 +24,7 @@
 //    LUXSim includes
 //
 #include "LUXSimSource.hh"
+#include "LUXSimLZbkgSampler.hh"
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 class LUXSimGeneratorLZbkgNeutrons : public LUXSimSource
@@ -40,40 +43,15 @@ class LUXSimGeneratorLZbkgNeutrons : public LUXSimSource
 
     private:
         G4double GetNeutronEnergy();
-        void SetPosition();
-        void LoadWeights( G4String fileName );
-        void LoadNeutronEnergies( G4String fileName );
+        void LoadComponent( G4String component );
         
     private:
         G4ParticleDefinition *ionDef;
         G4ParticleDefinition *neutronDef;
         G4ParticleDefinition *geantinoDef;
         
-        //num bins for input temp plots
-        G4int numZbins;
-        G4int numR2bins;
-        G4int numWeights;
-        //bin widths
-        G4double zbinWidth;
-        G4double r2binWidth;
-        //final positions
-        G4double z;
-        G4double r2;
-        G4double x;
-        G4double y;
-        //final neutron energy
-        G4double energy;
-        
-        //weights from temp plot
-        //G4double weights[numWeights];
-        
-        G4double weights2[1125][180];
-        
-        G4double zbinCenters[180];
-        G4double r2binCenters[1125];
-        
-        G4double energyWeights[100];
-        G4double neutronEnergies[100];
+        G4String loadedComponent;
+        LUXSimLZbkgSampler backgroundMap;
         
 };
 
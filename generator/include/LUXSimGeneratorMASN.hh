@@ -8,6 +8,7 @@
 *    20 April 2009 - Initial submission (Kareem)
 *    27-May-2009 - This generator now works (Kareem)
 *    14-Jul-2012 - GenerateEvent changed to use binary search tree (Nick)
+*    19-Oct-2026 - The tables are now LUXSimTabulatedDistributions
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -24,6 +25,7 @@
 //    LUXSim includes
 //
 #include "LUXSimSource.hh"
+#include "LUXSimTabulatedDistribution.hh"
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 class LUXSimGeneratorMASN : public LUXSimSource
@@ -51,17 +53,12 @@ class LUXSimGeneratorMASN : public LUXSimSource
         G4ParticleDefinition *neutronDef;
         G4ParticleDefinition *muonDef;
         
-        G4double muonAngleCDF[1001];
-        G4double muonAngle[1001];
-        G4double muonEnergyCDF[1001];
-        G4double muonEnergy[1001];
+        LUXSimTabulatedDistribution muonAngleDistribution;
+        LUXSimTabulatedDistribution muonEnergySpectrum;
 
-        G4double neutronAngleCDF[1001];
-        G4double neutronAngle[1001];
-        G4double neutronMultCDF[1001];
-        G4double neutronMult[1001];
-        G4double neutronEnergyCDF[1001];
-        G4double neutronEnergy[1001];
+        LUXSimTabulatedDistribution neutronAngleDistribution;
+        LUXSimTabulatedDistribution neutronMultDistribution;
+        LUXSimTabulatedDistribution neutronEnergySpectrum;
 };
 
 #endif
@@ -1,12 +1,15 @@
 ////////////////////////////////////////////////////////////////////////////////
-/*    LUXSimGeneratorAmBe.hh
+/*    LUXSimGeneratorNeutronGenerator-p-Li.hh
 *
-* This is the header file for the AmBe generator.
+* This is the header file for the p-Li neutron generator.
 *
 ********************************************************************************
 * Change log
 *    25 August 2011 - Initial submission (Mike)
 *    14-Jul-2012 - GenerateEvent changed to use binary search tree (Nick)
+*    19-Oct-2026 - The yield tables are read from a binary file on first use
+*                  and sampled from a conditional inverse CDF
+*    19-Oct-2026 - Corrected the file name and description in this header
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -14,6 +17,11 @@
 #ifndef LUXSimGeneratorpLithium_HH
 #define LUXSimGeneratorpLithium_HH 1
 
+//
+//    C/C++ includes
+//
+#include <vector>
+
 //
 //    GEANT4 includes
 //
@@ -23,6 +31,7 @@
 //    LUXSim includes
 //
 #include "LUXSimSource.hh"
+#include "LUXSimTabulatedDistribution.hh"
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 class LUXSimGeneratorpLithium : public LUXSimSource
@@ -41,25 +50,23 @@ class LUXSimGeneratorpLithium : public LUXSimSource
 
     private:
         void GetNeutronEnergy();
-
+        void LoadTables();
 
     private:
         G4ParticleDefinition *ionDef;
         G4ParticleDefinition *neutronDef;
         G4ParticleDefinition *gammaDef;
         
-        G4double neutronAnglePDF[28000];
-        G4double neutronEnergyPDF[28000];
-        G4double neutronCountPDF[28000];
-    
-        G4double energy;
-        G4double angle;
+        G4String tableFile;
+        G4bool tablesLoaded;
+        std::vector<G4double> cosThetaNodes;
+        std::vector<G4double> cosThetaYield;
+        LUXSimTabulatedDistribution cosThetaDistribution;
+        std::vector<LUXSimTabulatedDistribution> energySpectra;
     
         G4double neutronEnergy;
         G4double neutronAngle;
     
-        G4double testcount;
-    
         G4double lowang;
         G4double highang;
         G4double lowangDegrees;
@@ -7,6 +7,8 @@
 * Change log
 *   19-Aug-11 - Initial submission (Nick)
 *   14-Jul-12 - GeneateEvent changed to use binary search tree (Nick)
+*   19-Oct-26 - The photons are put straight into the event, with directions,
+*               polarizations and energies drawn a batch at a time
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -20,6 +22,11 @@
 #include "G4ParticleDefinition.hh"
 #include "globals.hh"
 
+//
+//   C/C++ includes
+//
+#include <vector>
+
 //
 //   LUXSim includes
 //
@@ -40,11 +47,23 @@ class LUXSimGeneratorScintPhotons : public LUXSimSource
     //using LUXSimSource::GenerateEvent;
     //void GenerateEvent( G4GeneralParticleSource*, G4Event*);
 
+  private:
+    void FillBatch();
+
   private:
     G4ParticleDefinition *photon;
+    Isotope *eventIsotope;
     G4ThreeVector direction, polarization, perp;
     G4double theta, xpol, ypol, zpol, phi, sinp, cosp;
 
+    //  The photon kinematics are drawn batchSize at a time, and batchPosition
+    //  is the next one to be used
+    G4int batchSize;
+    G4int batchPosition;
+    std::vector<G4ThreeVector> batchDirections;
+    std::vector<G4ThreeVector> batchPolarizations;
+    std::vector<G4double> batchEnergies;
+
 };
 
 #endif
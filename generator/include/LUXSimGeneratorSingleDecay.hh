@@ -9,6 +9,7 @@
 *   04-Mar-12 - Fixed bug where primary particle was both the LUXSource default
 *               and the user specified SingleDecay (Nick)
 *   14-Jul-12 - GenerateEvent method changed to use binary search tree (Nick)
+*   19-Oct-26 - Removed the unused uiString member
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -55,8 +56,6 @@ class LUXSimGeneratorSingleDecay : public LUXSimSource
 
     private:
         G4ParticleDefinition *ion ;
-        //std::stringstream uiStream;
-        G4String uiString;
         G4int nucleusA;
         G4int nucleusZ;
 
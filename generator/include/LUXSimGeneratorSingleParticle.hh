@@ -7,6 +7,8 @@
 * Change log
 *   04-Mar-12 - Initial submission (Nick)
 *   14-Jul-12 - GenerateEvent method changed to use binary search tree (Nick)
+*   19-Oct-26 - The particle is put straight into the event, and the particle
+*               definitions and isotopes are kept between events
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -20,6 +22,11 @@
 #include "G4ParticleDefinition.hh"
 #include "globals.hh"
 
+//
+//    C/C++ includes
+//
+#include <map>
+
 //
 //    LUXSim includes
 //
@@ -49,6 +56,9 @@ class LUXSimGeneratorSingleParticle : public LUXSimSource
 
   private:
     G4ParticleDefinition *particlename;
+    G4String lastParticleString;
+    //  One isotope for each particle name and energy the list is made of
+    std::map< std::pair<G4String,G4double>, Isotope* > eventIsotopes;
     G4double energy;
     std::stringstream uiStream;
     G4String uiString;
@@ -6,6 +6,7 @@
 ********************************************************************************
 * Change log
 *    23-Jul-2013 - Initial submission (Kareem)
+*    19-Oct-2026 - The beta spectrum is now a LUXSimTabulatedDistribution
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -22,6 +23,7 @@
 //    LUXSim includes
 //
 #include "LUXSimSource.hh"
+#include "LUXSimTabulatedDistribution.hh"
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 class LUXSimGeneratorTritium : public LUXSimSource
@@ -38,6 +40,7 @@ class LUXSimGeneratorTritium : public LUXSimSource
 
     private:
         G4double GetElectronEnergy();
+        G4double GetBetaSpectrum( G4double );
 
     private:
 		G4double Q;
@@ -46,7 +49,7 @@ class LUXSimGeneratorTritium : public LUXSimSource
 		G4double a;
 		G4double Z;
 		G4double xmax;
-		G4double ymax;
+		LUXSimTabulatedDistribution electronEnergySpectrum;
         G4ParticleDefinition *electronDef;        
 };
 
@@ -10,6 +10,8 @@
 *                 escape velocities. (Daniel)
 *   14-Jul-2012 - GenerateEvent replaced with GenerateEventList and 
 *                 GenerateFromEventList (Nick)
+*   19-Oct-2026 - The recoil spectrum for each WIMP mass and target isotope is
+*                 now built once and cached, and sampled with a guide table
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -23,6 +25,11 @@
 #include "G4ParticleDefinition.hh"
 #include "globals.hh"
 
+//
+//	C/C++ includes
+//
+#include <vector>
+
 //
 //	LUXSim includes
 //
@@ -43,10 +50,29 @@ class LUXSimGeneratorWimp : public LUXSimSource
         void GenerateFromEventList( G4GeneralParticleSource*, G4Event*,
                     decayNode*);
 
+        void ResetSourceCache() { recoilSpectra.clear(); };
+
+    private:
+        //  The binned recoil spectrum for one WIMP mass and target isotope.
+        //  cdf holds the cumulative bin probabilities, and guide[j] is the
+        //  first bin whose cdf reaches j/guide.size(), so that sampling starts
+        //  right next to the answer instead of at the first bin.
+        struct recoilSpectrum {
+            G4double wimpMass;
+            G4double targetMass;
+            G4double endPoint;
+            std::vector<G4double> cdf;
+            std::vector<G4int> guide;
+        };
+
     private:
         G4double dR(G4double, G4double, G4double);
+        recoilSpectrum *GetRecoilSpectrum( G4double, G4double );
+        G4double SampleRecoilEnergy( recoilSpectrum* );
         G4ParticleDefinition *ion;
 
+        std::vector<recoilSpectrum> recoilSpectra;
+
 };
 
 #endif
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+/*	LUXSimLZbkgSampler.hh
+*
+* This is the header file for the position and energy sampler shared by the LZ
+* background generators (LZbkgGammas and LZbkgNeutrons).
+*
+* The position map is a text file of "r^2 z weight" lines on a regular grid in
+* r^2 (cm^2) and z (cm), with z varying fastest. The weights are turned into a
+* 2D alias table, so each position costs a fixed two random numbers for the bin
+* plus three for the point inside it, however sparse the map is. Because the
+* text maps are several MB, the parsed grid is also written to a binary cache
+* next to the map (<map>.cache), which is used from then on as long as the
+* size and modification time of the map haven't changed.
+*
+* If a fiducial volume is set before the map is loaded, each bin's weight is
+* scaled by the fraction of the bin inside it and positions are only drawn
+* from that part of the bin.
+*
+* The energy spectrum is a text file of "energy weight" lines, with energies in
+* MeV. Each energy is returned with a probability proportional to its weight,
+* so the file can hold either the bin centres of a binned spectrum or a list of
+* lines.
+*
+********************************************************************************
+* Change log
+*	19-Oct-26 - Initial submission
+*
+*/
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LUXSimLZbkgSampler_HH
+#define LUXSimLZbkgSampler_HH 1
+
+//
+//	C/C++ includes
+//
+#include <vector>
+
+//
+//	GEANT4 includes
+//
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+
+//
+//	LUXSim includes
+//
+#include "LUXSimTabulatedDistribution.hh"
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+class LUXSimLZbkgSampler
+{
+	public:
+		LUXSimLZbkgSampler();
+		~LUXSimLZbkgSampler();
+
+	public:
+		void SetFiducialVolume( G4double zMin, G4double zMax, G4double r2Max );
+		void LoadPositionMap( G4String fileName );
+		void LoadEnergySpectrum( G4String fileName );
+
+		G4ThreeVector GetPosition();
+		G4double GetEnergy();
+
+	private:
+		G4bool ReadCache( G4String fileName, std::vector<G4double> &weights );
+		void WriteCache( G4String fileName, std::vector<G4double> &weights );
+		void GetBinBounds( G4int r2bin, G4int zbin, G4double &r2Low,
+				G4double &r2High, G4double &zLow, G4double &zHigh );
+
+	private:
+		//	Grid of the position map. The first bin centres and the bin widths
+		//	are in cm^2 (r^2) and cm (z).
+		G4int numR2bins;
+		G4int numZbins;
+		G4double r2FirstCenter;
+		G4double r2binWidth;
+		G4double zFirstCenter;
+		G4double zbinWidth;
+
+		G4bool useFiducialVolume;
+		G4double fiducialZMin;
+		G4double fiducialZMax;
+		G4double fiducialR2Max;
+
+		LUXSimTabulatedDistribution positionDistribution;
+
+		std::vector<G4double> energies;
+		LUXSimTabulatedDistribution energyDistribution;
+};
+
+#endif
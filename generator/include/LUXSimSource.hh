@@ -18,6 +18,16 @@
 *   24-Aug-2012 - Add ParentDecayTime() method used only in DecayChain source
 *                 so DetectorComponent stops asking for new decays after the
 *                 recordTree timeWindow is reaches (Nick)
+*   19-Oct-2026 - Added ResetSourceCache() so generators that tabulate their
+*                 spectra can drop them when the sources are reset
+*   19-Oct-2026 - Added SetIon() and SetNucleusLimits() so the generators no
+*                 longer go through /gps/ion and /grdm/nucleusLimits for
+*                 every event
+*   19-Oct-2026 - Added GeneratePrimary(), which fills the primary vertex
+*                 directly for the generators that don't need the GPS
+*   19-Oct-2026 - Dropped the copy of the last nucleus limits
+*   19-Oct-2026 - The copy of the last nucleus limits is back, and is cleared
+*                 by ResetNucleusLimits() at the start of each run
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -30,12 +40,19 @@
 //
 #include "Randomize.hh"
 
+//
+//	C/C++ includes
+//
+#include <map>
+
 //
 //	GEANT4 includes
 //
 #include "G4UImanager.hh"
 #include "G4GeneralParticleSource.hh"
 #include "G4Event.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PrimaryParticle.hh"
 #include "globals.hh"
 #include "G4Gamma.hh"
 
@@ -79,6 +96,12 @@ class LUXSimSource
                             G4String);
         virtual void GenerateEventList( G4ThreeVector, G4int, G4int, G4String );
         virtual G4double GetParentDecayTime() {return 0.;};
+        //  Drops anything a generator has tabulated for the current sources
+        virtual void ResetSourceCache() {};
+        //  Forgets the nucleus limits last sent, so the next ones are sent
+        //  whatever they are. Macros can only set /grdm/nucleusLimits between
+        //  runs, so this is called at the start of each run.
+        static void ResetNucleusLimits();
 
         // generate from event list
 		virtual void GenerateFromEventList( G4GeneralParticleSource*, G4Event*,
@@ -94,6 +117,14 @@ class LUXSimSource
         LUXSimManager::primaryParticleInfo GetParticleInfo( 
                         G4GeneralParticleSource* );
 		G4ThreeVector GetRandomDirection();
+		void SetIon( G4GeneralParticleSource*, G4int Z, G4int A,
+				G4int charge=0, G4double excitation=0 );
+		void SetNucleusLimits( G4int aMin, G4int aMax, G4int zMin,
+				G4int zMax );
+		void GeneratePrimary( G4Event*, G4ParticleDefinition*,
+				const G4ThreeVector &position, const G4ThreeVector &direction,
+				G4double energy, G4double time,
+				const G4ThreeVector &polarization=G4ThreeVector() );
 		virtual G4double GetEnergy() { return 1.*MeV; };
 		virtual G4ParticleDefinition *GetParticleDefinition()
 			{ return G4Gamma::Definition(); };
@@ -106,6 +137,13 @@ class LUXSimSource
 		G4double xDir, yDir, zDir;
 		G4double cosTheta, sinTheta, phi;
 		G4double prob;
+
+		//	Shared by all generators: the ion definitions looked up so far,
+		//	keyed by 1000*Z+A and excitation energy, and the nucleus limits
+		//	last sent to the radioactive decay process
+		static std::map< std::pair<G4int,G4double>, G4ParticleDefinition* >
+				ionDefinitions;
+		static G4int nucleusLimits[4];
 };
 
 #endif
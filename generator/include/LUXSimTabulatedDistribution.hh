@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////
+/*	LUXSimTabulatedDistribution.hh
+*
+* This is the header file for the tabulated distribution sampler shared by the
+* spectrum-based generators. A distribution is built once, when the generator
+* is constructed, and then sampled with one random number per call for a
+* continuous distribution, or two for a discrete one.
+*
+* Continuous distributions are given as a CDF (or a PDF, which is integrated
+* with the trapezoid rule) at a set of points, and are sampled by inverting the
+* CDF with linear interpolation between points. This is the same mapping the
+* generators used to do with a binary search, but the bin is found with a
+* guide table instead, so a sample costs O(1) rather than O(log N).
+*
+* Discrete distributions are given as a set of non-negative weights, in one or
+* two dimensions, and are sampled with a Walker/Vose alias table.
+*
+********************************************************************************
+* Change log
+*	19-Oct-26 - Initial submission
+*	19-Oct-26 - Corrected the number of random numbers per sample
+*
+*/
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LUXSimTabulatedDistribution_HH
+#define LUXSimTabulatedDistribution_HH 1
+
+//
+//	C/C++ includes
+//
+#include <vector>
+
+//
+//	GEANT4 includes
+//
+#include "globals.hh"
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+class LUXSimTabulatedDistribution
+{
+	public:
+		LUXSimTabulatedDistribution();
+		~LUXSimTabulatedDistribution();
+
+	public:
+		//	Continuous distributions. The x values must be increasing, and the
+		//	CDF non-decreasing. It doesn't have to start at 0 or end at 1.
+		void SetCDF( G4int numPoints, const G4double *x, const G4double *cdf );
+		void SetPDF( G4int numPoints, const G4double *x, const G4double *pdf );
+
+		G4double Sample();
+		G4double Sample( G4double xMax );
+		G4double GetInverseCDF( G4double prob );
+		G4double GetCDF( G4double x );
+
+		inline G4double GetXMin() { return xValues.front(); };
+		inline G4double GetXMax() { return xValues.back(); };
+
+		//	Discrete distributions. The two-dimensional weights are given in
+		//	row-major order, i.e., weights[i*numY + j].
+		void SetWeights( G4int numBins, const G4double *weights );
+		void SetWeights( G4int numX, G4int numY, const G4double *weights );
+
+		G4int SampleIndex();
+		void SampleIndex( G4int &i, G4int &j );
+
+	private:
+		void BuildGuideTable();
+
+	private:
+		std::vector<G4double> xValues;
+		std::vector<G4double> cdfValues;
+		std::vector<G4int> guideTable;
+
+		std::vector<G4double> aliasProbability;
+		std::vector<G4int> aliasIndex;
+		G4int numColumns;
+};
+
+#endif
@@ -0,0 +1,206 @@
+////////////////////////////////////////////////////////////////////////////////
+/*	LUXSimEventsFileReader.cc
+*
+* This is the code file for the events file reader. See the header file for a
+* description of the formats.
+*
+********************************************************************************
+* Change log
+*	19-Oct-26 - Initial submission
+*
+*/
+////////////////////////////////////////////////////////////////////////////////
+
+//
+//	C/C++ includes
+//
+#include <cstring>
+
+//
+//	GEANT4 includes
+//
+#include "globals.hh"
+
+//
+//	LUXSim includes
+//
+#include "LUXSimEventsFileReader.hh"
+
+//
+//	Definitions
+//
+#define BINARY_MAGIC "LUXevt01"
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//				LUXSimEventsFileReader()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+LUXSimEventsFileReader::LUXSimEventsFileReader()
+{
+	binaryFormat = false;
+	warnedAboutRewind = false;
+
+	readAheadSize = 4096;
+	readAheadPosition = readAheadEnd = 0;
+
+	numCurrentDeposits = 0;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//				~LUXSimEventsFileReader()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+LUXSimEventsFileReader::~LUXSimEventsFileReader()
+{
+	if( file.is_open() )
+		file.close();
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					Open()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimEventsFileReader::Open( G4String fileName )
+{
+	if( file.is_open() )
+		file.close();
+	file.clear();
+
+	eventsFileName = fileName;
+	file.open( fileName.c_str(), std::ios::in | std::ios::binary );
+	if( !file.is_open() ) {
+		G4cout << G4endl << G4endl << G4endl;
+		G4cout << "Events File Not Found! " << fileName << G4endl;
+		G4cout << G4endl << G4endl << G4endl;
+		exit(0);
+	}
+
+	char magic[8];
+	file.read( magic, 8 );
+	binaryFormat = ( file.gcount() == 8 && !strncmp( magic, BINARY_MAGIC, 8 ) );
+	file.clear();
+	if( !binaryFormat )
+		file.seekg( 0 );
+	dataStart = file.tellg();
+
+	readAhead.resize( readAheadSize );
+	if( binaryFormat )
+		binaryRecords.resize( readAheadSize );
+	readAheadPosition = readAheadEnd = 0;
+	numCurrentDeposits = 0;
+	warnedAboutRewind = false;
+
+	G4cout << "Reading " << ( binaryFormat ? "binary" : "text" )
+		   << " events file " << fileName << G4endl;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					ReadNextEvent()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4int LUXSimEventsFileReader::ReadNextEvent()
+{
+	numCurrentDeposits = 0;
+
+	if( !HaveDeposit() ) {
+		Rewind();
+		if( !HaveDeposit() ) {
+			G4cout << G4endl << G4endl << G4endl;
+			G4cout << "There are no events in " << eventsFileName << G4endl;
+			G4cout << G4endl << G4endl << G4endl;
+			exit(0);
+		}
+	}
+
+	//	The deposits are copied out of the read-ahead buffer, because an event
+	//	can run across the end of one block and into the next. The vector only
+	//	grows until it fits the largest event in the file.
+	G4int eventNumber = readAhead[readAheadPosition].eventNumber;
+	while( HaveDeposit() &&
+			readAhead[readAheadPosition].eventNumber == eventNumber ) {
+		if( numCurrentDeposits < (G4int)currentEvent.size() )
+			currentEvent[numCurrentDeposits] = readAhead[readAheadPosition];
+		else
+			currentEvent.push_back( readAhead[readAheadPosition] );
+		numCurrentDeposits++;
+		readAheadPosition++;
+	}
+
+	return numCurrentDeposits;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					HaveDeposit()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4bool LUXSimEventsFileReader::HaveDeposit()
+{
+	if( readAheadPosition < readAheadEnd )
+		return true;
+
+	readAheadPosition = 0;
+	readAheadEnd = ( binaryFormat ? ReadBinaryBlock() : ReadTextBlock() );
+
+	return( readAheadEnd > 0 );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					ReadTextBlock()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4int LUXSimEventsFileReader::ReadTextBlock()
+{
+	G4int numRead = 0;
+	G4double energy_keV, x_cm, y_cm, z_cm;
+	while( numRead < readAheadSize ) {
+		eventsFileDeposit &deposit = readAhead[numRead];
+		file >> deposit.eventNumber >> deposit.particleID >> energy_keV
+			 >> x_cm >> y_cm >> z_cm;
+		if( file.fail() )
+			break;
+
+		deposit.energy = energy_keV*keV;
+		deposit.position = G4ThreeVector( x_cm*cm, y_cm*cm, z_cm*cm );
+		deposit.direction = G4ThreeVector( 0, 0, 0 );
+		deposit.time = 0;
+		numRead++;
+	}
+
+	return numRead;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					ReadBinaryBlock()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4int LUXSimEventsFileReader::ReadBinaryBlock()
+{
+	file.read( (char*)&binaryRecords[0], readAheadSize*sizeof(binaryRecord) );
+	G4int numRead = (G4int)( file.gcount() / sizeof(binaryRecord) );
+
+	for( G4int i=0; i<numRead; i++ ) {
+		const binaryRecord &record = binaryRecords[i];
+		eventsFileDeposit &deposit = readAhead[i];
+		deposit.eventNumber = record.eventNumber;
+		deposit.particleID = record.particleID;
+		deposit.energy = record.energy*keV;
+		deposit.position = G4ThreeVector( record.x*cm, record.y*cm,
+				record.z*cm );
+		deposit.direction = G4ThreeVector( record.dirX, record.dirY,
+				record.dirZ );
+		if( deposit.direction.mag2() > 0 )
+			deposit.direction = deposit.direction.unit();
+		deposit.time = record.time*ns;
+	}
+
+	return numRead;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					Rewind()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimEventsFileReader::Rewind()
+{
+	if( !warnedAboutRewind ) {
+		G4cout << "Reached the end of " << eventsFileName
+			   << ", starting again from the first event" << G4endl;
+		warnedAboutRewind = true;
+	}
+
+	file.clear();
+	file.seekg( dataStart );
+	readAheadPosition = readAheadEnd = 0;
+}
@@ -12,6 +12,8 @@
 *   03-Apr-2012 - Fixed a bug in the upper index of the neutron CDF binary
 *              search (Kareem)
 *   14-Jul-2012 - GenerateEventList methods for binary search tree. (Nick)
+*   19-Oct-2026 - The neutron energy and gamma angle are sampled from
+*              LUXSimTabulatedDistributions instead of a binary search
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -413,10 +415,7 @@ LUXSimGeneratorAmBe::LUXSimGeneratorAmBe()
       10.878, 10.915, 10.952
    };
    
-   for( G4int i=0; i<758; i++ ) {
-      neutronCDF[i] = neutronCDFTemp[i];
-      neutronEnergy[i] = neutronEnergyTemp[i];
-   }
+   neutronEnergySpectrum.SetCDF( 758, neutronEnergyTemp, neutronCDFTemp );
    
    G4double gammaCDFTemp[] = {
       0, 0.000581817, 0.00116363, 0.00174544, 0.00232725, 0.00290905, 
@@ -1140,10 +1139,10 @@ LUXSimGeneratorAmBe::LUXSimGeneratorAmBe()
       0.998255, 0.998836, 0.999418, 1.0   
    };
       
-   for( G4int i=0; i<5001; i++ ) {
-      gammaCDF[i] = gammaCDFTemp[i];
-      gammaAngle[i] = 3.14159265358979312*i/5000;
-   }
+   G4double gammaAngleTemp[5001];
+   for( G4int i=0; i<5001; i++ )
+      gammaAngleTemp[i] = 3.14159265358979312*i/5000;
+   gammaAngleDistribution.SetCDF( 5001, gammaAngleTemp, gammaCDFTemp );
    
    neutronDef = G4Neutron::Definition();
    gammaDef = G4Gamma::Definition();
@@ -1268,22 +1267,7 @@ void LUXSimGeneratorAmBe::GenerateFromEventList( G4GeneralParticleSource
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 G4double LUXSimGeneratorAmBe::GetNeutronEnergy()
 {
-   G4double prob = G4UniformRand();
-   G4int indexLo = 0, indexHi = 757;
-
-   while( !(neutronCDF[indexLo+1] > prob && neutronCDF[indexHi-1] < prob) ) {
-      if( neutronCDF[(indexLo+indexHi)/2] < prob )
-         indexLo = (indexLo + indexHi)/2;
-      else
-         indexHi = (indexLo + indexHi)/2;
-   }
-   
-   G4double split = (prob - neutronCDF[indexLo]) /
-         (neutronCDF[indexHi] - neutronCDF[indexLo]);
-   G4double energy = neutronEnergy[indexLo] +
-         split*(neutronEnergy[indexHi] - neutronEnergy[indexLo]);
-   
-   return( energy );
+   return( neutronEnergySpectrum.Sample() );
 }
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -1291,20 +1275,5 @@ G4double LUXSimGeneratorAmBe::GetNeutronEnergy()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 G4double LUXSimGeneratorAmBe::GetGammaAngle()
 {
-   G4double prob = G4UniformRand();
-   G4int indexLo = 0, indexHi = 5000;
-
-   while( !(gammaCDF[indexLo+1] > prob && gammaCDF[indexHi-1] < prob) ) {
-      if( gammaCDF[(indexLo+indexHi)/2] < prob )
-         indexLo = (indexLo + indexHi)/2;
-      else
-         indexHi = (indexLo + indexHi)/2;
-   }
-   
-   G4double split = (prob - gammaCDF[indexLo]) /
-       (gammaCDF[indexHi] - gammaCDF[indexLo]);
-   G4double angle = gammaAngle[indexLo] +
-       split*(gammaAngle[indexHi] - gammaAngle[indexLo]);
-   
-   return( angle );
+   return( gammaAngleDistribution.Sample() );
 }
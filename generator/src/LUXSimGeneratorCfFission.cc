@@ -10,6 +10,9 @@
 *   14-Jul-2012 - GenerateEventList methods for binary search tree. (Nick)
 *	23-Oct-2012 - Fixed a bug that was causing an infinite loop during selection
 *				  of the gamma energy (Kareem)
+*	19-Oct-2026 - The Watt spectrum is tabulated once and sampled by inverting
+*				  its CDF, and the gamma energy is drawn from the spectrum
+*				  truncated at the remaining energy rather than by rejection
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -33,14 +36,10 @@
 	http://www-nds.iaea.org/reports-new/indc-reports/indc-nds/indc-nds-0220.pdf
 	Specifically, see absolute pages 331-333 (reference pages 329-331).
 	
-	The range of neutron energies is taken to be between 1 meV and 15 MeV. To
-	obtain the appropriate energy, two random values are chosen, x and y. If
-	this point is below the energy curve, that x value is the neutron energy. If
-	the point is above the curve, another random point is generated.
-	
-	To make this work, the maximum value of the curve must be known. That value
-	turns out to be a little over 0.47, so the randomly-generated y values are
-	selected up to 0.48.
+	The range of neutron energies is taken to be between 0 and 15 MeV. The
+	curve is evaluated at 1 keV intervals when the generator is created, and
+	each neutron energy is then obtained by inverting the integral of that
+	table with a single random number.
 	
 	The code for the gamma multiplicity and total energy comes from Timothy E.
 	Valentine, "Evaluation of Prompt Fission Gamma Rays for use in Simulating
@@ -180,8 +179,10 @@ LUXSimGeneratorCfFission::LUXSimGeneratorCfFission()
 			7.414, 4.522e-4 };
 	
 	G4int numPoints = sizeof(gammaInfo)/sizeof(G4double)/2;
-	G4double *gammaPDF, totalArea = 0.;
+	G4double *gammaPDF, *gammaCDF, *gammaEnergy, totalArea = 0.;
 	gammaPDF = new G4double[numPoints];
+	gammaCDF = new G4double[numPoints];
+	gammaEnergy = new G4double[numPoints];
 	for( G4int i=0; i<numPoints; i++ ) {
 		gammaEnergy[i] = gammaInfo[i*2];
 		gammaPDF[i] = gammaInfo[i*2 + 1];
@@ -195,8 +196,26 @@ LUXSimGeneratorCfFission::LUXSimGeneratorCfFission()
 	for( G4int i=1; i<numPoints; i++ )
 		gammaCDF[i] = gammaCDF[i-1] + gammaPDF[i-1];
 	gammaCDF[numPoints-1] = 1.;
+	gammaEnergySpectrum.SetCDF( numPoints, gammaEnergy, gammaCDF );
 	
 	delete [] gammaPDF;
+	delete [] gammaCDF;
+	delete [] gammaEnergy;
+	
+	//	Tabulate the Watt spectrum for the neutron energies
+	G4int numNeutronPoints = 15001;
+	G4double *neutronEnergy, *neutronPDF;
+	neutronEnergy = new G4double[numNeutronPoints];
+	neutronPDF = new G4double[numNeutronPoints];
+	for( G4int i=0; i<numNeutronPoints; i++ ) {
+		neutronEnergy[i] = 15.*i/(numNeutronPoints-1);
+		neutronPDF[i] = exp(-neutronEnergy[i]/1.209) *
+				sinh( sqrt(0.836*neutronEnergy[i]) );
+	}
+	neutronEnergySpectrum.SetPDF( numNeutronPoints, neutronEnergy, neutronPDF );
+	
+	delete [] neutronEnergy;
+	delete [] neutronPDF;
 }
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -290,15 +309,7 @@ void LUXSimGeneratorCfFission::GenerateFromEventList( G4GeneralParticleSource
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 G4double LUXSimGeneratorCfFission::GetNeutronEnergy()
 {
-	G4double energy = G4UniformRand() * 15 + 1e-9;
-	G4double height = G4UniformRand() * 0.48;
-
-	while( height > (exp(-energy/1.209) * sinh( sqrt(0.836*energy))) ) {
-		energy = G4UniformRand() * 15;
-		height = G4UniformRand() * 0.48;
-	}
-	
-	return( energy );
+	return( neutronEnergySpectrum.Sample() );
 }
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -306,26 +317,8 @@ G4double LUXSimGeneratorCfFission::GetNeutronEnergy()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 G4double LUXSimGeneratorCfFission::GetGammaEnergy( G4double limit )
 {
-	G4double energy = limit + 1;
-
-	if( limit < gammaEnergy[0] )
-		energy = limit;
-	else while( energy > limit ) {
-		G4double prob = G4UniformRand();
-		G4int indexLo = 0, indexHi = 86;
-
-		while( !(gammaCDF[indexLo+1] > prob && gammaCDF[indexHi-1] < prob) ) {
-			if( gammaCDF[(indexLo+indexHi)/2] < prob )
-				indexLo = (indexLo + indexHi)/2;
-			else
-				indexHi = (indexLo + indexHi)/2;
-		}
-		
-		G4double split = (prob - gammaCDF[indexLo]) /
-				(gammaCDF[indexHi] - gammaCDF[indexLo]);
-		energy = gammaEnergy[indexLo] +
-				split*(gammaEnergy[indexHi] - gammaEnergy[indexLo]);
-	}
+	if( limit < gammaEnergySpectrum.GetXMin() )
+		return( limit );
 	
-	return( energy );
+	return( gammaEnergySpectrum.Sample( limit ) );
 }
@@ -10,6 +10,12 @@
 *                 (Nick)
 *    22 Aug 2012 - Fix RecordTreeInsert to insert in *ns (Nick)
 *    24 Aug 2012 - Add time unit specification to variables (Nick)
+*    19 Oct 2026 - Ions and nucleus limits are set with SetIon() and
+*                  SetNucleusLimits() instead of UI commands
+*    19 Oct 2026 - The chain is parsed once per source, and the decay rates
+*                  of the chain members are put in an alias table when the
+*                  populations are calculated, instead of being recalculated
+*                  and searched for every decay
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -56,6 +62,10 @@ LUXSimGeneratorDecayChain::LUXSimGeneratorDecayChain()
     originalRate = 0;
     originalTime_s = 0;
 
+    currentChain = unknownChain;
+    numChainMembers = 0;
+    chainMembers = 0;
+
     //   Initialize the Isotope Chains for both Th232 and U238               
     //
     //      The Th232 decay chain
@@ -284,50 +294,56 @@ void LUXSimGeneratorDecayChain::CalculatePopulationsInEventList(G4double
     //    Determine the original population of the parent nucleus based on its
     //    activity rate. (Work in units of Bq and seconds)
     originalTime_s = 0;
-    Isotope *origIso = 0;
 
-    if( iso.find( "Th232")!=G4String::npos  )
-        origIso = isoArrayTh[0]; 
-    else if( iso.find("U238")!=G4String::npos ) {
-        origIso = isoArrayU[0]; 
-    } else G4cout << "Parent Isotope not found in DecayChain\n" ;
-    
-    //Isotope *origIso = isoArrayTh[0]; 
-    //G4double Th228pop = populationTh[3];
-    No = initialActivity * origIso->GetHalflife() / log(2.);
+    currentChain = ParseChain( iso );
+    G4double *population = 0;
+    G4double *rates = 0;
+    if( currentChain == thoriumChain ) {
+        chainMembers = isoArrayTh;
+        numChainMembers = 11;
+        population = populationTh;
+        rates = ratesTh;
+    }
+    else if( currentChain == uraniumChain ) {
+        chainMembers = isoArrayU;
+        numChainMembers = 19;
+        population = populationU;
+        rates = ratesU;
+    }
+    else {
+        G4cout << "Parent Isotope " << iso << " not found in DecayChain"
+               << G4endl;
+        exit(0);
+    }
+
+    No = initialActivity * chainMembers[0]->GetHalflife() / log(2.);
     G4int numEvents = luxManager->GetNumEvents();
     while( numEvents > No )
         No *= 2;
-    G4double totalRate;
 
-    if( iso.find("Th232")!=G4String::npos  ) {
+    if( currentChain == thoriumChain ) {
         this->CalculatePopulationsTh232( populationTh, No, sourceAge );
-        totalRate = this->CalculateRatesTh232( populationTh, ratesTh );
+        originalRate = this->CalculateRatesTh232( populationTh, ratesTh );
     } 
-    else if ( iso.find("U238")!=G4String::npos  ) {
+    else {
         this->CalculatePopulationsU238( populationU, No, sourceAge );
-        totalRate = this->CalculateRatesU238( populationU, ratesU );
+        originalRate = this->CalculateRatesU238( populationU, ratesU );
     } 
-    else G4cout << "Parent Isotope not found again \n";
+
+    //    The rates only depend on the age of the source, which is fixed for
+    //    the run, so the chain member that decays next can be drawn from a
+    //    table built here rather than by searching the rates each time.
+    memberDistribution.SetWeights( numChainMembers, rates );
 
     G4cout << "With a source age of " << sourceAge << 
                 " seconds, the populations and rates are" << G4endl;
 
-    if( iso.find("Th232")!=G4String::npos  ) {
-      for( G4int i=0; i<11; i++ ) {
-        G4cout << "\t" << isoArrayTh[i]->Name() << ": " << populationTh[i];
-        G4cout << " \t" << ratesTh[i] << " Bq" << G4endl;
-      }
-    } 
-    else if( iso.find("U238")!=G4String::npos  ) {
-      for( G4int i=0; i<19; i++ ) {
-        G4cout << "\t" << isoArrayU[i]->Name() << ": " ;
-        if( i==3 || i==0 ) G4cout << " " ;
-        G4cout << populationU[i];
-        G4cout << " \t" << ratesU[i] << " Bq" << G4endl;
-      }
-    } 
-    else G4cout << "Parent Isotope not found once again \n";
+    for( G4int i=0; i<numChainMembers; i++ ) {
+        G4cout << "\t" << chainMembers[i]->Name() << ": " ;
+        if( currentChain == uraniumChain && (i==3 || i==0) ) G4cout << " " ;
+        G4cout << population[i];
+        G4cout << " \t" << rates[i] << " Bq" << G4endl;
+    }
 
     G4cout << G4endl;    
 }
@@ -336,63 +352,13 @@ void LUXSimGeneratorDecayChain::CalculatePopulationsInEventList(G4double
 //                    GenerateEventList()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 void LUXSimGeneratorDecayChain::GenerateEventList( G4ThreeVector position,
-                G4int sourceByVolumeID, G4int sourcesID, G4String iso )
+                G4int sourceByVolumeID, G4int sourcesID, G4String )
 {
     //    The time that has past since the last decay from the starting
-    //    population depends on the current rate of the starting population,
-    //    which itself falls over time.
-    Isotope *currentIso = 0;
-    G4double chainTime_ns = 0;
-    G4double prob;
-    G4double tmpRates[19];//for both U and Th
-    G4int index;
-
-
-    if( iso.find("Th232")!=G4String::npos  ) {
-        originalRate = CalculateRatesTh232( populationTh, ratesTh );//for each event
-        for( G4int i=0; i<11; i++ )
-            tmpRates[i] = ratesTh[i]/originalRate;
-        for( G4int i=1; i<11; i++ )
-            tmpRates[i] += tmpRates[i-1];
-    } 
-    else if( iso.find("U238")!=G4String::npos  ) {
-        originalRate = CalculateRatesU238( populationU, ratesU );
-        for( G4int i=0; i<19; i++ )
-            tmpRates[i] = ratesU[i]/originalRate;
-        for( G4int i=1; i<19; i++ )
-            tmpRates[i] += tmpRates[i-1];
-    } 
-    else G4cout << "Parent Isotope not found\n";
-
-
-    //for each parent in population
+    //    population depends on the total rate of the chain, and the isotope
+    //    that decays is picked in proportion to its own rate.
     originalTime_s += -log(1.-G4UniformRand())/(originalRate) ;//seconds
-    
-    //    Select an isotope from the surviving original population based
-    //    on relative decay rates.
-    //for( G4int i=0; i<11; i++ )
-    //    tmpRates[i] = ratesTh[i]/originalRate;
-    //for( G4int i=1; i<11; i++ )
-    //    tmpRates[i] += tmpRates[i-1];
-
-    prob = G4UniformRand();
-    index = 0;
-    while( prob > tmpRates[index] )
-        index++;
-
-    if( iso.find("Th232")!=G4String::npos  ) {        
-        currentIso = isoArrayTh[index];
-        populationTh[index]--;
-        if( populationTh[index] < 0.5 )
-            populationTh[index] = 0;
-    } 
-    else if( iso.find("U238")!=G4String::npos  ) {
-        currentIso = isoArrayU[index];
-        populationU[index]--;
-        if( populationU[index] < 0.5 )
-            populationU[index] = 0;
-    } 
-    else G4cout << "Parent Isotope not found\n";
+    Isotope *currentIso = chainMembers[ memberDistribution.SampleIndex() ];
         
     //    The stocastically-determined next decay of the source must have its
     //    rate adjusted by source's halflife...as time goes on, decays of the
@@ -400,8 +366,8 @@ void LUXSimGeneratorDecayChain::GenerateEventList( G4ThreeVector position,
     //    for sources with long half lives compared to any descendant nucleus,
     //    but it can make a big difference for calibration sources such as
     //    Th228.
-    chainTime_ns = originalTime_s *1.e9*ns; //convert s->ns
-    luxManager->RecordTreeInsert( currentIso, originalTime_s*1.e9*ns, position, 
+    G4double chainTime_ns = originalTime_s *1.e9*ns; //convert s->ns
+    luxManager->RecordTreeInsert( currentIso, chainTime_ns, position, 
                 sourceByVolumeID, sourcesID );
         
     while( (currentIso = currentIso->GetNextDaughter()) ) {
@@ -414,6 +380,19 @@ void LUXSimGeneratorDecayChain::GenerateEventList( G4ThreeVector position,
     }
 }
 
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//                    ParseChain()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+LUXSimGeneratorDecayChain::decayChainType
+        LUXSimGeneratorDecayChain::ParseChain( G4String iso )
+{
+    if( iso.find("Th232")!=G4String::npos )
+        return thoriumChain;
+    if( iso.find("U238")!=G4String::npos )
+        return uraniumChain;
+    return unknownChain;
+}
+
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //                        GenerateFromEventList()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -433,15 +412,8 @@ void LUXSimGeneratorDecayChain::GenerateFromEventList( G4GeneralParticleSource
     particleGun->GetCurrentSource()->GetPosDist()->SetCentreCoords(pos);
     particleGun->GetCurrentSource()->SetParticleTime( time*ns );
 
-    std::stringstream uistring;
-    uistring.str("");
-    uistring << "/gps/ion " << zee << " " << ehh << " 0 0" ;
-    UI->ApplyCommand(uistring.str());
-    uistring.clear();
-    uistring.str("");
-    uistring << "/grdm/nucleusLimits " << ehh << " " << ehh << " " << 
-                                          zee << " " << zee ;
-    UI->ApplyCommand(uistring.str());
+    SetIon( particleGun, zee, ehh );
+    SetNucleusLimits( ehh, ehh, zee, zee );
 
     particleGun->GeneratePrimaryVertex(event);
     luxManager->AddPrimaryParticle( GetParticleInfo(particleGun) );
@@ -6,6 +6,10 @@
 ********************************************************************************
 * Change log
 *   12 May 14 - Initial submission, for gamma-X event generation. (Kevin)
+*   19 Oct 26 - Ions are set with SetIon() instead of /gps/ion
+*   19 Oct 26 - The deposits come from LUXSimEventsFileReader, which streams
+*               the file, and any particle in the particle table can be used.
+*               The binary format can also give a direction and a time.
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -14,19 +18,19 @@
 //      C++ includes
 //
 #include <vector>
+#include <map>
 
 //
 //	GEANT4 includes
 //
 #include "globals.hh"
-#include "G4GenericIon.hh"
-#include "G4Electron.hh"
-#include "G4Gamma.hh"
+#include "G4ParticleTable.hh"
 
 //
 //	LUXSim includes
 //
 #include "LUXSimGeneratorEventsFile.hh"
+#include "LUXSimEventsFileReader.hh"
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //					LUXSimGeneratorEventsFile()
@@ -35,15 +39,16 @@ LUXSimGeneratorEventsFile::LUXSimGeneratorEventsFile()
 {
 	name = "EventsFile";
 	activityMultiplier = 1;
-	ionDef = G4GenericIon::Definition();
-        electronDef = G4Electron::Definition();
-	gammaDef = G4Gamma::Definition();
+	eventIsotope = new Isotope( name, -1, -1, -1 );
 }
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //					~LUXSimGeneratorEventsFile()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
-LUXSimGeneratorEventsFile::~LUXSimGeneratorEventsFile() {}
+LUXSimGeneratorEventsFile::~LUXSimGeneratorEventsFile()
+{
+	delete eventIsotope;
+}
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //                    GenerateEventList()
@@ -51,10 +56,9 @@ LUXSimGeneratorEventsFile::~LUXSimGeneratorEventsFile() {}
 void LUXSimGeneratorEventsFile::GenerateEventList( G4ThreeVector position,
                 G4int sourceByVolumeID, G4int sourcesID, G4double time)
 {
-    G4int a=-1; G4int z=-1;
-    G4double hl=-1;
-    Isotope *currentIso = new Isotope(name, z, a, hl);
-    luxManager->RecordTreeInsert( currentIso, time, position, 
+    //  The tree only copies Z and A out of the isotope, so the same one can be
+    //  used for every event
+    luxManager->RecordTreeInsert( eventIsotope, time, position, 
                   sourceByVolumeID, sourcesID );
 }
 
@@ -64,28 +68,18 @@ void LUXSimGeneratorEventsFile::GenerateEventList( G4ThreeVector position,
 void LUXSimGeneratorEventsFile::GenerateFromEventList( G4GeneralParticleSource
        *particleGun, G4Event *event, decayNode *firstNode  )
 {
-
-    G4int particleID;
-    G4ThreeVector pos;
-    G4int numDeposits = luxManager->NextEventToGenerate();
-    char command[100];
+    LUXSimEventsFileReader *reader = luxManager->GetEventsFileReader();
+    G4int numDeposits = reader->ReadNextEvent();
     for(G4int i = 0; i < numDeposits; i++) {
-        pos = luxManager->NextPositionToGenerate();    
-        G4double timeDelay = (firstNode->timeOfEvent)/ns;//stored as seconds
-        timeDelay *= ns;
+        const eventsFileDeposit &deposit = reader->GetDeposit(i);
 
-        particleGun->GetCurrentSource()->SetParticleTime( timeDelay );
-    
-        particleGun->GetCurrentSource()->GetPosDist()->SetCentreCoords(pos);
-        particleID = luxManager->NextParticleIDToGenerate();
-        if(particleID == 11) {
-            particleGun->GetCurrentSource()->SetParticleDefinition( electronDef );
-        }
-        else if(particleID == 22) {
-            particleGun->GetCurrentSource()->SetParticleDefinition( gammaDef );
-        }
-        else if(particleID > 1e8) {
-            particleGun->GetCurrentSource()->SetParticleDefinition( ionDef );
+        particleGun->GetCurrentSource()->SetParticleTime(
+          firstNode->timeOfEvent + deposit.time );
+        particleGun->GetCurrentSource()->GetPosDist()->
+          SetCentreCoords( deposit.position );
+
+        G4int particleID = deposit.particleID;
+        if(particleID > 1e8) {
             particleID = particleID - 1000000000;
             G4int charge = particleID%10;
             particleID = particleID/10;
@@ -93,18 +87,49 @@ void LUXSimGeneratorEventsFile::GenerateFromEventList( G4GeneralParticleSource
             particleID = particleID/1000;
             G4int element = particleID;
             //Set the ion
-            sprintf(command, "/gps/ion  %d %d %d %d", element, isotope, charge, 0);
-
-           //Input the command string
-           UI->ApplyCommand(command);
+            SetIon( particleGun, element, isotope, charge );
         }
-        particleGun->GetCurrentSource()->GetAngDist()->
-          SetParticleMomentumDirection( GetRandomDirection() );
-        G4double monoEnergy = luxManager->NextEnergyDepToGenerate();
+        else {
+            particleGun->GetCurrentSource()->SetParticleDefinition(
+              FindParticleDefinition( particleID ) );
+        }
+
+        //  Deposits without a direction are emitted isotropically
+        if( deposit.direction.mag2() > 0 )
+            particleGun->GetCurrentSource()->GetAngDist()->
+              SetParticleMomentumDirection( deposit.direction );
+        else
+            particleGun->GetCurrentSource()->GetAngDist()->
+              SetParticleMomentumDirection( GetRandomDirection() );
         particleGun->GetCurrentSource()->GetEneDist()->
-          SetMonoEnergy( monoEnergy );
+          SetMonoEnergy( deposit.energy );
         particleGun->GeneratePrimaryVertex( event );
         luxManager->AddPrimaryParticle( GetParticleInfo(particleGun) ) ;
     }
 
 }
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//                    FindParticleDefinition()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4ParticleDefinition *LUXSimGeneratorEventsFile::FindParticleDefinition(
+        G4int particleID )
+{
+    std::map<G4int,G4ParticleDefinition*>::iterator it =
+            particleDefinitions.find( particleID );
+    if( it != particleDefinitions.end() )
+        return it->second;
+
+    G4ParticleDefinition *particleDef =
+            G4ParticleTable::GetParticleTable()->FindParticle( particleID );
+    if( !particleDef ) {
+        G4cout << G4endl << G4endl << G4endl;
+        G4cout << "Particle ID " << particleID << " in the events file is not "
+               << "a known particle" << G4endl;
+        G4cout << G4endl << G4endl << G4endl;
+        exit(0);
+    }
+    particleDefinitions[particleID] = particleDef;
+
+    return particleDef;
+}
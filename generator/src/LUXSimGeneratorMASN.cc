@@ -7,6 +7,8 @@
 * Change log
 *    15 June 2010 - Initial submission (Melinda)
 *    14-Jul-2012 - GenerateEventList methods for binary search tree. (Nick)
+*    19-Oct-2026 - The CDFs are built with a running sum and sampled through
+*                  LUXSimTabulatedDistribution
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -53,7 +55,7 @@ LUXSimGeneratorMASN::LUXSimGeneratorMASN()
     G4double lambda_1 = 0.45;                   //km.w.e
     G4double lambda_2 = 0.87;                   //km.w.e
 
-    G4double muonAnglePDF[1001];
+    G4double muonAngle[1001], muonAnglePDF[1001], muonAngleCDF[1001];
     G4double muonAngleArea = 0.;
     for(int i=0; i<1001; i++){
         G4double sectheta = 1./cos(pi/2*i/1000);
@@ -64,17 +66,19 @@ LUXSimGeneratorMASN::LUXSimGeneratorMASN()
     }
     for(int i=0; i<1001; i++) {
         muonAnglePDF[i]/=muonAngleArea;
-        muonAngleCDF[i]=0.;
-        for(int j=0; j<i; j++) muonAngleCDF[i]+=muonAnglePDF[j];
+        muonAngleCDF[i] = (i>0) ?
+                muonAngleCDF[i-1] + muonAnglePDF[i-1] : 0.;
     }
 
+    muonAngleDistribution.SetCDF( 1001, muonAngle, muonAngleCDF );
+
     //    Get the muon energy:
     G4double h = h_0*1./cos(GetMuonAngle());    //km.w.e
     G4double b = 0.4;                           //km.w.e^{-1}
     G4double gamma_mu = 3.77;
     G4double epsilon_mu = 693.;                 //GeV
 
-    G4double muonEnergyPDF[1001];
+    G4double muonEnergy[1001], muonEnergyPDF[1001], muonEnergyCDF[1001];
     G4double muonEnergyArea=0.;
     for(int i=0; i<1001; i++){
         muonEnergy[i] = 4.*i;
@@ -84,12 +88,14 @@ LUXSimGeneratorMASN::LUXSimGeneratorMASN()
     }
     for(int i=0; i<1001; i++){
         muonEnergyPDF[i]/=muonEnergyArea;
-        muonEnergyCDF[i]=0.;
-        for(int j=0; j<i; j++) muonEnergyCDF[i]+=muonEnergyPDF[j];
+        muonEnergyCDF[i] = (i>0) ?
+                muonEnergyCDF[i-1] + muonEnergyPDF[i-1] : 0.;
     }
     muonEnergyCDF[1000] = 1.;                   //force the CDF to go 
                                                 //to one rather than 0.9999
     
+    muonEnergySpectrum.SetCDF( 1001, muonEnergy, muonEnergyCDF );
+
     //    Get the neutron energy:
     G4double a_0 = 7.333;
     G4double a_1 = 2.105;
@@ -98,7 +104,8 @@ LUXSimGeneratorMASN::LUXSimGeneratorMASN()
     G4double tempMuonEnergy = GetMuonEnergy();
     G4double B = 0.324 - 0.641*exp(-0.014*tempMuonEnergy);
     
-    G4double neutronEnergyPDF[1001];
+    G4double neutronEnergy[1001], neutronEnergyPDF[1001];
+    G4double neutronEnergyCDF[1001];
     G4double neutronEnergyArea=0.;
     for(int i=0; i<1001; i++){
         neutronEnergy[i] = (i+2.5)/250;
@@ -108,10 +115,12 @@ LUXSimGeneratorMASN::LUXSimGeneratorMASN()
     }
     for(int i=0; i<1001; i++){ 
         neutronEnergyPDF[i]/=neutronEnergyArea;
-        neutronEnergyCDF[i]=0.;
-        for(int j=0; j<i; j++) neutronEnergyCDF[i]+=neutronEnergyPDF[j];
+        neutronEnergyCDF[i] = (i>0) ?
+                neutronEnergyCDF[i-1] + neutronEnergyPDF[i-1] : 0.;
     }
 
+    neutronEnergySpectrum.SetCDF( 1001, neutronEnergy, neutronEnergyCDF );
+
     //    Get the neutron multiplicity:
     //    generic parameters:
     tempMuonEnergy = GetMuonEnergy();
@@ -119,7 +128,7 @@ LUXSimGeneratorMASN::LUXSimGeneratorMASN()
     G4double C_M = 318.1*exp(-0.01421*tempMuonEnergy);
     G4double D_M = 2.02*exp(-0.006959*tempMuonEnergy);
 
-    G4double neutronMultPDF[1001];
+    G4double neutronMult[1001], neutronMultPDF[1001], neutronMultCDF[1001];
     G4double neutronMultArea=0.;
     for(int i=0; i<1001; i++){
         neutronMult[i] = (i+5.)/5.;
@@ -129,17 +138,19 @@ LUXSimGeneratorMASN::LUXSimGeneratorMASN()
     }
     for(int i=0; i<1001; i++){
         neutronMultPDF[i]/=neutronMultArea;
-        neutronMultCDF[i]=0.;
-        for(int j=0; j<i; j++) neutronMultCDF[i]+=neutronMultPDF[j];
+        neutronMultCDF[i] = (i>0) ?
+                neutronMultCDF[i-1] + neutronMultPDF[i-1] : 0.;
     }
 
+    neutronMultDistribution.SetCDF( 1001, neutronMult, neutronMultCDF );
+
     //    Get the neutron angle:
     //    generic parameters:
     tempMuonEnergy = GetMuonEnergy();
     G4double B_theta = 0.482*pow(tempMuonEnergy,0.045);
     G4double C_theta = 0.832*pow(tempMuonEnergy,-0.152);
 
-    G4double neutronAnglePDF[1001];
+    G4double neutronAngle[1001], neutronAnglePDF[1001], neutronAngleCDF[1001];
     G4double neutronAngleArea=0.;
     for(int i=0; i<1001; i++){
         neutronAngle[i] = pi*i/1000.;
@@ -148,11 +159,13 @@ LUXSimGeneratorMASN::LUXSimGeneratorMASN()
     }
     for(int i=0; i<1001; i++){
         neutronAnglePDF[i]/=neutronAngleArea;
-        neutronAngleCDF[i]=0.;
-        for(int j=0; j<i; j++) neutronAngleCDF[i]+=neutronAnglePDF[j];
+        neutronAngleCDF[i] = (i>0) ?
+                neutronAngleCDF[i-1] + neutronAnglePDF[i-1] : 0.;
     }
     neutronAngleCDF[1000]=1.;
 
+    neutronAngleDistribution.SetCDF( 1001, neutronAngle, neutronAngleCDF );
+
     //neutronDef = G4Geantino::Definition();
     neutronDef = G4Neutron::Definition();
     //muonDef = G4Geantino::Definition();
@@ -234,109 +247,33 @@ void LUXSimGeneratorMASN::GenerateFromEventList( G4GeneralParticleSource
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 G4double LUXSimGeneratorMASN::GetMuonAngle()
 {
-    G4double prob = G4UniformRand();
-    G4int indexLo = 0, indexHi = 1000;
-
-    while(!(muonAngleCDF[indexLo+1] > prob && 
-            muonAngleCDF[indexHi-1] < prob) ) {
-        if(muonAngleCDF[(indexLo+indexHi)/2] < prob )
-            indexLo = (indexLo + indexHi)/2;
-        else
-            indexHi = (indexLo + indexHi)/2;
-    }
-    G4double split = (prob - muonAngleCDF[indexLo]) /
-            (muonAngleCDF[indexHi] - muonAngleCDF[indexLo]);
-    G4double angle = muonAngle[indexLo] + 
-            split*(muonAngle[indexHi] - muonAngle[indexLo]);
-
-    return (angle);
+    return (muonAngleDistribution.Sample());
 }
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //                  GetMuonEnergy()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 G4double LUXSimGeneratorMASN::GetMuonEnergy()
 {
-    G4double prob = G4UniformRand();
-    G4int indexLo = 0, indexHi = 1000;
-
-    while(!(muonEnergyCDF[indexLo+1] > prob && 
-            muonEnergyCDF[indexHi-1] < prob) ) {
-        if(muonEnergyCDF[(indexLo+indexHi)/2] < prob )
-            indexLo = (indexLo + indexHi)/2;
-        else
-            indexHi = (indexLo + indexHi)/2;
-    }
-    G4double split = (prob - muonEnergyCDF[indexLo]) /
-            (muonEnergyCDF[indexHi] - muonEnergyCDF[indexLo]);
-    G4double energy = muonEnergy[indexLo] + 
-            split*(muonEnergy[indexHi] - muonEnergy[indexLo]);
-
-
-    return (energy);
+    return (muonEnergySpectrum.Sample());
 }
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //                  GetNeutonAngle()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 G4double LUXSimGeneratorMASN::GetNeutronAngle()
 {
-    G4double prob = G4UniformRand();
-    G4int indexLo = 0, indexHi = 1000;
-
-    while(!(neutronAngleCDF[indexLo+1] > prob && 
-            neutronAngleCDF[indexHi-1] < prob) ) {
-        if(neutronAngleCDF[(indexLo+indexHi)/2] < prob )
-            indexLo = (indexLo + indexHi)/2;
-        else
-            indexHi = (indexLo + indexHi)/2;
-    }
-    G4double split = (prob - neutronAngleCDF[indexLo]) /
-            (neutronAngleCDF[indexHi] - neutronAngleCDF[indexLo]);
-    G4double angle = neutronAngle[indexLo] + 
-            split*(neutronAngle[indexHi] - neutronAngle[indexLo]);
-
-    return (angle);
+    return (neutronAngleDistribution.Sample());
 }
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //                  GetNeutronEnergy()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 G4double LUXSimGeneratorMASN::GetNeutronEnergy()
 {
-    G4double prob = G4UniformRand();
-    G4int indexLo = 0, indexHi = 1000;
-
-    while(!(neutronEnergyCDF[indexLo+1] > prob && 
-            neutronEnergyCDF[indexHi-1] < prob) ) {
-        if(neutronEnergyCDF[(indexLo+indexHi)/2] < prob )
-            indexLo = (indexLo + indexHi)/2;
-        else
-            indexHi = (indexLo + indexHi)/2;
-    }
-    G4double split = (prob - neutronEnergyCDF[indexLo]) /
-            (neutronEnergyCDF[indexHi] - neutronEnergyCDF[indexLo]);
-    G4double energy = neutronEnergy[indexLo] + 
-            split*(neutronEnergy[indexHi] - neutronEnergy[indexLo]);
-
-    return (energy);
+    return (neutronEnergySpectrum.Sample());
 }
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //                  GetNeutronMultiplicity()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 G4double LUXSimGeneratorMASN::GetNeutronMultiplicity()
 {
-    G4double prob = G4UniformRand();
-    G4int indexLo = 0, indexHi = 1000;
-
-    while(!(neutronMultCDF[indexLo+1] > prob && 
-            neutronMultCDF[indexHi-1] < prob) ) {
-        if(neutronMultCDF[(indexLo+indexHi)/2] < prob )
-            indexLo = (indexLo + indexHi)/2;
-        else
-            indexHi = (indexLo + indexHi)/2;
-    }
-    G4double split = (prob - neutronMultCDF[indexLo]) /
-            (neutronMultCDF[indexHi] - neutronMultCDF[indexLo]);
-    G4double energy = neutronMult[indexLo] + 
-            split*(neutronMult[indexHi] - neutronMult[indexLo]);
-
-    return (energy);
+    return (neutronMultDistribution.Sample());
 }
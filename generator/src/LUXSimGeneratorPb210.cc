@@ -6,6 +6,8 @@
 ********************************************************************************
 * Change log
 *   07-Nov-2012 - Adapted from LUXSimGeneratorU238.cc. (Dave)
+*   19-Oct-2026 - Ions and nucleus limits are set with SetIon() and
+*                 SetNucleusLimits() instead of UI commands
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -67,18 +69,18 @@ void LUXSimGeneratorPb210::GenerateFromEventList( G4GeneralParticleSource
     probability = G4UniformRand();
     
     if( probability < 1./3. ) {
-        UI->ApplyCommand( "/gps/ion 82 210 0 0" );
-        UI->ApplyCommand( "/grdm/nucleusLimits 210 210 82 82" );
+        SetIon( particleGun, 82, 210 );
+        SetNucleusLimits( 210, 210, 82, 82 );
     } else if( probability < 2./3. ) {
-        UI->ApplyCommand( "/grdm/nucleusLimits 210 210 83 83" );
-        UI->ApplyCommand( "/gps/ion 83 210 0 0" );
+        SetNucleusLimits( 210, 210, 83, 83 );
+        SetIon( particleGun, 83, 210 );
     } else {
         if( G4UniformRand() < .9999987) {
-            UI->ApplyCommand( "/grdm/nucleusLimits 210 210 84 84" );
-            UI->ApplyCommand( "/gps/ion 84 210 0 0" );
+            SetNucleusLimits( 210, 210, 84, 84 );
+            SetIon( particleGun, 84, 210 );
         } else {
-            UI->ApplyCommand( "/grdm/nucleusLimits 206 206 81 81" );
-            UI->ApplyCommand( "/gps/ion 81 206 0 0" );
+            SetNucleusLimits( 206, 206, 81, 81 );
+            SetIon( particleGun, 81, 206 );
         }
     }
 
@@ -8,6 +8,8 @@
 *	26-June-2009 - file creation (Nick)
 *   30-Apr-2010 - Added primaryParticle recording (Nick)
 *   14-Jul-2012 - GenerateEventList methods of binary search tree (Nick)
+*   19-Oct-2026 - Ions and nucleus limits are set with SetIon() and
+*                 SetNucleusLimits() instead of UI commands
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -75,28 +77,28 @@ void LUXSimGeneratorRn222::GenerateFromEventList( G4GeneralParticleSource
     probability = G4UniformRand();
   	//radon222
   	if( probability < 1./5. ) {
-  		UI->ApplyCommand( "/gps/ion 86 222 0 0" );
-  		UI->ApplyCommand( "/grdm/nucleusLimits 222 222 86 86" );
+  		SetIon( particleGun, 86, 222 );
+  		SetNucleusLimits( 222, 222, 86, 86 );
   	}
   	//polonium21
   	else if( probability < 2./5. ) {
-  		UI->ApplyCommand( "/gps/ion 84 218 0 0" );
-  		UI->ApplyCommand( "/grdm/nucleusLimits 218 218 84 84" );
+  		SetIon( particleGun, 84, 218 );
+  		SetNucleusLimits( 218, 218, 84, 84 );
   	}
   	//lead214
   	else if( probability < 3./5. ) {
-  		UI->ApplyCommand( "/gps/ion 82 214 0 0" );
-  		UI->ApplyCommand( "/grdm/nucleusLimits 214 214 82 82" );
+  		SetIon( particleGun, 82, 214 );
+  		SetNucleusLimits( 214, 214, 82, 82 );
   	} 
   	//bimuth214
   	else if( probability < 4./5. ) {
-  		UI->ApplyCommand( "/gps/ion 83 214 0 0" );
-  		UI->ApplyCommand( "/grdm/nucleusLimits 214 214 83 83" );
+  		SetIon( particleGun, 83, 214 );
+  		SetNucleusLimits( 214, 214, 83, 83 );
   	} 		
   	//polonium214
   	else{
-  			UI->ApplyCommand( "/grdm/nucleusLimits 214 214 84 84" );
-  			UI->ApplyCommand( "/gps/ion 84 214 0 0" );
+  			SetNucleusLimits( 214, 214, 84, 84 );
+  			SetIon( particleGun, 84, 214 );
   	}
   	//ends at decay Po decay to Lead-210
 
@@ -7,6 +7,9 @@
 * Change log
 *   19 Aug 2011 - Initial submission for Scintillation Photons. (Nick)
 *   14-Jul-2012 - GenerateEventList methods of binary search tree (Nick)
+*   19-Oct-2026 - Photons are added to the event directly instead of through
+*                 the GPS, with the directions, polarizations and energies
+*                 drawn in batches. One isotope is used for the whole list.
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -30,12 +33,24 @@ LUXSimGeneratorScintPhotons::LUXSimGeneratorScintPhotons()
 	name = "ScintPhotons";
 	activityMultiplier = 1;
     photon = G4OpticalPhoton::OpticalPhotonDefinition();
+
+    G4int z=1; G4int a=1; G4double hl=1;
+    eventIsotope = new Isotope(name, z, a, hl);
+
+    batchSize = 4096;
+    batchPosition = batchSize;
+    batchDirections.resize( batchSize );
+    batchPolarizations.resize( batchSize );
+    batchEnergies.resize( batchSize );
 }
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //					~LUXSimGeneratorScintPhotons()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
-LUXSimGeneratorScintPhotons::~LUXSimGeneratorScintPhotons() {}
+LUXSimGeneratorScintPhotons::~LUXSimGeneratorScintPhotons()
+{
+    delete eventIsotope;
+}
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //					GenerateEventList()
@@ -43,48 +58,53 @@ LUXSimGeneratorScintPhotons::~LUXSimGeneratorScintPhotons() {}
 void LUXSimGeneratorScintPhotons::GenerateEventList( G4ThreeVector position,
                 G4int sourceByVolumeID, G4int sourcesID, G4double time)
 {
-    G4int z=1; G4int a=1; G4double hl=1;
-  	Isotope *currentIso = new Isotope(name, z, a, hl);//
-  	luxManager->RecordTreeInsert( currentIso, time, position, 
+  	luxManager->RecordTreeInsert( eventIsotope, time, position, 
                   sourceByVolumeID, sourcesID );
 }
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //					GenerateFromEventList()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
+//	The position and time come from the record tree, and everything else about
+//	the photon from the current batch, so the GPS isn't used at all.
 void LUXSimGeneratorScintPhotons::GenerateFromEventList(G4GeneralParticleSource 
-      *particleGun,	G4Event *event, decayNode *firstNode )
+      *, G4Event *event, decayNode *firstNode )
+{
+    if( batchPosition == batchSize )
+        FillBatch();
+
+    GeneratePrimary( event, photon, firstNode->pos,
+            batchDirections[batchPosition], batchEnergies[batchPosition],
+            firstNode->timeOfEvent, batchPolarizations[batchPosition] );
+    batchPosition++;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					FillBatch()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimGeneratorScintPhotons::FillBatch()
 {
-	particleGun->GetCurrentSource()->SetParticleDefinition( photon );
-    G4ThreeVector pos = G4ThreeVector(firstNode->pos);
-    particleGun->GetCurrentSource()->GetPosDist()->SetCentreCoords(pos);
+    for( G4int i=0; i<batchSize; i++ ) {
+        //determine momentum direction
+        direction = GetRandomDirection();
+        theta = direction.theta();
+        phi = direction.phi();
+        //determine polarization (same as G4Scintillation.cc)
+        xpol = std::cos( theta) * std::cos( phi );
+        ypol = std::cos( theta) * std::sin( phi );
+        zpol = -sin ( theta );
+        polarization = G4ThreeVector( xpol, ypol, zpol );
+        perp = direction.cross(polarization);
+        phi = twopi*G4UniformRand();
+        sinp = std::sin(phi);
+        cosp = std::cos(phi);
+        polarization = cosp*polarization + sinp*perp;
 
-    G4double time = (firstNode->timeOfEvent)/ns;
-    particleGun->GetCurrentSource()->SetParticleTime( time*ns );
-    
-    //determine momentum direction
-    direction = GetRandomDirection();
-    theta = direction.theta();
-    phi = direction.phi();
-    //determine polarization (same as G4Scintillation.cc)
-    xpol = std::cos( theta) * std::cos( phi );
-    ypol = std::cos( theta) * std::sin( phi );
-    zpol = -sin ( theta );
-    polarization = G4ThreeVector( xpol, ypol, zpol );
-    perp = direction.cross(polarization);
-    phi = twopi*G4UniformRand();
-    sinp = std::sin(phi);
-    cosp = std::cos(phi);
-    polarization = cosp*polarization + sinp*perp;
-    polarization = polarization.unit();
+        batchDirections[i] = direction;
+        batchPolarizations[i] = polarization.unit();
+        //same spectrum as the GPS "Gauss" energy distribution used before
+        batchEnergies[i] = G4RandGauss::shoot( 6.97*eV, 0.23*eV );
+    }
 
-    particleGun->GetCurrentSource()->GetAngDist()->SetParticleMomentumDirection(
-        direction );
-    particleGun->GetCurrentSource()->SetParticlePolarization( polarization );
-        particleGun->GetCurrentSource()->GetEneDist()->SetEnergyDisType("Gauss");
-	particleGun->GetCurrentSource()->GetEneDist()->SetMonoEnergy( 6.97*eV );
-	particleGun->GetCurrentSource()->GetEneDist()->SetBeamSigmaInE (0.23*eV);
-	
-   	particleGun->GeneratePrimaryVertex( event );
-    luxManager->AddPrimaryParticle( GetParticleInfo(particleGun) ) ;
+    batchPosition = 0;
 }
@@ -11,6 +11,8 @@
 *				stdout for every event (Kareem)
 *   30-Apr-2010 - Added primaryParticle recording (Nick)
 *   14-Jul-2012 - GenerateEventList methods of binary search tree (Nick)
+*   19-Oct-2026 - Ions and nucleus limits are set with SetIon() and
+*                 SetNucleusLimits() instead of UI commands
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -89,18 +91,8 @@ void LUXSimGeneratorSingleDecay::GenerateFromEventList( G4GeneralParticleSource
     //    isoproperty->GetLifeTime();
     //G4double G4RIsotopeTable::GetMeanLifeTime(G4int Z, G4int A, G4double& aE)
    
-    std::stringstream uiStream ;
-    uiStream.str("") ;
-    uiStream << "/gps/ion " << nucleusZ << " " << nucleusA << " 0 0" ;
-    uiString = uiStream.str() ;
-	UI->ApplyCommand( uiString );
-    
-    uiStream.clear() ;  //removes error cache
-    uiStream.str("") ;
-    uiStream << "/grdm/nucleusLimits " << nucleusA << " " << nucleusA << " " << 
-        nucleusZ << " " << nucleusZ ;
-    uiString = uiStream.str() ;
-	UI->ApplyCommand( uiString ) ;
+	SetIon( particleGun, nucleusZ, nucleusA );
+	SetNucleusLimits( nucleusA, nucleusA, nucleusZ, nucleusZ );
     
 	particleGun->GetCurrentSource()->GetAngDist()->SetParticleMomentumDirection(
 			GetRandomDirection() );
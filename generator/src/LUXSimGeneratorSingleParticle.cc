@@ -7,6 +7,10 @@
 * Change log
 *   02-Mar-12 - Initial submission for Single Particles. (Nick)
 *   14-Jul-2012 - GenerateEventList methods of binary search tree (Nick)
+*   19-Oct-2026 - The particle is added to the event directly instead of
+*                 through the GPS. The particle definition is only looked up
+*                 when the particle name changes, and the isotopes put in the
+*                 list are reused.
 */
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -41,7 +45,12 @@ LUXSimGeneratorSingleParticle::LUXSimGeneratorSingleParticle()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //					~LUXSimGeneratorSingleParticle()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
-LUXSimGeneratorSingleParticle::~LUXSimGeneratorSingleParticle() {;}
+LUXSimGeneratorSingleParticle::~LUXSimGeneratorSingleParticle()
+{
+    std::map< std::pair<G4String,G4double>, Isotope* >::iterator it;
+    for( it = eventIsotopes.begin(); it != eventIsotopes.end(); it++ )
+        delete it->second;
+}
 
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -51,9 +60,17 @@ void LUXSimGeneratorSingleParticle::GenerateEventList( G4ThreeVector position,
                 G4int sourceByVolumeID, G4int sourcesID, G4String pname, 
                 G4double energy, G4double time)
 {
-
-    G4int z=-1; G4int a=-1;
-  	Isotope *currentIso = new Isotope(name, z, a, pname, energy);
+    std::pair<G4String,G4double> key( pname, energy );
+    std::map< std::pair<G4String,G4double>, Isotope* >::iterator it =
+            eventIsotopes.find( key );
+    Isotope *currentIso;
+    if( it != eventIsotopes.end() )
+        currentIso = it->second;
+    else {
+        G4int z=-1; G4int a=-1;
+        currentIso = new Isotope(name, z, a, pname, energy);
+        eventIsotopes[key] = currentIso;
+    }
   	luxManager->RecordTreeInsert( currentIso, time, position, 
                   sourceByVolumeID, sourcesID );	
 }
@@ -62,30 +79,21 @@ void LUXSimGeneratorSingleParticle::GenerateEventList( G4ThreeVector position,
 //					GenerateFromEventList()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 void LUXSimGeneratorSingleParticle::GenerateFromEventList( 
-    G4GeneralParticleSource *particleGun, G4Event *event, decayNode *firstNode )
+    G4GeneralParticleSource *, G4Event *event, decayNode *firstNode )
 {
-
-    G4String particlestring = firstNode->particleName; //name=SingleParticle
-    G4ParticleTable *pTable = G4ParticleTable::GetParticleTable();
-    particlename = pTable->FindParticle( particlestring ) ;
-    if(particlename){
-        particleGun->GetCurrentSource()->SetParticleDefinition( particlename );
+    if( !particlename || firstNode->particleName != lastParticleString ) {
+        lastParticleString = firstNode->particleName; //name=SingleParticle
+        G4ParticleTable *pTable = G4ParticleTable::GetParticleTable();
+        particlename = pTable->FindParticle( lastParticleString ) ;
+        if( !particlename ) {
+            G4cout << G4endl << G4endl << G4endl;
+            G4cout << "Particle " << lastParticleString << " is not a known "
+                   << "particle" << G4endl;
+            G4cout << G4endl << G4endl << G4endl;
+            exit(0);
+        }
     }
 
-    G4double time = (firstNode->timeOfEvent)/ns;//time in ns
-    particleGun->GetCurrentSource()->SetParticleTime( time*ns );
-
-    G4ThreeVector pos = G4ThreeVector(firstNode->pos );
-    particleGun->GetCurrentSource()->GetPosDist()->SetCentreCoords(pos);
-
-  	particleGun->GetCurrentSource()->GetAngDist()->SetParticleMomentumDirection(
-			GetRandomDirection() );
-
-    G4double energy = firstNode->energy;
-	particleGun->GetCurrentSource()->GetEneDist()->SetMonoEnergy( energy );
-
-   	particleGun->GeneratePrimaryVertex( event );
-    luxManager->AddPrimaryParticle( GetParticleInfo(particleGun) ) ;
-
+    GeneratePrimary( event, particlename, firstNode->pos,
+            GetRandomDirection(), firstNode->energy, firstNode->timeOfEvent );
 }
-
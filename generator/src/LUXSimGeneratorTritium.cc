@@ -11,6 +11,8 @@
 ********************************************************************************
 * Change log
 *    23-Jul-2013 - Initial submission (Kareem)
+*    19-Oct-2026 - The spectrum is tabulated once and sampled by inverting its
+*                  CDF instead of by rejection
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -43,8 +45,21 @@ LUXSimGeneratorTritium::LUXSimGeneratorTritium()
 	Z = 2.;
 	
 	xmax = Q;
-	ymax = 1.1e7;
 	electronDef = G4Electron::Definition();
+	
+	//	Tabulate the spectrum in 1 eV steps
+	G4int numPoints = (G4int)(xmax*1000) + 2;
+	G4double *electronEnergy, *electronPDF;
+	electronEnergy = new G4double[numPoints];
+	electronPDF = new G4double[numPoints];
+	for( G4int i=0; i<numPoints; i++ ) {
+		electronEnergy[i] = xmax*i/(numPoints-1);
+		electronPDF[i] = GetBetaSpectrum( electronEnergy[i] );
+	}
+	electronEnergySpectrum.SetPDF( numPoints, electronEnergy, electronPDF );
+	
+	delete [] electronEnergy;
+	delete [] electronPDF;
 }
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -98,19 +113,26 @@ void LUXSimGeneratorTritium::GenerateFromEventList( G4GeneralParticleSource
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 G4double LUXSimGeneratorTritium::GetElectronEnergy()
 {
-	G4double xTry = xmax*G4UniformRand();
-	G4double yTry = ymax*G4UniformRand();
-        G4double B = sqrt(xTry*xTry + 2*xTry*m_e) / (xTry + m_e);
-        G4double x = (2*pi*Z*a)*(xTry + m_e)/sqrt(xTry*xTry + 2*xTry*m_e);
+	return( electronEnergySpectrum.Sample() );
+}
 
-	while( yTry > (sqrt(2*xTry*m_e) *
-                      (xTry + m_e) *
-		      (Q-xTry) * (Q-xTry) *
-                      x*(1./(1-exp(-x)))*(1.002037-0.001427*(B))) ){
-		xTry = xmax*G4UniformRand();
-		yTry = ymax*G4UniformRand();
-                B = sqrt(xTry*xTry + 2*xTry*m_e) / (xTry + m_e);
-                x = (2*pi*Z*a)*(xTry + m_e)/sqrt(xTry*xTry + 2*xTry*m_e);
-	}
-	return( xTry );
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//               GetBetaSpectrum()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4double LUXSimGeneratorTritium::GetBetaSpectrum( G4double energy )
+{
+	//	The Fermi function diverges at zero energy while the phase space goes
+	//	to zero, but their product is finite, so evaluate just above zero.
+	if( energy < 1.e-9 )
+		energy = 1.e-9;
+	if( energy >= Q )
+		return 0.;
+
+	G4double B = sqrt(energy*energy + 2*energy*m_e) / (energy + m_e);
+	G4double x = (2*pi*Z*a)*(energy + m_e)/sqrt(energy*energy + 2*energy*m_e);
+
+	return( sqrt(2*energy*m_e) *
+			(energy + m_e) *
+			(Q-energy) * (Q-energy) *
+			x*(1./(1-exp(-x)))*(1.002037-0.001427*(B)) );
 }
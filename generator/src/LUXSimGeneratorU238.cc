@@ -8,6 +8,8 @@
 *    26-June-2009 - file creation (Nick)
 *   30-Apr-2010 - Added primaryParticle recording (Nick)
 *   14-Jul-2012 - GenerateEventList methods of binary search tree (Nick)
+*   19-Oct-2026 - Ions and nucleus limits are set with SetIon() and
+*                 SetNucleusLimits() instead of UI commands
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -69,56 +71,56 @@ void LUXSimGeneratorU238::GenerateFromEventList( G4GeneralParticleSource
     probability = G4UniformRand();
     
     if( probability < 1./14. ) {
-        UI->ApplyCommand( "/gps/ion 92 238 0 0" );
-        UI->ApplyCommand( "/grdm/nucleusLimits 238 238 92 92" );
+        SetIon( particleGun, 92, 238 );
+        SetNucleusLimits( 238, 238, 92, 92 );
     } else if( probability < 2./14. ) {
-        UI->ApplyCommand( "/gps/ion 90 234 0 0" );
-        UI->ApplyCommand( "/grdm/nucleusLimits 234 234 90 90" );
+        SetIon( particleGun, 90, 234 );
+        SetNucleusLimits( 234, 234, 90, 90 );
     } else if( probability < 3./14. ) {
-        UI->ApplyCommand( "/gps/ion 91 234 0 0" );
-        UI->ApplyCommand( "/grdm/nucleusLimits 234 234 91 91" );
+        SetIon( particleGun, 91, 234 );
+        SetNucleusLimits( 234, 234, 91, 91 );
     } else if( probability < 4./14. ) {
-        UI->ApplyCommand( "/gps/ion 92 234 0 0" );
-        UI->ApplyCommand( "/grdm/nucleusLimits 234 234 92 92" );
+        SetIon( particleGun, 92, 234 );
+        SetNucleusLimits( 234, 234, 92, 92 );
     } else if( probability < 5./14. ) {
-        UI->ApplyCommand( "/gps/ion 90 230 0 0" );
-        UI->ApplyCommand( "/grdm/nucleusLimits 230 230 90 90" );
+        SetIon( particleGun, 90, 230 );
+        SetNucleusLimits( 230, 230, 90, 90 );
     } else if( probability < 6./14. ) {
-        UI->ApplyCommand( "/gps/ion 88 226 0 0" );
-        UI->ApplyCommand( "/grdm/nucleusLimits 226 226 88 88" );
+        SetIon( particleGun, 88, 226 );
+        SetNucleusLimits( 226, 226, 88, 88 );
     } else if( probability < 7./14. ) {
-        UI->ApplyCommand( "/gps/ion 86 222 0 0" );
-        UI->ApplyCommand( "/grdm/nucleusLimits 222 222 86 86" );
+        SetIon( particleGun, 86, 222 );
+        SetNucleusLimits( 222, 222, 86, 86 );
     } else if( probability < 8./14. ) {
-        UI->ApplyCommand( "/gps/ion 84 218 0 0" );
-        UI->ApplyCommand( "/grdm/nucleusLimits 218 218 84 84" );
+        SetIon( particleGun, 84, 218 );
+        SetNucleusLimits( 218, 218, 84, 84 );
     } else if( probability < 9./14. ) {
-        UI->ApplyCommand( "/gps/ion 82 214 0 0" );
-        UI->ApplyCommand( "/grdm/nucleusLimits 214 214 82 82" );
+        SetIon( particleGun, 82, 214 );
+        SetNucleusLimits( 214, 214, 82, 82 );
     } else if( probability < 10./14. ) {
-        UI->ApplyCommand( "/gps/ion 83 214 0 0" );
-        UI->ApplyCommand( "/grdm/nucleusLimits 214 214 83 83" );
+        SetIon( particleGun, 83, 214 );
+        SetNucleusLimits( 214, 214, 83, 83 );
     } else if( probability < 11./14. ) {
         if( G4UniformRand() < .99979) {
-            UI->ApplyCommand( "/grdm/nucleusLimits 214 214 84 84" );
-            UI->ApplyCommand( "/gps/ion 84 214 0 0" );
+            SetNucleusLimits( 214, 214, 84, 84 );
+            SetIon( particleGun, 84, 214 );
         } else {
-            UI->ApplyCommand( "/grdm/nucleusLimits 210 210 81 81" );
-            UI->ApplyCommand( "/gps/ion 81 210 0 0" );
+            SetNucleusLimits( 210, 210, 81, 81 );
+            SetIon( particleGun, 81, 210 );
         }
     } else if( probability < 12./14. ) {
-        UI->ApplyCommand( "/gps/ion 82 210 0 0" );
-        UI->ApplyCommand( "/grdm/nucleusLimits 210 210 82 82" );
+        SetIon( particleGun, 82, 210 );
+        SetNucleusLimits( 210, 210, 82, 82 );
     } else if( probability < 13./14. ) {
-        UI->ApplyCommand( "/grdm/nucleusLimits 210 210 83 83" );
-        UI->ApplyCommand( "/gps/ion 83 210 0 0" );
+        SetNucleusLimits( 210, 210, 83, 83 );
+        SetIon( particleGun, 83, 210 );
     } else {
         if( G4UniformRand() < .9999987) {
-            UI->ApplyCommand( "/grdm/nucleusLimits 210 210 84 84" );
-            UI->ApplyCommand( "/gps/ion 84 210 0 0" );
+            SetNucleusLimits( 210, 210, 84, 84 );
+            SetIon( particleGun, 84, 210 );
         } else {
-            UI->ApplyCommand( "/grdm/nucleusLimits 206 206 81 81" );
-            UI->ApplyCommand( "/gps/ion 81 206 0 0" );
+            SetNucleusLimits( 206, 206, 81, 81 );
+            SetIon( particleGun, 81, 206 );
         }
     }
 
@@ -9,6 +9,11 @@
 *   14-Jul-2012 - Modified to account for earth and galactic
 * 				    escape velocities (Daniel)
 *   14-Jul-2012 - GenerateEventList methods of binary search tree (Nick)
+*   19-Oct-2026 - The recoil spectrum is no longer rebuilt for every event.
+*                 It is built once per WIMP mass and target isotope in
+*                 GetRecoilSpectrum, and SampleRecoilEnergy draws from it using
+*                 a guide table. The spectra are dropped on /LUXSim/source/reset
+*   19-Oct-2026 - The ion is set with SetIon() instead of /gps/ion
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -175,6 +180,90 @@ G4double LUXSimGeneratorWimp::dR(G4double ER, G4double mWimp, G4double mXenon){
   return dR;
 }
 
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					GetRecoilSpectrum()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+LUXSimGeneratorWimp::recoilSpectrum *LUXSimGeneratorWimp::GetRecoilSpectrum(
+        G4double wimpMass, G4double mXenon )
+{
+    for( G4int i=0; i<(G4int)recoilSpectra.size(); i++ )
+        if( recoilSpectra[i].wimpMass == wimpMass &&
+                recoilSpectra[i].targetMass == mXenon )
+            return &recoilSpectra[i];
+
+    recoilSpectrum spectrum;
+    spectrum.wimpMass = wimpMass;
+    spectrum.targetMass = mXenon;
+
+  	//Find the zero point.
+  	G4double zeroPoint = 1;
+  	G4double lowerBound = 0;
+  	while(dR(zeroPoint,wimpMass,mXenon) > 0) zeroPoint *= 2;
+  	for(G4int i = 0; (zeroPoint - lowerBound)/zeroPoint > 1e-13; i++){
+  		if(dR((zeroPoint+lowerBound)/2,wimpMass,mXenon) > 0){
+  			lowerBound = (zeroPoint+lowerBound)/2;
+  		}
+  		else{
+  			zeroPoint = (zeroPoint+lowerBound)/2;
+  		}
+  	}
+  	zeroPoint = (zeroPoint+lowerBound)/2;
+    spectrum.endPoint = zeroPoint;
+
+  	//Integrate dR to get the probability distribution. Each bin is weighted
+  	//by the integral of dR from the bin up to the end point.
+  	G4double Rdist [5000];
+  	Rdist[4999] = 0;
+  	for(G4int i = 4998; i >= 0; i--){ //integration: trapezoids
+    		Rdist[i] = dR(i*zeroPoint/4999.,wimpMass,mXenon);
+    		Rdist[i] += dR((i+1)*zeroPoint/4999.,wimpMass,mXenon);
+    		Rdist[i] /=2;
+    		Rdist[i] *= (zeroPoint/4999.); //width
+    		Rdist[i] += Rdist[i+1]; //last bin evaluated
+  	}
+
+  	//Normalize the distribution and accumulate it
+  	G4double sum = 0;
+  	for(G4int i = 0; i < 5000; i++) sum += Rdist[i];
+    spectrum.cdf.resize( 5000 );
+    G4double runningSum = 0;
+  	for(G4int i = 0; i < 5000; i++) {
+        runningSum += Rdist[i]/sum;
+        spectrum.cdf[i] = runningSum;
+    }
+
+    //  Build the guide table with as many entries as there are bins
+    spectrum.guide.resize( 5000 );
+    G4int bin = 0;
+    for( G4int j=0; j<5000; j++ ) {
+        while( bin < 4999 && spectrum.cdf[bin] < (G4double)j/5000. )
+            bin++;
+        spectrum.guide[j] = bin;
+    }
+
+    G4cout << "Built WIMP recoil spectrum for " << wimpMass << " GeV on Xe-"
+           << mXenon << ", end point " << zeroPoint << " keV" << G4endl;
+
+    recoilSpectra.push_back( spectrum );
+    return &recoilSpectra.back();
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					SampleRecoilEnergy()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4double LUXSimGeneratorWimp::SampleRecoilEnergy( recoilSpectrum *spectrum )
+{
+  	//Find the bin to get the energy from
+  	G4double prob = G4UniformRand(); //the value to search the distribution with
+    G4int bin = spectrum->guide[(G4int)(prob*spectrum->guide.size())];
+    while( bin < (G4int)spectrum->cdf.size()-1 && spectrum->cdf[bin] < prob )
+        bin++;
+
+  	//Select an energy from the bin
+  	prob = G4UniformRand();
+  	return spectrum->endPoint*((bin+prob)/4999.);
+}
+
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //					GenerateEventList()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -194,8 +283,6 @@ void LUXSimGeneratorWimp::GenerateEventList( G4ThreeVector position,
 void LUXSimGeneratorWimp::GenerateFromEventList( G4GeneralParticleSource 
             *particleGun, G4Event *event, decayNode *firstNode )
 {
-    std::stringstream command (std::stringstream::in | std::stringstream::out);
-  
     G4ThreeVector pos = G4ThreeVector(firstNode->pos);
     G4double timeDelay = (firstNode->timeOfEvent)/ns;
 
@@ -225,59 +312,15 @@ void LUXSimGeneratorWimp::GenerateFromEventList( G4GeneralParticleSource
 
   	//Set the energy
     G4double wimpMass = (firstNode->energy)/GeV;//saved as kev
-  	//Set the energy (a many step process)
-  	//Find the zero point.
-  	G4double zeroPoint = 1;
-  	G4double lowerBound = 0;
-  	while(dR(zeroPoint,wimpMass,XeData[isotope][2]) > 0) zeroPoint *= 2;
-  	for(G4int i = 0; (zeroPoint - lowerBound)/zeroPoint > 1e-13; i++){
-  		if(dR((zeroPoint+lowerBound)/2,wimpMass,XeData[isotope][2]) > 0){
-  			lowerBound = (zeroPoint+lowerBound)/2;
-  		}
-  		else{
-  			zeroPoint = (zeroPoint+lowerBound)/2;
-  		}
-  	}
-  	zeroPoint = (zeroPoint+lowerBound)/2;
-
-  	//Integrate dR to get the probability distribution
-  	G4double Rdist [5000];
-  	Rdist[4999] = 0;
-  	for(G4int i = 4998; i >= 0; i--){ //integration: trapezoids
-    		Rdist[i] = dR(i*zeroPoint/4999.,wimpMass,XeData[isotope][2]);
-    		Rdist[i] += dR((i+1)*zeroPoint/4999.,wimpMass,XeData[isotope][2]);
-    		Rdist[i] /=2;
-    		Rdist[i] *= (zeroPoint/4999.); //width
-    		Rdist[i] += Rdist[i+1]; //last bin evaluated
-  	}
-
-  	//Normalize the distribution
-  	G4double sum = 0;
-  	for(G4int i = 0; i < 5000; i++) sum += Rdist[i];
-  	for(G4int i = 0; i < 5000; i++) Rdist[i] /= sum;
-
-  	//Find the bin to get the energy from
-  	G4double prob = G4UniformRand(); //the value to search the distribution with
-  	G4int bin = 0;
-  	while(bin < 5000){
-  		prob -= Rdist[bin];
-  		if(prob <= 0) break;
-  		bin++;
-  	}
-
-  	//Select an energy from the bin
-  	prob = G4UniformRand();
-  	G4double recoilEnergy = zeroPoint*((bin+prob)/4999.);
+    G4double recoilEnergy = SampleRecoilEnergy(
+            GetRecoilSpectrum( wimpMass, XeData[isotope][2] ) );
 
   	//Finally, set the energy
   	particleGun->GetCurrentSource()->GetEneDist()->SetMonoEnergy( 
                   recoilEnergy*keV );
 
   	//Set the ion
-    command << "/gps/ion 54 " << XeData[isotope][0] << " 0 0" << std::endl;
-  	
-  	//Input the command string
-  	UI->ApplyCommand(command.str());
+    SetIon( particleGun, 54, (G4int)XeData[isotope][0] );
 
   	particleGun->GeneratePrimaryVertex( event );
     luxManager->AddPrimaryParticle( GetParticleInfo(particleGun) );
@@ -0,0 +1,300 @@
+////////////////////////////////////////////////////////////////////////////////
+/*	LUXSimLZbkgSampler.cc
+*
+* This is the code file for the LZ background position and energy sampler. See
+* the header file for a description.
+*
+********************************************************************************
+* Change log
+*	19-Oct-26 - Initial submission
+*
+*/
+////////////////////////////////////////////////////////////////////////////////
+
+//
+//	C/C++ includes
+//
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//
+//	GEANT4 includes
+//
+#include "globals.hh"
+#include "Randomize.hh"
+
+//
+//	LUXSim includes
+//
+#include "LUXSimLZbkgSampler.hh"
+
+//
+//	Definitions
+//
+#define CACHE_MAGIC "LZbkg001"
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//				LUXSimLZbkgSampler()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+LUXSimLZbkgSampler::LUXSimLZbkgSampler()
+{
+	numR2bins = numZbins = 0;
+	r2FirstCenter = r2binWidth = zFirstCenter = zbinWidth = 0;
+
+	useFiducialVolume = false;
+	fiducialZMin = fiducialZMax = fiducialR2Max = 0;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//				~LUXSimLZbkgSampler()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+LUXSimLZbkgSampler::~LUXSimLZbkgSampler() {}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					SetFiducialVolume()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimLZbkgSampler::SetFiducialVolume( G4double zMin, G4double zMax,
+		G4double r2Max )
+{
+	useFiducialVolume = true;
+	fiducialZMin = zMin;
+	fiducialZMax = zMax;
+	fiducialR2Max = r2Max;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					LoadPositionMap()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimLZbkgSampler::LoadPositionMap( G4String fileName )
+{
+	std::vector<G4double> weights;
+
+	if( !ReadCache( fileName, weights ) ) {
+		std::ifstream file( fileName.c_str() );
+		if( !file.is_open() ) {
+			G4cout << G4endl << G4endl << G4endl;
+			G4cout << "File Not Found! " << fileName << G4endl;
+			G4cout << G4endl << G4endl << G4endl;
+			exit(0);
+		}
+
+		std::vector<G4double> r2Centers, zCenters;
+		G4double r2Center, zCenter, weight;
+		while( file >> r2Center >> zCenter >> weight ) {
+			r2Centers.push_back( r2Center );
+			zCenters.push_back( zCenter );
+			weights.push_back( weight );
+		}
+		file.close();
+
+		//	z varies fastest, so the number of z bins is the length of the
+		//	first run of equal r^2 values
+		numZbins = 0;
+		while( numZbins < (G4int)r2Centers.size() &&
+				r2Centers[numZbins] == r2Centers[0] )
+			numZbins++;
+		numR2bins = ( numZbins ? (G4int)r2Centers.size()/numZbins : 0 );
+
+		if( numZbins < 2 || numR2bins < 2 ||
+				numR2bins*numZbins != (G4int)weights.size() ) {
+			G4cout << G4endl << G4endl << G4endl;
+			G4cout << fileName << " is not a regular r^2-z grid" << G4endl;
+			G4cout << G4endl << G4endl << G4endl;
+			exit(0);
+		}
+
+		r2FirstCenter = r2Centers[0];
+		r2binWidth = r2Centers[numZbins] - r2Centers[0];
+		zFirstCenter = zCenters[0];
+		zbinWidth = zCenters[1] - zCenters[0];
+
+		WriteCache( fileName, weights );
+	}
+
+	//	Scale each bin by the part of it inside the fiducial volume
+	if( useFiducialVolume ) {
+		G4double r2Low, r2High, zLow, zHigh;
+		for( G4int i=0; i<numR2bins; i++ )
+			for( G4int j=0; j<numZbins; j++ ) {
+				GetBinBounds( i, j, r2Low, r2High, zLow, zHigh );
+				G4double fraction = 0;
+				if( r2High > r2Low && zHigh > zLow )
+					fraction = (r2High - r2Low)*(zHigh - zLow) /
+							(r2binWidth*zbinWidth);
+				weights[i*numZbins + j] *= fraction;
+			}
+	}
+
+	positionDistribution.SetWeights( numR2bins, numZbins, &weights[0] );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					LoadEnergySpectrum()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimLZbkgSampler::LoadEnergySpectrum( G4String fileName )
+{
+	std::ifstream file( fileName.c_str() );
+	if( !file.is_open() ) {
+		G4cout << G4endl << G4endl << G4endl;
+		G4cout << "File Not Found! " << fileName << G4endl;
+		G4cout << G4endl << G4endl << G4endl;
+		exit(0);
+	}
+
+	std::vector<G4double> weights;
+	G4double energy, weight;
+	energies.clear();
+	while( file >> energy >> weight ) {
+		energies.push_back( energy );
+		weights.push_back( weight );
+	}
+	file.close();
+
+	if( !energies.size() ) {
+		G4cout << G4endl << G4endl << G4endl;
+		G4cout << fileName << " has no energies in it" << G4endl;
+		G4cout << G4endl << G4endl << G4endl;
+		exit(0);
+	}
+
+	energyDistribution.SetWeights( (G4int)weights.size(), &weights[0] );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					GetPosition()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4ThreeVector LUXSimLZbkgSampler::GetPosition()
+{
+	G4int r2bin, zbin;
+	positionDistribution.SampleIndex( r2bin, zbin );
+
+	//	Pick a random place in the bin, and a random azimuthal angle
+	G4double r2Low, r2High, zLow, zHigh;
+	GetBinBounds( r2bin, zbin, r2Low, r2High, zLow, zHigh );
+	G4double r2 = r2Low + (r2High - r2Low)*G4UniformRand();
+	G4double z = zLow + (zHigh - zLow)*G4UniformRand();
+	G4double theta = 2.*3.14159265358979312*G4UniformRand();
+
+	return G4ThreeVector( sqrt(r2)*cos(theta)*cm, sqrt(r2)*sin(theta)*cm,
+			z*cm );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					GetEnergy()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4double LUXSimLZbkgSampler::GetEnergy()
+{
+	return energies[ energyDistribution.SampleIndex() ];
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					GetBinBounds()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimLZbkgSampler::GetBinBounds( G4int r2bin, G4int zbin,
+		G4double &r2Low, G4double &r2High, G4double &zLow, G4double &zHigh )
+{
+	r2Low = r2FirstCenter + (r2bin - 0.5)*r2binWidth;
+	r2High = r2Low + r2binWidth;
+	zLow = zFirstCenter + (zbin - 0.5)*zbinWidth;
+	zHigh = zLow + zbinWidth;
+
+	if( useFiducialVolume ) {
+		if( zLow < fiducialZMin ) zLow = fiducialZMin;
+		if( zHigh > fiducialZMax ) zHigh = fiducialZMax;
+		if( r2High > fiducialR2Max ) r2High = fiducialR2Max;
+	}
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					ReadCache()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4bool LUXSimLZbkgSampler::ReadCache( G4String fileName,
+		std::vector<G4double> &weights )
+{
+	//	The cache is only good if the map it came from hasn't changed
+	struct stat mapStat;
+	if( stat( fileName.c_str(), &mapStat ) )
+		return false;
+
+	G4String cacheName = fileName + ".cache";
+	std::ifstream cache( cacheName.c_str(), std::ios::in | std::ios::binary );
+	if( !cache.is_open() )
+		return false;
+
+	char magic[8];
+	long long mapSize, mapTime;
+	G4int numR2, numZ;
+	G4double r2First, r2Width, zFirst, zWidth;
+	cache.read( magic, 8 );
+	cache.read( (char*)&mapSize, sizeof(mapSize) );
+	cache.read( (char*)&mapTime, sizeof(mapTime) );
+	cache.read( (char*)&numR2, sizeof(numR2) );
+	cache.read( (char*)&numZ, sizeof(numZ) );
+	cache.read( (char*)&r2First, sizeof(r2First) );
+	cache.read( (char*)&r2Width, sizeof(r2Width) );
+	cache.read( (char*)&zFirst, sizeof(zFirst) );
+	cache.read( (char*)&zWidth, sizeof(zWidth) );
+
+	if( !cache || strncmp( magic, CACHE_MAGIC, 8 ) ||
+			mapSize != (long long)mapStat.st_size ||
+			mapTime != (long long)mapStat.st_mtime || numR2 < 2 || numZ < 2 )
+		return false;
+
+	weights.resize( numR2*numZ );
+	cache.read( (char*)&weights[0], weights.size()*sizeof(G4double) );
+	if( !cache )
+		return false;
+
+	numR2bins = numR2;
+	numZbins = numZ;
+	r2FirstCenter = r2First;
+	r2binWidth = r2Width;
+	zFirstCenter = zFirst;
+	zbinWidth = zWidth;
+
+	return true;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					WriteCache()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimLZbkgSampler::WriteCache( G4String fileName,
+		std::vector<G4double> &weights )
+{
+	struct stat mapStat;
+	if( stat( fileName.c_str(), &mapStat ) )
+		return;
+
+	//	Write to a temporary file and rename it, so that jobs sharing a
+	//	checkout never see a half-written cache
+	G4String cacheName = fileName + ".cache";
+	std::stringstream tempName;
+	tempName << cacheName << "." << getpid();
+
+	std::ofstream cache( tempName.str().c_str(),
+			std::ios::out | std::ios::binary );
+	if( !cache.is_open() )
+		return;
+
+	long long mapSize = mapStat.st_size;
+	long long mapTime = mapStat.st_mtime;
+	cache.write( CACHE_MAGIC, 8 );
+	cache.write( (char*)&mapSize, sizeof(mapSize) );
+	cache.write( (char*)&mapTime, sizeof(mapTime) );
+	cache.write( (char*)&numR2bins, sizeof(numR2bins) );
+	cache.write( (char*)&numZbins, sizeof(numZbins) );
+	cache.write( (char*)&r2FirstCenter, sizeof(r2FirstCenter) );
+	cache.write( (char*)&r2binWidth, sizeof(r2binWidth) );
+	cache.write( (char*)&zFirstCenter, sizeof(zFirstCenter) );
+	cache.write( (char*)&zbinWidth, sizeof(zbinWidth) );
+	cache.write( (char*)&weights[0], weights.size()*sizeof(G4double) );
+	cache.close();
+
+	if( !cache || rename( tempName.str().c_str(), cacheName.c_str() ) )
+		remove( tempName.str().c_str() );
+}
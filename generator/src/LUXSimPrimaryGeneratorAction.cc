@@ -11,6 +11,13 @@
 *	28-Apr-09 - Added check to see if any sources have been explicitly set, and
 *				if not, just generate the primary vertex (Kareem)
 *	18-May-13 - Added emission time for primaries (Chao)
+*	19-Oct-26 - The light map builder makes the primaries while it's running
+*	19-Oct-26 - The run profiler's event timer starts here, since the event
+*				action only begins after the primaries are made
+*	19-Oct-26 - Tells the run profiler when the primaries are made, so that
+*				generation isn't charged to the first step
+*	19-Oct-26 - Noted that plain GPS sources, optical photon bombs included,
+*				don't get the direct primary vertex path
 */
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -26,6 +33,8 @@
 //
 #include "LUXSimPrimaryGeneratorAction.hh"
 #include "LUXSimManager.hh"
+#include "LUXSimLightMap.hh"
+#include "LUXSimProfiler.hh"
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //					LUXSimPrimaryGeneratorAction()
@@ -50,15 +59,30 @@ LUXSimPrimaryGeneratorAction::~LUXSimPrimaryGeneratorAction()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 void LUXSimPrimaryGeneratorAction::GeneratePrimaries( G4Event *event )
 {
+	//	GeneratePrimaries comes before BeginOfEventAction, so the profiler
+	//	starts timing the event here. The generation is timed on its own.
+	if( luxManager->GetProfiling() )
+		luxManager->GetProfiler()->BeginOfEvent();
+	
 	//	Have the management class determine which event is next and generate
 	//	that event
-	if( luxManager->GetTotalSimulationActivity() )
+	if( luxManager->GetLightMap() && luxManager->GetLightMap()->IsBuilding() )
+		luxManager->GetLightMap()->GeneratePrimaries( event );
+	else if( luxManager->GetTotalSimulationActivity() )
 		luxManager->GenerateEvent( particleGun, event );
 	else {
+		//	Plain GPS sources, such as the optical photon bomb in
+		//	LUXSimMacros/bench/s2photonBomb.mac, still go through the GPS one
+		//	primary per event. The GPS does the position, angle and energy
+		//	sampling itself, and Geant4 asks for one event per call, so there
+		//	is nothing here to batch the way ScintPhotons does.
 	    //LUXSimManager::primaryParticleInfo particle = GetParticleInfo(particleGun);
         particleGun->GeneratePrimaryVertex( event );
         luxManager->AddPrimaryParticle( GetParticleInfo(particleGun) );
     }
+	
+	if( luxManager->GetProfiling() )
+		luxManager->GetProfiler()->EndOfPrimaryGeneration();
 }
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -18,6 +18,15 @@
 *   14-Jul-2012 - GenerateEventList and GenerateFromEventList for all sources.
 *                 All sources are added to the binary search tree (Nick)
 *   18-May-2013 - Added emission time for primaries (Chao)
+*   19-Oct-2026 - Added SetIon() and SetNucleusLimits(). Ion definitions are
+*                 cached, and the nucleus limits are only re-sent when they
+*                 change
+*   19-Oct-2026 - Added GeneratePrimary()
+*   19-Oct-2026 - The nucleus limits are sent every time again. A copy of the
+*                 last limits went stale when a macro or another generator
+*                 used /grdm/nucleusLimits directly
+*   19-Oct-2026 - The nucleus limits are only sent when they change again,
+*                 and the copy is cleared at the start of each run
 */
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -25,6 +34,13 @@
 //	GEANT4 includes
 //
 #include "globals.hh"
+#include "G4ParticleTable.hh"
+#include "G4IonTable.hh"
+
+//
+//	C/C++ includes
+//
+#include <sstream>
 
 //
 //	LUXSim includes
@@ -32,6 +48,13 @@
 #include "LUXSimSource.hh"
 #include "LUXSimDetectorComponent.hh"
 
+//
+//	Static members
+//
+std::map< std::pair<G4int,G4double>, G4ParticleDefinition* >
+		LUXSimSource::ionDefinitions;
+G4int LUXSimSource::nucleusLimits[4] = { -1, -1, -1, -1 };
+
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //					LUXSimSource()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -131,3 +154,102 @@ G4ThreeVector LUXSimSource::GetRandomDirection()
 
 	return direction;
 }
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					SetIon()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//	Does the same as "/gps/ion Z A charge excitation", but without going
+//	through the UI, and each ion is only looked up in the ion table once.
+void LUXSimSource::SetIon( G4GeneralParticleSource *particleGun, G4int Z,
+		G4int A, G4int charge, G4double excitation )
+{
+	std::pair<G4int,G4double> key( 1000*Z + A, excitation );
+	std::map< std::pair<G4int,G4double>, G4ParticleDefinition* >::iterator
+			it = ionDefinitions.find( key );
+
+	G4ParticleDefinition *ionDef = 0;
+	if( it != ionDefinitions.end() )
+		ionDef = it->second;
+	else {
+		ionDef = G4ParticleTable::GetParticleTable()->GetIonTable()->
+				GetIon( Z, A, excitation );
+		if( !ionDef ) {
+			G4cout << "Ion with Z = " << Z << ", A = " << A << " and E = "
+				   << excitation/keV << " keV is not defined" << G4endl;
+			return;
+		}
+		ionDefinitions[key] = ionDef;
+	}
+
+	particleGun->GetCurrentSource()->SetParticleDefinition( ionDef );
+	particleGun->GetCurrentSource()->SetParticleCharge( charge*eplus );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					SetNucleusLimits()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//	Sets /grdm/nucleusLimits, skipping the command when the limits are the same
+//	as the last ones set. Nothing else in LUXSim sets the limits during a run,
+//	and ResetNucleusLimits() covers macros that set them between runs.
+void LUXSimSource::SetNucleusLimits( G4int aMin, G4int aMax, G4int zMin,
+		G4int zMax )
+{
+	if( nucleusLimits[0] == aMin && nucleusLimits[1] == aMax &&
+			nucleusLimits[2] == zMin && nucleusLimits[3] == zMax )
+		return;
+
+	nucleusLimits[0] = aMin;
+	nucleusLimits[1] = aMax;
+	nucleusLimits[2] = zMin;
+	nucleusLimits[3] = zMax;
+
+	std::stringstream command;
+	command << "/grdm/nucleusLimits " << aMin << " " << aMax << " " << zMin
+			<< " " << zMax;
+	UI->ApplyCommand( command.str() );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					ResetNucleusLimits()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimSource::ResetNucleusLimits()
+{
+	for( G4int i=0; i<4; i++ )
+		nucleusLimits[i] = -1;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					GeneratePrimary()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//	Adds a single primary to the event, in the same way the GPS does it, and
+//	records it with the manager. This skips the position, angular and energy
+//	distributions of the GPS, so it's only for generators that already know
+//	everything about the primary.
+void LUXSimSource::GeneratePrimary( G4Event *event,
+		G4ParticleDefinition *definition, const G4ThreeVector &position,
+		const G4ThreeVector &direction, G4double energy, G4double time,
+		const G4ThreeVector &polarization )
+{
+	G4double mass = definition->GetPDGMass();
+	G4double momentum = sqrt( energy*( energy + 2.*mass ) );
+
+	G4PrimaryParticle *particle = new G4PrimaryParticle( definition,
+			momentum*direction.x(), momentum*direction.y(),
+			momentum*direction.z() );
+	particle->SetMass( mass );
+	particle->SetCharge( definition->GetPDGCharge() );
+	particle->SetPolarization( polarization.x(), polarization.y(),
+			polarization.z() );
+
+	G4PrimaryVertex *vertex = new G4PrimaryVertex( position, time );
+	vertex->SetPrimary( particle );
+	event->AddPrimaryVertex( vertex );
+
+	LUXSimManager::primaryParticleInfo info;
+	info.id = definition->GetParticleName();
+	info.energy = energy;
+	info.time = time;
+	info.position = position;
+	info.direction = direction;
+	luxManager->AddPrimaryParticle( info );
+}
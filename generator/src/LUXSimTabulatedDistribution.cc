@@ -0,0 +1,256 @@
+////////////////////////////////////////////////////////////////////////////////
+/*	LUXSimTabulatedDistribution.cc
+*
+* This is the code file for the tabulated distribution sampler. See the header
+* file for a description.
+*
+********************************************************************************
+* Change log
+*	19-Oct-26 - Initial submission
+*
+*/
+////////////////////////////////////////////////////////////////////////////////
+
+//
+//	C/C++ includes
+//
+#include <algorithm>
+
+//
+//	GEANT4 includes
+//
+#include "globals.hh"
+#include "Randomize.hh"
+
+//
+//	LUXSim includes
+//
+#include "LUXSimTabulatedDistribution.hh"
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//				LUXSimTabulatedDistribution()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+LUXSimTabulatedDistribution::LUXSimTabulatedDistribution()
+{
+	numColumns = 1;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//				~LUXSimTabulatedDistribution()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+LUXSimTabulatedDistribution::~LUXSimTabulatedDistribution() {}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					SetCDF()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimTabulatedDistribution::SetCDF( G4int numPoints, const G4double *x,
+		const G4double *cdf )
+{
+	if( numPoints < 2 || !(cdf[numPoints-1] > cdf[0]) ) {
+		G4cout << G4endl << G4endl << G4endl;
+		G4cout << "LUXSimTabulatedDistribution: the CDF must have at least "
+			   << "two points and a non-zero range" << G4endl;
+		G4cout << G4endl << G4endl << G4endl;
+		exit(0);
+	}
+
+	//	The CDF is rescaled to run from exactly 0 to exactly 1, so that every
+	//	random number falls inside the table.
+	xValues.assign( x, x + numPoints );
+	cdfValues.resize( numPoints );
+	for( G4int i=0; i<numPoints; i++ )
+		cdfValues[i] = (cdf[i] - cdf[0]) / (cdf[numPoints-1] - cdf[0]);
+	cdfValues[numPoints-1] = 1.;
+
+	BuildGuideTable();
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					SetPDF()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimTabulatedDistribution::SetPDF( G4int numPoints, const G4double *x,
+		const G4double *pdf )
+{
+	std::vector<G4double> cdf( numPoints, 0. );
+	for( G4int i=1; i<numPoints; i++ )
+		cdf[i] = cdf[i-1] + 0.5*(pdf[i-1] + pdf[i])*(x[i] - x[i-1]);
+
+	SetCDF( numPoints, x, &cdf[0] );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					BuildGuideTable()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimTabulatedDistribution::BuildGuideTable()
+{
+	//	Guide entry g holds the last bin whose lower CDF edge is at or below
+	//	g/numGuides. A random number in [g/numGuides,(g+1)/numGuides) then only
+	//	has to be scanned forward from that bin, and with one guide entry per
+	//	bin the scan is a step or two on average.
+	G4int numGuides = (G4int)cdfValues.size() - 1;
+	G4int lastBin = (G4int)cdfValues.size() - 2;
+	guideTable.resize( numGuides );
+
+	G4int bin = 0;
+	for( G4int g=0; g<numGuides; g++ ) {
+		G4double prob = (G4double)g / numGuides;
+		while( bin < lastBin && cdfValues[bin+1] <= prob )
+			bin++;
+		guideTable[g] = bin;
+	}
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					GetInverseCDF()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4double LUXSimTabulatedDistribution::GetInverseCDF( G4double prob )
+{
+	G4int numGuides = (G4int)guideTable.size();
+	G4int lastBin = (G4int)cdfValues.size() - 2;
+
+	G4int g = (G4int)(prob*numGuides);
+	if( g < 0 ) g = 0;
+	if( g >= numGuides ) g = numGuides - 1;
+
+	G4int bin = guideTable[g];
+	while( bin < lastBin && cdfValues[bin+1] <= prob )
+		bin++;
+
+	G4double width = cdfValues[bin+1] - cdfValues[bin];
+	if( width <= 0 )
+		return xValues[bin];
+
+	G4double split = (prob - cdfValues[bin]) / width;
+	return( xValues[bin] + split*(xValues[bin+1] - xValues[bin]) );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					GetCDF()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4double LUXSimTabulatedDistribution::GetCDF( G4double x )
+{
+	if( x <= xValues.front() )
+		return 0.;
+	if( x >= xValues.back() )
+		return 1.;
+
+	G4int bin = (G4int)( std::upper_bound( xValues.begin(), xValues.end(), x )
+			- xValues.begin() ) - 1;
+
+	G4double split = (x - xValues[bin]) / (xValues[bin+1] - xValues[bin]);
+	return( cdfValues[bin] + split*(cdfValues[bin+1] - cdfValues[bin]) );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					Sample()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4double LUXSimTabulatedDistribution::Sample()
+{
+	return GetInverseCDF( G4UniformRand() );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					Sample()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4double LUXSimTabulatedDistribution::Sample( G4double xMax )
+{
+	//	Sampling the CDF below F(xMax) is the same distribution as sampling the
+	//	whole table and throwing away anything above xMax, but it never needs
+	//	more than one random number.
+	G4double maxProb = GetCDF( xMax );
+	if( maxProb <= 0 )
+		return xValues.front();
+
+	return GetInverseCDF( maxProb*G4UniformRand() );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					SetWeights()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimTabulatedDistribution::SetWeights( G4int numBins,
+		const G4double *weights )
+{
+	G4double totalWeight = 0;
+	for( G4int i=0; i<numBins; i++ )
+		if( weights[i] > 0 )
+			totalWeight += weights[i];
+
+	if( numBins < 1 || totalWeight <= 0 ) {
+		G4cout << G4endl << G4endl << G4endl;
+		G4cout << "LUXSimTabulatedDistribution: the weights must include at "
+			   << "least one positive value" << G4endl;
+		G4cout << G4endl << G4endl << G4endl;
+		exit(0);
+	}
+
+	//	Vose's construction of the alias table. Each bin is scaled so that the
+	//	average is 1, then the bins below 1 are topped up from the bins above
+	//	1. Negative weights are treated as zero.
+	std::vector<G4double> scaled( numBins );
+	std::vector<G4int> smallBins, largeBins;
+	aliasProbability.assign( numBins, 1. );
+	aliasIndex.resize( numBins );
+	for( G4int i=0; i<numBins; i++ ) {
+		aliasIndex[i] = i;
+		scaled[i] = (weights[i] > 0 ? weights[i] : 0.) * numBins / totalWeight;
+		if( scaled[i] < 1. )
+			smallBins.push_back( i );
+		else
+			largeBins.push_back( i );
+	}
+
+	while( !smallBins.empty() && !largeBins.empty() ) {
+		G4int small = smallBins.back();
+		G4int large = largeBins.back();
+		smallBins.pop_back();
+
+		aliasProbability[small] = scaled[small];
+		aliasIndex[small] = large;
+
+		scaled[large] -= 1. - scaled[small];
+		if( scaled[large] < 1. ) {
+			largeBins.pop_back();
+			smallBins.push_back( large );
+		}
+	}
+
+	//	Whatever is left over is 1 up to rounding, and keeps its probability
+	//	of 1 from the initialization above.
+
+	numColumns = 1;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					SetWeights()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimTabulatedDistribution::SetWeights( G4int numX, G4int numY,
+		const G4double *weights )
+{
+	SetWeights( numX*numY, weights );
+	numColumns = numY;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					SampleIndex()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4int LUXSimTabulatedDistribution::SampleIndex()
+{
+	G4int numBins = (G4int)aliasProbability.size();
+	G4int bin = (G4int)( G4UniformRand()*numBins );
+	if( bin >= numBins )
+		bin = numBins - 1;
+
+	if( G4UniformRand() < aliasProbability[bin] )
+		return bin;
+	return aliasIndex[bin];
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					SampleIndex()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimTabulatedDistribution::SampleIndex( G4int &i, G4int &j )
+{
+	G4int bin = SampleIndex();
+	i = bin / numColumns;
+	j = bin % numColumns;
+}
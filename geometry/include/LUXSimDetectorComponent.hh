@@ -39,6 +39,13 @@
 *   14-Oct-14 - Added Set methods for the mass and volume (Kareem)
 *   28-Aug-15 - Changed the source stucture and AddSource method to accomodate
 *                           point sources (David W)
+*   19-Oct-26 - Added the voxel map used by GetEventLocation
+*   19-Oct-26 - Added GetSolidVolume, which CalculateVolume uses
+*   19-Oct-26 - Added the optical photon policy (kill, bounce and path length
+*               caps, and Russian roulette) and its Get and Set methods
+*   19-Oct-26 - GetOptPhotPolicy returns a const reference
+*   19-Oct-26 - The roulette is off when its survival probability is 1, so 0
+*               bounces means from the first reflection
 */
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -68,6 +75,7 @@ class G4GeneralParticleSource;
 class G4Event;
 class G4PVPlacement;
 class G4Navigator;
+class G4VSolid;
 
 class LUXSimSource;
 
@@ -90,6 +98,19 @@ class LUXSimDetectorComponent : public G4PVPlacement
 	    G4ThreeVector posSource;//position of point source
 		};
 
+		//	What to do with optical photons in the component, on top of the
+		//	optical photon record level. A zero cap turns that part of the
+		//	policy off, and so does a roulette survival probability of 1. A
+		//	zero roulette bounce count plays the roulette from the first
+		//	reflection. See LUXSimSteppingAction.
+		struct optPhotPolicy {
+			G4bool kill;				//	kill photons as soon as they enter
+			G4int maxBounces;			//	kill photons with this many bounces
+			G4double maxPathLength;		//	kill photons that went this far
+			G4int rouletteBounces;		//	roulette each bounce past this many
+			G4double rouletteSurvival;	//	survival probability of a roulette
+		};
+
 	public:
 
 		LUXSimDetectorComponent( G4RotationMatrix *pRot,
@@ -141,6 +162,11 @@ class LUXSimDetectorComponent : public G4PVPlacement
 		inline void SetRecordLevelThermElec( G4int level )
 				{ recordLevelThermElec = level; };
 		
+		inline const optPhotPolicy &GetOptPhotPolicy()
+				{ return optPhotPolicyInfo; };
+		inline void SetOptPhotPolicy( optPhotPolicy policy )
+				{ optPhotPolicyInfo = policy; };
+		
 		void AddDeposition( LUXSimManager::stepRecord aStepRecord )
 				{ eventRecord.push_back(aStepRecord);};
 		void ClearRecord() { eventRecord.clear(); };
@@ -176,12 +202,15 @@ class LUXSimDetectorComponent : public G4PVPlacement
 		
 	private:
 		G4ThreeVector GetEventLocation();
+		void BuildVoxelMap();
+		G4double GetSolidVolume( G4VSolid* );
 
 	private:
 
 		G4int recordLevel;
 		G4int recordLevelOptPhot;
 		G4int recordLevelThermElec;
+		optPhotPolicy optPhotPolicyInfo;
 		std::vector<LUXSimManager::stepRecord> eventRecord;
 		G4int compID;
 		
@@ -202,6 +231,17 @@ class LUXSimDetectorComponent : public G4PVPlacement
         G4int volumePrecision;
 
 		G4bool capturePhotons;
+
+		//	Voxel map of the event location box. sampleVoxels lists every
+		//	voxel that is at least partly inside the component, and
+		//	sampleVoxelIsBoundary says whether a point in it still has to be
+		//	checked with the navigator.
+		G4bool voxelMapBuilt;
+		G4ThreeVector voxelOrigin;
+		G4int numVoxelsX, numVoxelsY, numVoxelsZ;
+		G4double voxelSizeX, voxelSizeY, voxelSizeZ;
+		std::vector<G4int> sampleVoxels;
+		std::vector<G4bool> sampleVoxelIsBoundary;
 		
 		LUXSimManager *luxManager;		
 		G4Navigator *navigator;
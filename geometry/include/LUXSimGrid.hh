@@ -16,6 +16,10 @@
 //  08.12.13 - Added the radius of the wire grid span as a separate argument passed to these 
 //             functions.  (Vic)
 
+//  19 Oct 2026 - Added StartWires, PlaceWire and FinishWires, so that a wire
+//                plane can be placed either as one component per wire or as a
+//                single parameterised volume.
+
 #ifndef LUXSimGrid_HH
 #define LUXSimGrid_HH 1
 
@@ -23,6 +27,8 @@
 //	GEANT4 includes
 //
 #include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "G4RotationMatrix.hh"
 
 //
 //	LUXSim includes
@@ -32,7 +38,9 @@
 //	Class forwarding
 //
 class G4LogicalVolume;
+class G4OpticalSurface;
 class LUXSimDetectorComponent;
+class LUXSimGridWireParameterisation;
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 class LUXSimGrid
 {
@@ -70,11 +78,28 @@ class LUXSimGrid
 	public:
 		inline LUXSimDetectorComponent *GetHolder() { return holder; };
 
+	private:
+		void StartWires(G4RotationMatrix * rot);
+		void PlaceWire(G4RotationMatrix * rot,
+					   G4ThreeVector pos,
+					   G4double wireHalfLength,
+					   G4double wireRadius,
+					   G4String wireName,
+					   G4OpticalSurface * surface);
+		void FinishWires(G4String wireName,
+						 G4double wireRadius,
+						 G4OpticalSurface * surface);
+
 	private:
 		G4LogicalVolume * frame_log;
 		G4LogicalVolume * holder_log;
 		LUXSimDetectorComponent * frame;
 		LUXSimDetectorComponent * holder;
+
+		G4bool parameterisedWires;
+		LUXSimGridWireParameterisation * wireParameterisation;
+		G4LogicalVolume * lastWire_log;
+		G4double lastWireHalfLength;
 };
 
 #endif
@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////
+/*	LUXSimGridWireParameterisation.hh
+*
+* This is the header file for the grid wire parameterisation. It allows a whole
+* plane of grid wires to be placed as a single G4PVParameterised instead of one
+* LUXSimDetectorComponent per wire. All wires in a plane share a radius and
+* rotation and differ only in their position and length, so each copy is a
+* G4Tubs with its own half-length. The copy number of a wire is its index in
+* the order the wires were added, which is how an individual wire can be
+* identified from the touchable during tracking.
+*
+********************************************************************************
+* Change log
+*	19-Oct-26 - Initial submission
+*
+*/
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LUXSimGridWireParameterisation_HH
+#define LUXSimGridWireParameterisation_HH 1
+
+//
+//	C/C++ includes
+//
+#include <vector>
+
+//
+//	GEANT4 includes
+//
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "G4RotationMatrix.hh"
+#include "G4VPVParameterisation.hh"
+
+//
+//	Class forwarding
+//
+class G4VPhysicalVolume;
+class G4Tubs;
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+class LUXSimGridWireParameterisation : public G4VPVParameterisation
+{
+	public:
+		LUXSimGridWireParameterisation( G4RotationMatrix* );
+		~LUXSimGridWireParameterisation();
+
+	public:
+		void AddWire( G4ThreeVector position, G4double halfLength );
+
+		inline G4int GetNumWires() { return (G4int)positions.size(); };
+		inline G4ThreeVector GetWirePosition( G4int copyNo )
+				{ return positions[copyNo]; };
+		inline G4double GetWireHalfLength( G4int copyNo )
+				{ return halfLengths[copyNo]; };
+		G4double GetMaxHalfLength();
+
+		void ComputeTransformation( const G4int, G4VPhysicalVolume* ) const;
+		void ComputeDimensions( G4Tubs&, const G4int,
+				const G4VPhysicalVolume* ) const;
+
+	private:
+		G4RotationMatrix *rotation;
+		std::vector<G4ThreeVector> positions;
+		std::vector<G4double> halfLengths;
+};
+
+#endif
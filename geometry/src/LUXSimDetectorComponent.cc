@@ -64,14 +64,35 @@
 *   14-Oct-14 - Added Set methods for the mass and volume (Kareem)
 *   28-Aug-15 - Edited AddSource method and EventPosition calculation to 
 *               accommodate point sources (David W)
+*   19-Oct-26 - CalculateVolume handles parameterised daughter volumes
+*   19-Oct-26 - GetEventLocation draws points from a voxel map of the
+*               component, built the first time it's needed, and only calls
+*               the navigator for voxels that straddle a surface
+*   19-Oct-26 - CalculateVolume uses the analytic volume of simple solids,
+*               samples the others on several threads, and keeps the results
+*               in geometry/LUXSimVolumeCache.txt for later runs
+*   19-Oct-26 - The optical photon policy starts out switched off
+*   19-Oct-26 - The volume sampling is split into a fixed number of jobs
+*               seeded from the geometry hash, so it no longer draws from the
+*               main random engine or depends on the number of cores
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
 
+//
+//	C/C++ includes
+//
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <pthread.h>
+#include <unistd.h>
+
 //
 //	CLHEP includes
 //
 #include "Randomize.hh"
+#include "CLHEP/Random/MTwistEngine.h"
 
 //
 //	GEANT4 includes
@@ -89,6 +110,8 @@
 #include "G4VoxelLimits.hh"
 #include "G4AffineTransform.hh"
 #include "G4Material.hh"
+#include "G4VPVParameterisation.hh"
+#include "G4VSolid.hh"
 
 //
 //	LUXSim includes
@@ -98,6 +121,63 @@
 #include "LUXSimMaterials.hh"
 #include "LUXSimSource.hh"
 
+//
+//	Definitions
+//
+#define VOLUME_CACHE_FILE "geometry/LUXSimVolumeCache.txt"
+#define VOLUME_SAMPLING_JOBS 32
+
+//	One share of the Monte Carlo volume estimate, with its own random engine.
+//	The number of jobs and their seeds don't depend on the machine, so the
+//	estimate is the same however many threads run the jobs.
+struct volumeSamplingJob {
+	G4VSolid *solid;
+	G4ThreeVector minXYZ, maxXYZ;
+	G4double targetInsideSamples;
+	long seed;
+	G4double totalSamples;
+	G4double insideSamples;
+};
+
+static void *SampleSolidVolume( void *arg )
+{
+	volumeSamplingJob *job = (volumeSamplingJob*)arg;
+	CLHEP::MTwistEngine engine( job->seed );
+	G4ThreeVector size = job->maxXYZ - job->minXYZ;
+
+	while( job->insideSamples < job->targetInsideSamples ) {
+		job->totalSamples++;
+		G4ThreeVector position( size.x()*engine.flat() + job->minXYZ.x(),
+				size.y()*engine.flat() + job->minXYZ.y(),
+				size.z()*engine.flat() + job->minXYZ.z() );
+		if( job->solid->Inside( position ) != kOutside )
+			job->insideSamples++;
+	}
+
+	return 0;
+}
+
+//	The jobs run by one thread: first, first+stride, first+2*stride, ...
+struct volumeSamplingThread {
+	volumeSamplingJob *jobs;
+	G4int first;
+	G4int stride;
+	G4int numJobs;
+};
+
+static void *RunSamplingJobs( void *arg )
+{
+	volumeSamplingThread *thread = (volumeSamplingThread*)arg;
+	for( G4int i=thread->first; i<thread->numJobs; i+=thread->stride )
+		SampleSolidVolume( &thread->jobs[i] );
+
+	return 0;
+}
+
+//	The volumes already in the cache file, by geometry hash
+static std::map<G4String,G4double> volumeCache;
+static G4bool volumeCacheLoaded = false;
+
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //					LUXSimDetectorComponent()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -193,9 +273,18 @@ void LUXSimDetectorComponent::Initialize()
 	recordLevel = 0;
 	recordLevelOptPhot = 0;
 	recordLevelThermElec = 0;
+	optPhotPolicyInfo.kill = false;
+	optPhotPolicyInfo.maxBounces = 0;
+	optPhotPolicyInfo.maxPathLength = 0;
+	optPhotPolicyInfo.rouletteBounces = 0;
+	optPhotPolicyInfo.rouletteSurvival = 1;
     
     volume = mass = -1;
     volumePrecision = 100000000;
+
+    voxelMapBuilt = false;
+    numVoxelsX = numVoxelsY = numVoxelsZ = 0;
+    voxelSizeX = voxelSizeY = voxelSizeZ = 0;
 }
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -458,6 +547,9 @@ void LUXSimDetectorComponent::DetermineCenterAndExtent( G4PVPlacement *ref )
 	maxY += 10.*nm;
 	minZ -= 10.*nm;
 	maxZ += 10.*nm;
+
+	//	The voxel map covers the old extent, so it has to be rebuilt
+	voxelMapBuilt = false;
 }
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -465,37 +557,164 @@ void LUXSimDetectorComponent::DetermineCenterAndExtent( G4PVPlacement *ref )
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 G4ThreeVector LUXSimDetectorComponent::GetEventLocation()
 {
-	//	First determine location of the source. Pick points at random in a
-	//	sphere of the appropriate radius, centered on the center of this
-	//	geometry object;
-	G4bool insideVolume = false;
+	if( !voxelMapBuilt )
+		BuildVoxelMap();
+
+	//	Pick a voxel that isn't outside the volume, and a point at random in
+	//	it. Voxels are all the same size, so picking them with equal
+	//	probability keeps the points uniform. Points in voxels that are
+	//	entirely inside the volume are kept as they are; the rest are checked
+	//	with the navigator, and if they miss we start again from a new voxel.
 	G4int counter = 0;
-	while( !insideVolume ) {
+	G4int numSampleVoxels = (G4int)sampleVoxels.size();
+	while( true ) {
 		counter++;
 		if( !(counter%100000) )
 			G4cout << "Warning: It has taken at least " << counter
 				   << " attempts to find a point inside the "
 				   << this->GetName() << " volume" << G4endl;
 	
-		//	Find a point at random in the box bounded by the dimensions
-		//	calculated in DetermineCenterAndExtent.
-		xPos = (maxX - minX)*G4UniformRand() + minX;
-		yPos = (maxY - minY)*G4UniformRand() + minY;
-		zPos = (maxZ - minZ)*G4UniformRand() + minZ;
+		G4int sample = (G4int)( G4UniformRand()*numSampleVoxels );
+		if( sample >= numSampleVoxels )
+			sample = numSampleVoxels - 1;
+		G4int voxel = sampleVoxels[sample];
+		G4int iz = voxel % numVoxelsZ;
+		G4int iy = (voxel / numVoxelsZ) % numVoxelsY;
+		G4int ix = voxel / (numVoxelsZ*numVoxelsY);
+
+		xPos = voxelOrigin.x() + (ix + G4UniformRand())*voxelSizeX;
+		yPos = voxelOrigin.y() + (iy + G4UniformRand())*voxelSizeY;
+		zPos = voxelOrigin.z() + (iz + G4UniformRand())*voxelSizeZ;
 
 		G4ThreeVector position( xPos, yPos, zPos );
 		position.transform( globalOrientation );
 		position += globalCenter;
 		
-		if( navigator->LocateGlobalPointAndSetup( position ) == this ) {
-			insideVolume = true;
+		if( !sampleVoxelIsBoundary[sample] ||
+				navigator->LocateGlobalPointAndSetup( position ) == this )
 			return position;
+	}
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					BuildVoxelMap()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimDetectorComponent::BuildVoxelMap()
+{
+	//	The box used for the event locations is split into roughly cubic
+	//	voxels, up to maxVoxels of them. Each voxel is classified from the
+	//	safety distances of the solid and its daughters at its centre: if the
+	//	surface is further away than half the voxel diagonal, the whole
+	//	voxel is on one side of it. Safety distances are never larger than
+	//	the real distance, so a voxel is only called inside or outside when
+	//	it really is. Everything else is a boundary voxel.
+	const G4int maxVoxels = 100000;
+	const G4int maxVoxelsPerAxis = 256;
+
+	//	The extent is copied, because CalculateVolume() also sets it
+	voxelOrigin = G4ThreeVector( minX, minY, minZ );
+	G4double boxVolume = (maxX - minX) * (maxY - minY) * (maxZ - minZ);
+	G4double edge = pow( boxVolume/maxVoxels, 1./3. );
+	numVoxelsX = numVoxelsY = numVoxelsZ = 1;
+	if( edge > 0 ) {
+		numVoxelsX = (G4int)ceil( (maxX - minX)/edge );
+		numVoxelsY = (G4int)ceil( (maxY - minY)/edge );
+		numVoxelsZ = (G4int)ceil( (maxZ - minZ)/edge );
+	}
+	if( numVoxelsX < 1 ) numVoxelsX = 1;
+	if( numVoxelsY < 1 ) numVoxelsY = 1;
+	if( numVoxelsZ < 1 ) numVoxelsZ = 1;
+	if( numVoxelsX > maxVoxelsPerAxis ) numVoxelsX = maxVoxelsPerAxis;
+	if( numVoxelsY > maxVoxelsPerAxis ) numVoxelsY = maxVoxelsPerAxis;
+	if( numVoxelsZ > maxVoxelsPerAxis ) numVoxelsZ = maxVoxelsPerAxis;
+	voxelSizeX = (maxX - minX)/numVoxelsX;
+	voxelSizeY = (maxY - minY)/numVoxelsY;
+	voxelSizeZ = (maxZ - minZ)/numVoxelsZ;
+	G4double halfDiagonal = 0.5*sqrt( voxelSizeX*voxelSizeX +
+			voxelSizeY*voxelSizeY + voxelSizeZ*voxelSizeZ );
+
+	//	A point in a daughter volume isn't in this component. Parameterised
+	//	daughters change shape from copy to copy, so when there are any, no
+	//	voxel is taken to be entirely inside and the navigator decides.
+	G4VSolid *solid = GetLogicalVolume()->GetSolid();
+	std::vector<G4VSolid*> daughterSolids;
+	std::vector<G4AffineTransform> toDaughterFrames;
+	G4bool hasParameterisedDaughter = false;
+	for( G4int i=0; i<GetLogicalVolume()->GetNoDaughters(); i++ ) {
+		G4VPhysicalVolume *daughter = GetLogicalVolume()->GetDaughter(i);
+		if( daughter->IsParameterised() || daughter->IsReplicated() ) {
+			hasParameterisedDaughter = true;
+			continue;
 		}
+		G4AffineTransform toDaughterFrame( daughter->GetRotation(),
+				daughter->GetTranslation() );
+		toDaughterFrame.Invert();
+		daughterSolids.push_back( daughter->GetLogicalVolume()->GetSolid() );
+		toDaughterFrames.push_back( toDaughterFrame );
 	}
-	
-	G4cout << "WARNING! Could not find a location inside volume "
-		   << this->GetName();
-	return( G4ThreeVector(0,0,0) );
+
+	sampleVoxels.clear();
+	sampleVoxelIsBoundary.clear();
+	G4int numInside = 0;
+	for( G4int ix=0; ix<numVoxelsX; ix++ )
+	for( G4int iy=0; iy<numVoxelsY; iy++ )
+	for( G4int iz=0; iz<numVoxelsZ; iz++ ) {
+		G4ThreeVector centre( voxelOrigin.x() + (ix + 0.5)*voxelSizeX,
+				voxelOrigin.y() + (iy + 0.5)*voxelSizeY,
+				voxelOrigin.z() + (iz + 0.5)*voxelSizeZ );
+
+		G4bool outside = false;
+		G4bool inside = false;
+		EInside in = solid->Inside( centre );
+		if( in == kOutside )
+			outside = ( solid->DistanceToIn( centre ) >= halfDiagonal );
+		else if( in == kInside )
+			inside = ( solid->DistanceToOut( centre ) >= halfDiagonal );
+
+		for( G4int d=0; d<(G4int)daughterSolids.size() && !outside; d++ ) {
+			G4ThreeVector daughterCentre =
+					toDaughterFrames[d].TransformPoint( centre );
+			EInside inDaughter = daughterSolids[d]->Inside( daughterCentre );
+			if( inDaughter == kOutside ) {
+				if( daughterSolids[d]->DistanceToIn( daughterCentre ) <
+						halfDiagonal )
+					inside = false;
+			} else {
+				inside = false;
+				if( inDaughter == kInside && daughterSolids[d]->
+						DistanceToOut( daughterCentre ) >= halfDiagonal )
+					outside = true;
+			}
+		}
+		if( hasParameterisedDaughter )
+			inside = false;
+
+		if( outside )
+			continue;
+
+		sampleVoxels.push_back( (ix*numVoxelsY + iy)*numVoxelsZ + iz );
+		sampleVoxelIsBoundary.push_back( !inside );
+		if( inside )
+			numInside++;
+	}
+
+	//	If nothing survived, something odd is going on with the solid, so
+	//	fall back to sampling the whole box
+	if( !sampleVoxels.size() ) {
+		numVoxelsX = numVoxelsY = numVoxelsZ = 1;
+		voxelSizeX = maxX - minX;
+		voxelSizeY = maxY - minY;
+		voxelSizeZ = maxZ - minZ;
+		sampleVoxels.push_back( 0 );
+		sampleVoxelIsBoundary.push_back( true );
+	}
+
+	G4cout << "Voxel map for " << GetName() << ": " << numInside
+		   << " inside and " << sampleVoxels.size() - numInside
+		   << " boundary voxels out of " << numVoxelsX*numVoxelsY*numVoxelsZ
+		   << G4endl;
+
+	voxelMapBuilt = true;
 }
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -525,58 +744,26 @@ G4double LUXSimDetectorComponent::CalculateVolume(
         G4cout << "Calculating the volume of " << GetName() << "... "
                << std::flush;
 
-    //	Next, determine the X, Y, and Z extent of the shape. Augment the
-    //	values by a small buffer to ensure complete coverage of the volume.
-    this->GetLogicalVolume()->GetSolid()->CalculateExtent( kXAxis,
-            G4VoxelLimits(), G4AffineTransform(), minX, maxX );
-    this->GetLogicalVolume()->GetSolid()->CalculateExtent( kYAxis,
-            G4VoxelLimits(), G4AffineTransform(), minY, maxY );
-    this->GetLogicalVolume()->GetSolid()->CalculateExtent( kZAxis,
-            G4VoxelLimits(), G4AffineTransform(), minZ, maxZ );
-    
-    //  This sets the required number of "inside" hits as a function of the
-    //  required precision. The precision is only approximately accurate, but
-    //  it should be in the ballpark.
-    G4int targetInsideSamples = volumePrecision;
-    
-    G4double totalSamples = 0;
-    G4int totalSamplesInt = 0;
-    G4double insideSamples = 0;
-    
-    G4ThreeVector position;
-    EInside in;
-    
-    while( insideSamples < targetInsideSamples ) {
-        totalSamples++;
-        totalSamplesInt++;
-        if( totalSamplesInt == 2000000000 )
-            totalSamplesInt = 0;
-        
-		xPos = (maxX - minX)*G4UniformRand() + minX;
-		yPos = (maxY - minY)*G4UniformRand() + minY;
-		zPos = (maxZ - minZ)*G4UniformRand() + minZ;
-        
-		position = G4ThreeVector( xPos, yPos, zPos );
-        in = GetLogicalVolume()->GetSolid()->Inside(position);
-		
-        if( in != kOutside )
-            insideSamples++;
-        
-        if( !(totalSamplesInt%1000000000) ) {
-            G4cout << "Sampled " << totalSamples << " points in "
-                   << GetName() << "," << G4endl;
-            G4cout << "\t" << insideSamples
-                   << " successful hits, need "
-                   << targetInsideSamples << G4endl;
-        }
-    }
-    
-    G4double outerTestVolume = (maxX-minX) * (maxY-minY) * (maxZ-minZ);
-    
-    volume = outerTestVolume * insideSamples / totalSamples;
+    volume = GetSolidVolume( GetLogicalVolume()->GetSolid() );
     
     if( takeOutDaughters ) {
         for( G4int i=0; i<GetLogicalVolume()->GetNoDaughters(); i++ ) {
+            //  A parameterised daughter (e.g., the parameterised grid wires)
+            //  isn't a detector component. Its volume is the sum over its
+            //  copies, each of which has its dimensions set by the
+            //  parameterisation.
+            G4VPhysicalVolume *daughter = GetLogicalVolume()->GetDaughter(i);
+            if( daughter->IsParameterised() ) {
+                G4VPVParameterisation *param = daughter->GetParameterisation();
+                G4VSolid *daughterSolid =
+                        daughter->GetLogicalVolume()->GetSolid();
+                for( G4int j=0; j<daughter->GetMultiplicity(); j++ ) {
+                    daughterSolid->ComputeDimensions( param, j, daughter );
+                    volume -= daughterSolid->GetCubicVolume();
+                }
+                continue;
+            }
+            
             LUXSimDetectorComponent *currentComponent =
                     (LUXSimDetectorComponent*)(
                     GetLogicalVolume()->
@@ -594,6 +781,130 @@ G4double LUXSimDetectorComponent::CalculateVolume(
     return volume;
 }
 
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					GetSolidVolume()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4double LUXSimDetectorComponent::GetSolidVolume( G4VSolid *solid )
+{
+    //  These solids have an exact formula for their volume
+    G4String type = solid->GetEntityType();
+    if( type == "G4Box" || type == "G4Tubs" || type == "G4Cons" ||
+            type == "G4Sphere" || type == "G4Orb" || type == "G4Trd" ||
+            type == "G4Trap" || type == "G4Para" || type == "G4Torus" )
+        return solid->GetCubicVolume();
+    
+    //  Anything else is sampled, unless the same solid has been sampled to
+    //  the same precision before. The key is a hash of the full description
+    //  of the solid, which for boolean solids includes the placement of each
+    //  of their parts. The placement of the component itself doesn't change
+    //  its volume, so it isn't part of the key.
+    std::stringstream description;
+    solid->StreamInfo( description );
+    description << volumePrecision;
+    std::string text = description.str();
+    
+    unsigned long long hash = 14695981039346656037ULL;
+    for( G4int i=0; i<(G4int)text.size(); i++ ) {
+        hash ^= (unsigned char)text[i];
+        hash *= 1099511628211ULL;
+    }
+    std::stringstream key;
+    key << std::hex << hash;
+    
+    if( !volumeCacheLoaded ) {
+        std::ifstream cacheFile( VOLUME_CACHE_FILE );
+        G4String cachedKey;
+        G4double cachedVolume;
+        while( cacheFile >> cachedKey >> cachedVolume )
+            volumeCache[cachedKey] = cachedVolume*mm3;
+        volumeCacheLoaded = true;
+    }
+    
+    std::map<G4String,G4double>::iterator it = volumeCache.find( key.str() );
+    if( it != volumeCache.end() )
+        return it->second;
+    
+    //  Split the sampling into a fixed number of jobs, each seeded from the
+    //  geometry hash and its own index rather than from the main engine. That
+    //  way the estimate doesn't depend on the machine, and the event stream
+    //  doesn't depend on whether the volume was already in the cache. The
+    //  jobs are shared out between threads, except for solids that keep a
+    //  cache of the last point they looked at, which are sampled on one.
+    G4int numThreads = (G4int)sysconf( _SC_NPROCESSORS_ONLN );
+    if( numThreads < 1 ) numThreads = 1;
+    if( numThreads > VOLUME_SAMPLING_JOBS ) numThreads = VOLUME_SAMPLING_JOBS;
+    if( text.find("Polycone") != std::string::npos ||
+            text.find("Polyhedra") != std::string::npos ||
+            text.find("Tessellated") != std::string::npos ||
+            text.find("Twist") != std::string::npos )
+        numThreads = 1;
+    
+    G4double solidMinX, solidMaxX, solidMinY, solidMaxY, solidMinZ, solidMaxZ;
+    solid->CalculateExtent( kXAxis, G4VoxelLimits(), G4AffineTransform(),
+            solidMinX, solidMaxX );
+    solid->CalculateExtent( kYAxis, G4VoxelLimits(), G4AffineTransform(),
+            solidMinY, solidMaxY );
+    solid->CalculateExtent( kZAxis, G4VoxelLimits(), G4AffineTransform(),
+            solidMinZ, solidMaxZ );
+    
+    G4int numJobs = VOLUME_SAMPLING_JOBS;
+    std::vector<volumeSamplingJob> jobs( numJobs );
+    for( G4int i=0; i<numJobs; i++ ) {
+        jobs[i].solid = solid;
+        jobs[i].minXYZ = G4ThreeVector( solidMinX, solidMinY, solidMinZ );
+        jobs[i].maxXYZ = G4ThreeVector( solidMaxX, solidMaxY, solidMaxZ );
+        jobs[i].targetInsideSamples = ceil( (G4double)volumePrecision /
+                numJobs );
+        unsigned long long jobHash = ( hash ^ (i+1) ) * 1099511628211ULL;
+        jobs[i].seed = (long)( jobHash % 2147483646ULL ) + 1;
+        jobs[i].totalSamples = 0;
+        jobs[i].insideSamples = 0;
+    }
+    
+    std::vector<volumeSamplingThread> threadJobs( numThreads );
+    std::vector<pthread_t> threads( numThreads );
+    std::vector<G4bool> threadStarted( numThreads, false );
+    for( G4int i=0; i<numThreads; i++ ) {
+        threadJobs[i].jobs = &jobs[0];
+        threadJobs[i].first = i;
+        threadJobs[i].stride = numThreads;
+        threadJobs[i].numJobs = numJobs;
+    }
+    for( G4int i=1; i<numThreads; i++ )
+        threadStarted[i] = !pthread_create( &threads[i], 0, RunSamplingJobs,
+                &threadJobs[i] );
+    RunSamplingJobs( &threadJobs[0] );
+    for( G4int i=1; i<numThreads; i++ ) {
+        if( threadStarted[i] )
+            pthread_join( threads[i], 0 );
+        else
+            RunSamplingJobs( &threadJobs[i] );
+    }
+    
+    G4double totalSamples = 0;
+    G4double insideSamples = 0;
+    for( G4int i=0; i<numJobs; i++ ) {
+        totalSamples += jobs[i].totalSamples;
+        insideSamples += jobs[i].insideSamples;
+    }
+    
+    G4double outerTestVolume = (solidMaxX - solidMinX) *
+            (solidMaxY - solidMinY) * (solidMaxZ - solidMinZ);
+    G4double solidVolume = outerTestVolume * insideSamples / totalSamples;
+    
+    //  Each result is appended as a single line, so runs sharing the file
+    //  don't interfere with each other
+    volumeCache[key.str()] = solidVolume;
+    std::stringstream line;
+    line.precision( 12 );
+    line << key.str() << " " << solidVolume/mm3 << "\n";
+    std::ofstream cacheFile( VOLUME_CACHE_FILE, std::ios::app );
+    if( cacheFile.is_open() )
+        cacheFile << line.str() << std::flush;
+    
+    return solidVolume;
+}
+
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //					CalculateMass()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -102,6 +102,7 @@
 *   08-Jan-15 - Forced muonVeto to "off" when using LZDetector (Scott Ha.)
 *   02-Fed-15 - Added the DD Neutron source (Kevin)
 *   15-Jul-15 - Added cavern rock (David W)
+*   19-Oct-26 - Grids are also built for the "parameterised" grid wires option
 */
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -365,7 +366,8 @@ G4VPhysicalVolume *LUXSimDetectorConstruction::ConstructDetector()
 	//	Deciding what to do with grids
 
 	G4bool GRIDS = false;		//build grids 
-	if( luxManager->GetGridWiresSelection() == "on") {
+	if( luxManager->GetGridWiresSelection() == "on" ||
+			luxManager->GetGridWiresSelection() == "parameterised" ) {
 		GRIDS = true;
 		G4cout << "Grid wires are on" << G4endl;
 	}
@@ -83,6 +83,12 @@
 
 //  2014-01-04 - Added an if statement to aviod occasional problems with wires having negative 
 //               length.  (Vic)
+
+//  19 Oct 2026 - Wires are now placed through PlaceWire, and with
+//                "/LUXSim/detector/gridWires parameterised" each wire plane is
+//                placed as a single G4PVParameterised (see
+//                LUXSimGridWireParameterisation) instead of one
+//                LUXSimDetectorComponent per wire.
 //
 //	C/C++ includes
 //
@@ -104,12 +110,15 @@
 #include "G4OpticalSurface.hh"
 #include "G4LogicalBorderSurface.hh"
 #include "G4Material.hh"
+#include "G4PVParameterised.hh"
 //
 //	LUXSim includes
 // 
 #include "LUXSimGrid.hh"
 #include "LUXSimDetectorComponent.hh"
 #include "LUXSimMaterials.hh"
+#include "LUXSimManager.hh"
+#include "LUXSimGridWireParameterisation.hh"
 
 
 using namespace std;
@@ -128,6 +137,14 @@ LUXSimGrid::LUXSimGrid( G4double wireRadius,
 	//	Get the LUXSimMaterials pointer
 	LUXSimMaterials *luxMaterials = LUXSimMaterials::GetMaterials();
 
+	//	Build each wire plane as one parameterised volume rather than one
+	//	detector component per wire
+	parameterisedWires = ( LUXSimManager::GetManager()->
+			GetGridWiresSelection() == "parameterised" );
+	wireParameterisation = 0;
+	lastWire_log = 0;
+	lastWireHalfLength = -1.;
+
   G4double GridFrameRCorners[4] = {frameInnerRadius / Cos15deg,   frameOuterRadius / Cos15deg,   frameOuterRadius / Cos15deg,  frameInnerRadius / Cos15deg};
   G4double GridFrameZCorners[4] = {-0.5 * frameHeight,            -0.5 * frameHeight,            0.5 * frameHeight,            0.5 * frameHeight};
 	
@@ -182,9 +199,6 @@ void LUXSimGrid::Place1_0WiresAndFrame(G4double wireSpacing,
 	rotX90Y15->rotateX(90. * deg);
 	rotX90Y15->rotateY(15. * deg);
 	G4int numWires = (int)(2. * wireGridRadius / wireSpacing) + 2;
-	G4Tubs * wire_solid;
-	G4LogicalVolume * wire_log;
-	LUXSimDetectorComponent * wire;
 	if (gridMother->GetName().compare("LiquidXenon") == 0)
 	  holder = new LUXSimDetectorComponent(0, G4ThreeVector(xOff,yOff,zOff), "LiquidHolderXenon",
 	                                       holder_log, gridMother, 0, 0, false);
@@ -199,18 +213,17 @@ void LUXSimGrid::Place1_0WiresAndFrame(G4double wireSpacing,
 	                                    frameMother, 0, 0, false);
 	zOff = 0. * cm;
 	cout << "Starting placement of " << numWires << " wires into " << gridMother->GetName() << endl;
-	wire_solid = new G4Tubs("wire_solid", 0. * cm, wireRadius, wireGridRadius - (WireCheat_mm * mm), 0. * deg, 360. * deg);
-	wire_log = new G4LogicalVolume(wire_solid, luxMaterials->Steel(), "wire_log");
-	wire = new LUXSimDetectorComponent(rotX90Y15, G4ThreeVector(xOff,yOff,zOff),
-	                                   "Wire", wire_log, holder, 0, 0, false);
-	G4double side = wireGridRadius / (1. + (sqrt(3.) / 2.));
 	//	Add reflective surface to grid wharrs
-	G4LogicalBorderSurface *gridXeSurface;
+	G4OpticalSurface *gridXeOpSurface;
 	if(gridMother->GetName().compare("LiquidXenon") == 0){
-    gridXeSurface = new G4LogicalBorderSurface("gridXeSurface", holder, wire, luxMaterials->LXeSteelSurface());
+	  gridXeOpSurface = luxMaterials->LXeSteelSurface();
 	}else{
-	  gridXeSurface = new G4LogicalBorderSurface("gridXeSurface", holder, wire, luxMaterials->GXeSteelSurface());
-  }
+	  gridXeOpSurface = luxMaterials->GXeSteelSurface();
+	}
+	StartWires(rotX90Y15);
+	PlaceWire(rotX90Y15, G4ThreeVector(xOff,yOff,zOff), wireGridRadius - (WireCheat_mm * mm),
+	          wireRadius, "Wire", gridXeOpSurface);
+	G4double side = wireGridRadius / (1. + (sqrt(3.) / 2.));
 	for(int n = 1; n < numWires / 2; n++){
 		xOff = n * wireSpacing;
 		yOff = 0. * cm;
@@ -225,32 +238,20 @@ void LUXSimGrid::Place1_0WiresAndFrame(G4double wireSpacing,
 		wireLength -= 3.4 * wireRadius;
 		wireLength -= (10. * um); //Subtract 10 um off every wire, not just the first one...
 		if (wireLength > 0.){
-		  wire_solid = new G4Tubs("wire_solid", 0. * cm, wireRadius, (0.5 * wireLength) - (WireCheat_mm * mm), 0. * deg, 360. * deg);
-		  wire_log = new G4LogicalVolume(wire_solid, luxMaterials->Steel(), "wire_log");
+		  G4double wireHalfLength = (0.5 * wireLength) - (WireCheat_mm * mm);
 
 		  G4double xOff_prime =  xOff * cos(-15. * deg) + yOff * sin(-15. * deg);
 		  G4double yOff_prime = -xOff * sin(-15. * deg) + yOff * cos(-15. * deg);
-		  wire = new LUXSimDetectorComponent(rotX90Y15, G4ThreeVector(xOff_prime,yOff_prime,zOff),
-		                                     "Wire", wire_log, holder, 0, 0, false);
-		  // Add reflective surface to grid wharrs
-		  if(gridMother->GetName().compare("LiquidXenon") == 0 ){
-		    gridXeSurface = new G4LogicalBorderSurface("gridXeSurface", holder, wire, luxMaterials->LXeSteelSurface());
-		  }else{
-            gridXeSurface = new G4LogicalBorderSurface("gridXeSurface", holder, wire, luxMaterials->GXeSteelSurface());
-          }
+		  PlaceWire(rotX90Y15, G4ThreeVector(xOff_prime,yOff_prime,zOff), wireHalfLength,
+		            wireRadius, "Wire", gridXeOpSurface);
 		  xOff_prime =  xOff * cos(15. * deg) + yOff * sin(15. * deg);
 		  yOff_prime = -xOff * sin(15. * deg) + yOff * cos(15. * deg);
-		  wire = new LUXSimDetectorComponent(rotX90Y15, G4ThreeVector(-xOff_prime, yOff_prime, zOff),
-		                                     "Wire", wire_log, holder, 0, 0, false);
-		  // Add reflective surface to grid wharrs
-		  if(gridMother->GetName().compare("LiquidXenon") == 0){
-		    gridXeSurface = new G4LogicalBorderSurface("gridXeSurface", holder, wire, luxMaterials->LXeSteelSurface());
-		  }else{
-		    gridXeSurface = new G4LogicalBorderSurface("gridXeSurface", holder, wire, luxMaterials->GXeSteelSurface());
-		  }
+		  PlaceWire(rotX90Y15, G4ThreeVector(-xOff_prime, yOff_prime, zOff), wireHalfLength,
+		            wireRadius, "Wire", gridXeOpSurface);
 		}
 		if(n % 100 == 0) cout << "Placing wire number " << n + 1 << endl;
 	}
+	FinishWires("Wire", wireRadius, gridXeOpSurface);
 }
 
 void LUXSimGrid::Place1_0MeshWires(G4double wireSpacing, G4double wireRadius, G4double wireGridRadius){
@@ -262,19 +263,13 @@ void LUXSimGrid::Place1_0MeshWires(G4double wireSpacing, G4double wireRadius, G4
 	rotY90X15->rotateY(90. * deg);
 	rotY90X15->rotateX(15. * deg);
 	G4int numWires = (int)(2. * wireGridRadius / wireSpacing) + 2;
-	G4Tubs * wire_solid;
-	G4LogicalVolume * wire_log;
-	LUXSimDetectorComponent * wire;
 	cout << "Starting mesh wire placement...\n";
-	wire_solid = new G4Tubs("wire_solid", 0. * cm, wireRadius, wireGridRadius - (WireCheat_mm * mm), 0. * deg, 360. * deg);
-	wire_log = new G4LogicalVolume(wire_solid, luxMaterials->Steel(), "wire_log");
-	wire = new LUXSimDetectorComponent(rotY90X15, G4ThreeVector(xOff,yOff,zOff), "MeshWire",
-	                                   wire_log,holder,	0, 0, false);
-	G4double side = wireGridRadius / (1. + (sqrt(3.) / 2.));
 	//	*** NOTE *** always assuming that the mesh grid (i.e. anode) is in gas...
-	G4LogicalBorderSurface *gridXeSurface;
-	gridXeSurface = new G4LogicalBorderSurface("gridXeSurface", holder, wire, 
-	                                           luxMaterials->GXeSteelSurface());
+	G4OpticalSurface *gridXeOpSurface = luxMaterials->GXeSteelSurface();
+	StartWires(rotY90X15);
+	PlaceWire(rotY90X15, G4ThreeVector(xOff,yOff,zOff), wireGridRadius - (WireCheat_mm * mm),
+	          wireRadius, "MeshWire", gridXeOpSurface);
+	G4double side = wireGridRadius / (1. + (sqrt(3.) / 2.));
 	for(int n = 1; n < numWires / 2; n++){
 		yOff = n * wireSpacing;
 		xOff = 0. * cm;
@@ -288,23 +283,19 @@ void LUXSimGrid::Place1_0MeshWires(G4double wireSpacing, G4double wireRadius, G4
 		}
 		wireLength -= 0.2 * mm;
 		if (wireLength > 0.){
-		  wire_solid = new G4Tubs("wire_solid", 0. * cm, wireRadius, (0.5 * wireLength) - (WireCheat_mm * mm), 0. * deg, 360. * deg);
-		  wire_log = new G4LogicalVolume(wire_solid, luxMaterials->Steel(), "wire_log");
+		  G4double wireHalfLength = (0.5 * wireLength) - (WireCheat_mm * mm);
 		  G4double xOff_prime =  xOff * cos(15. * deg) + yOff * sin(15. * deg);
 		  G4double yOff_prime = -xOff * sin(15. * deg) + yOff * cos(15. * deg);
-		  wire = new LUXSimDetectorComponent(rotY90X15, G4ThreeVector(xOff_prime,yOff_prime,zOff),
-		                                     "MeshWire", wire_log, holder, 0, 0, false);
-		  gridXeSurface = new G4LogicalBorderSurface("gridXeSurface", holder, wire, 
-		                                             luxMaterials->GXeSteelSurface());
+		  PlaceWire(rotY90X15, G4ThreeVector(xOff_prime,yOff_prime,zOff), wireHalfLength,
+		            wireRadius, "MeshWire", gridXeOpSurface);
 		  xOff_prime =  xOff * cos(-15. * deg) + yOff * sin(-15. * deg);
 		  yOff_prime = -xOff * sin(-15. * deg) + yOff * cos(-15. * deg);
-		  wire = new LUXSimDetectorComponent(rotY90X15, G4ThreeVector(xOff_prime,-yOff_prime,zOff),
-		                                     "MeshWire", wire_log, holder, 0, 0, false);
-		  gridXeSurface = new G4LogicalBorderSurface("gridXeSurface", holder, wire, 
-		                                             luxMaterials->GXeSteelSurface());
+		  PlaceWire(rotY90X15, G4ThreeVector(xOff_prime,-yOff_prime,zOff), wireHalfLength,
+		            wireRadius, "MeshWire", gridXeOpSurface);
 		}
 		if(n % 100 == 0) cout << "Placing wire number " << n + 1 << endl;			
 	}
+	FinishWires("MeshWire", wireRadius, gridXeOpSurface);
 }
 
 void LUXSimGrid::Place0_1WiresAndFrame(G4double wireSpacing, G4double wireRadius, 
@@ -318,11 +309,6 @@ void LUXSimGrid::Place0_1WiresAndFrame(G4double wireSpacing, G4double wireRadius
 
 	G4int numWires = (int)(2.*frameInnerRadius/wireSpacing)+2;
 
-	
-	G4Tubs * wire_solid;
-	G4LogicalVolume * wire_log;
-	LUXSimDetectorComponent * wire;
-
 	holder = new LUXSimDetectorComponent(0,G4ThreeVector(xOff,yOff,zOff),
 			"Holder",holder_log,mother,0,0,false);
 	frame = new LUXSimDetectorComponent(0,G4ThreeVector(xOff,yOff,zOff),
@@ -331,21 +317,14 @@ void LUXSimGrid::Place0_1WiresAndFrame(G4double wireSpacing, G4double wireRadius
 	zOff = 0.*cm;
 	cout << "Starting wire placement, this could take a while...\n";
 
-	wire_solid = new G4Tubs("wire_solid",0.*cm,wireRadius,
-			frameInnerRadius,0.*deg,360.*deg);
-	wire_log = new G4LogicalVolume(wire_solid,
-			luxMaterials->Steel(),"wire_log");
-	wire = new LUXSimDetectorComponent(rotX90,
-			G4ThreeVector(xOff,yOff,zOff),"Wire",wire_log,holder,	
-			0,0,false);
-
 	G4OpticalSurface *gridXeOpSurface = new G4OpticalSurface(
 			"gridXeOpSurface", unified, polished, dielectric_metal );
 	gridXeOpSurface->SetMaterialPropertiesTable( 
 			luxMaterials->BeCu()->GetMaterialPropertiesTable() );
-	G4LogicalBorderSurface *gridXeSurface;
-	gridXeSurface = new G4LogicalBorderSurface("gridXeSurface",
-			holder,wire,gridXeOpSurface);
+
+	StartWires(rotX90);
+	PlaceWire(rotX90,G4ThreeVector(xOff,yOff,zOff),frameInnerRadius,
+			wireRadius,"Wire",gridXeOpSurface);
 
 	for(int n=1; n<numWires/2; n++){
 		xOff = n*wireSpacing;
@@ -354,23 +333,12 @@ void LUXSimGrid::Place0_1WiresAndFrame(G4double wireSpacing, G4double wireRadius
 		wireLength = sqrt(pow(frameInnerRadius,2)-pow(xOff,2));
 		wireLength -= 0.2*mm;
 
-		wire_solid = new G4Tubs("wire_solid",0.*cm,wireRadius,
-				wireLength,0.*deg,360.*deg);
-		wire_log = new G4LogicalVolume(wire_solid,
-				luxMaterials->Steel(),"wire_log");
-
-		wire = new LUXSimDetectorComponent(rotX90,
-				G4ThreeVector(xOff,yOff,zOff),"Wire",wire_log,holder,
-				0,0,false);
-		gridXeSurface = new G4LogicalBorderSurface("gridXeSurface",
-				holder,wire,gridXeOpSurface);
-
-		wire = new LUXSimDetectorComponent(rotX90,
-				G4ThreeVector(-xOff,yOff,zOff),"Wire",wire_log,holder,
-				0,0,false);
-		gridXeSurface = new G4LogicalBorderSurface("gridXeSurface",
-				holder,wire,gridXeOpSurface);
+		PlaceWire(rotX90,G4ThreeVector(xOff,yOff,zOff),wireLength,
+				wireRadius,"Wire",gridXeOpSurface);
+		PlaceWire(rotX90,G4ThreeVector(-xOff,yOff,zOff),wireLength,
+				wireRadius,"Wire",gridXeOpSurface);
 	}
+	FinishWires("Wire",wireRadius,gridXeOpSurface);
 
 }
 
@@ -385,26 +353,16 @@ void LUXSimGrid::Place0_1MeshWires(G4double wireSpacing,
 	rotY90->rotateY(90.*deg);
 	G4int numWires = (int)(2.*frameInnerRadius/wireSpacing)+2;
 
-	G4Tubs * wire_solid;
-	G4LogicalVolume * wire_log;
-	LUXSimDetectorComponent * wire;
-
 	cout << "Starting mesh wire placement, this could take a while\n";
-	wire_solid = new G4Tubs("wire_solid",0.*cm,wireRadius,
-			frameInnerRadius,0.*deg,360.*deg);
-	wire_log = new G4LogicalVolume(wire_solid,
-			luxMaterials->Steel(),"wire_log");
-	wire = new LUXSimDetectorComponent(rotY90,
-			G4ThreeVector(xOff,yOff,zOff),"MeshWire",wire_log,holder,	
-			0,0,false);
 	
 	G4OpticalSurface *gridXeOpSurface = new G4OpticalSurface(
 			"gridXeOpSurface", unified, polished, dielectric_metal );
 	gridXeOpSurface->SetMaterialPropertiesTable( 
 			luxMaterials->BeCu()->GetMaterialPropertiesTable() );
-	G4LogicalBorderSurface *gridXeSurface;
-	gridXeSurface = new G4LogicalBorderSurface("gridXeSurface",
-			holder,wire,gridXeOpSurface);
+
+	StartWires(rotY90);
+	PlaceWire(rotY90,G4ThreeVector(xOff,yOff,zOff),frameInnerRadius,
+			wireRadius,"MeshWire",gridXeOpSurface);
 
 	for(int n=1; n<numWires/2; n++){
 		yOff = n*wireSpacing;
@@ -412,24 +370,85 @@ void LUXSimGrid::Place0_1MeshWires(G4double wireSpacing,
 		G4double wireLength = 0.*cm;
 		wireLength = sqrt(pow(frameInnerRadius,2) - pow(yOff,2));
 		wireLength -= 0.2*mm;
-		wire_solid = new G4Tubs("wire_solid",0.*cm,wireRadius,
-				wireLength,0.*deg,360.*deg);
-		wire_log = new G4LogicalVolume(wire_solid,
-				luxMaterials->Steel(),"wire_log");
-
-		wire = new LUXSimDetectorComponent(rotY90,
-				G4ThreeVector(xOff,yOff,zOff),"MeshWire",wire_log,holder,
-				0,0,false);
-		gridXeSurface = new G4LogicalBorderSurface("gridXeSurface",
-				holder,wire,gridXeOpSurface);
-
-		wire = new LUXSimDetectorComponent(rotY90,
-				G4ThreeVector(xOff,-yOff,zOff),"MeshWire",wire_log,holder,
-				0,0,false);
-		gridXeSurface = new G4LogicalBorderSurface("gridXeSurface",
-				holder,wire,gridXeOpSurface);
+
+		PlaceWire(rotY90,G4ThreeVector(xOff,yOff,zOff),wireLength,
+				wireRadius,"MeshWire",gridXeOpSurface);
+		PlaceWire(rotY90,G4ThreeVector(xOff,-yOff,zOff),wireLength,
+				wireRadius,"MeshWire",gridXeOpSurface);
 			
 	}
+	FinishWires("MeshWire",wireRadius,gridXeOpSurface);
+}
+
+//------++++++------++++++------+++++------++++++------++++++------++++++------
+//								StartWires
+//------++++++------++++++------+++++------++++++------++++++------++++++------
+void LUXSimGrid::StartWires(G4RotationMatrix * rot){
+	//	All wires in a plane share the rotation, so it's given to the
+	//	parameterisation up front
+	lastWire_log = 0;
+	lastWireHalfLength = -1.;
+	if(parameterisedWires)
+		wireParameterisation = new LUXSimGridWireParameterisation(rot);
+}
+
+//------++++++------++++++------+++++------++++++------++++++------++++++------
+//								PlaceWire
+//------++++++------++++++------+++++------++++++------++++++------++++++------
+void LUXSimGrid::PlaceWire(G4RotationMatrix * rot,
+						   G4ThreeVector pos,
+						   G4double wireHalfLength,
+						   G4double wireRadius,
+						   G4String wireName,
+						   G4OpticalSurface * surface){
+	if(parameterisedWires){
+		wireParameterisation->AddWire(pos, wireHalfLength);
+		return;
+	}
+
+	LUXSimMaterials *luxMaterials = LUXSimMaterials::GetMaterials();
+
+	//	Wires are placed in symmetric pairs, and the two wires of a pair share
+	//	a logical volume
+	if(!lastWire_log || wireHalfLength != lastWireHalfLength){
+		G4Tubs * wire_solid = new G4Tubs("wire_solid", 0. * cm, wireRadius,
+				wireHalfLength, 0. * deg, 360. * deg);
+		lastWire_log = new G4LogicalVolume(wire_solid, luxMaterials->Steel(),
+				"wire_log");
+		lastWireHalfLength = wireHalfLength;
+	}
+	LUXSimDetectorComponent * wire = new LUXSimDetectorComponent(rot, pos,
+			wireName, lastWire_log, holder, 0, 0, false);
+	new G4LogicalBorderSurface("gridXeSurface", holder, wire, surface);
+}
+
+//------++++++------++++++------+++++------++++++------++++++------++++++------
+//								FinishWires
+//------++++++------++++++------+++++------++++++------++++++------++++++------
+void LUXSimGrid::FinishWires(G4String wireName,
+							 G4double wireRadius,
+							 G4OpticalSurface * surface){
+	if(!parameterisedWires)
+		return;
+
+	//	One G4PVParameterised for the whole plane. The solid is given the
+	//	longest wire's length, and each copy is resized by the
+	//	parameterisation. The copy number is the wire's index in the order the
+	//	wires were placed above.
+	LUXSimMaterials *luxMaterials = LUXSimMaterials::GetMaterials();
+	G4int numWires = wireParameterisation->GetNumWires();
+	G4Tubs * wire_solid = new G4Tubs("wire_solid", 0. * cm, wireRadius,
+			wireParameterisation->GetMaxHalfLength(), 0. * deg, 360. * deg);
+	G4LogicalVolume * wire_log = new G4LogicalVolume(wire_solid,
+			luxMaterials->Steel(), "wire_log");
+	G4VPhysicalVolume * wires = new G4PVParameterised(wireName, wire_log,
+			holder->GetLogicalVolume(), kUndefined, numWires,
+			wireParameterisation);
+	new G4LogicalBorderSurface("gridXeSurface", holder, wires, surface);
+
+	cout << "Placed " << numWires << " wires as one parameterised volume in "
+	     << holder->GetName() << endl;
+	wireParameterisation = 0;
 }
 
 //------++++++------++++++------+++++------++++++------++++++------++++++------
@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////
+/*	LUXSimGridWireParameterisation.cc
+*
+* This is the code file for the grid wire parameterisation. See the header file
+* for a description.
+*
+********************************************************************************
+* Change log
+*	19-Oct-26 - Initial submission
+*
+*/
+////////////////////////////////////////////////////////////////////////////////
+
+//
+//	GEANT4 includes
+//
+#include "G4VPhysicalVolume.hh"
+#include "G4Tubs.hh"
+
+//
+//	LUXSim includes
+//
+#include "LUXSimGridWireParameterisation.hh"
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//				LUXSimGridWireParameterisation()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+LUXSimGridWireParameterisation::LUXSimGridWireParameterisation(
+		G4RotationMatrix *rot )
+{
+	rotation = rot;
+	positions.clear();
+	halfLengths.clear();
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//				~LUXSimGridWireParameterisation()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+LUXSimGridWireParameterisation::~LUXSimGridWireParameterisation() {}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					AddWire()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimGridWireParameterisation::AddWire( G4ThreeVector position,
+		G4double halfLength )
+{
+	positions.push_back( position );
+	halfLengths.push_back( halfLength );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					GetMaxHalfLength()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4double LUXSimGridWireParameterisation::GetMaxHalfLength()
+{
+	G4double maxHalfLength = 0;
+	for( G4int i=0; i<(G4int)halfLengths.size(); i++ )
+		if( halfLengths[i] > maxHalfLength )
+			maxHalfLength = halfLengths[i];
+
+	return maxHalfLength;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					ComputeTransformation()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimGridWireParameterisation::ComputeTransformation( const G4int copyNo,
+		G4VPhysicalVolume *physVol ) const
+{
+	physVol->SetTranslation( positions[copyNo] );
+	physVol->SetRotation( rotation );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					ComputeDimensions()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimGridWireParameterisation::ComputeDimensions( G4Tubs &wire,
+		const G4int copyNo, const G4VPhysicalVolume* ) const
+{
+	wire.SetZHalfLength( halfLengths[copyNo] );
+}
@@ -54,6 +54,9 @@
 //		    created here as well. (Scott Ha.)
 //  12 Jun 15 - Added Side skin PMT banks (Jeremy M.)
 //      03 Sep 15 - Added photoneutron pig. (Kevin)
+//  19 Oct 26 - With useGrids="parameterised", each grid plane (or mesh
+//              sub-holder) is placed as a single G4PVParameterised instead of
+//              one LUXSimDetectorComponent per wire
 //					
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -81,6 +84,7 @@
 #include "G4UnionSolid.hh"
 #include "G4OpticalSurface.hh"
 #include "G4LogicalBorderSurface.hh"
+#include "G4PVParameterised.hh"
 
 //
 //      LUXSim includes
@@ -92,6 +96,7 @@
 #include "LUXSimLZWaterPMTBank.hh"
 #include "LUXSimLZSkinPMTBank.hh"
 #include "LUXSimManager.hh"
+#include "LUXSimGridWireParameterisation.hh"
 //
 //		Definitions
 //
@@ -3043,7 +3048,14 @@ LUXSimLZDetector::LUXSimLZDetector( G4double liquidHeight, G4String useGrids )
     //  that code since it's working, so I'm just going to roll my own grids
     //  here.
     //
-    if( useGrids == "on" ) {
+    //  With useGrids set to "parameterised", the wire positions and lengths
+    //  are worked out exactly as below, but instead of a separate volume per
+    //  wire, each holder (or each mesh sub-holder) gets one parameterised
+    //  volume containing all its wires.
+    //
+    if( useGrids == "on" || useGrids == "parameterised" ) {
+    
+        G4bool parameterisedWires = ( useGrids == "parameterised" );
     
         time_t startTime, endTime;
         time( &startTime );
@@ -3265,10 +3277,23 @@ LUXSimLZDetector::LUXSimLZDetector( G4double liquidHeight, G4String useGrids )
             G4cout << "\t" << numWires << " wires for " << holderName[i]
                    << "..." << endl;
 
-            gridWire_solid[i] = new G4Tubs*[numWires];
-            gridWire_log[i] = new G4LogicalVolume*[numWires];
-            gridWire[i] = new LUXSimDetectorComponent*[numWires];
-            gridWire_surface[i] = new G4LogicalBorderSurface*[numWires];
+            if( !parameterisedWires ) {
+                gridWire_solid[i] = new G4Tubs*[numWires];
+                gridWire_log[i] = new G4LogicalVolume*[numWires];
+                gridWire[i] = new LUXSimDetectorComponent*[numWires];
+                gridWire_surface[i] = new G4LogicalBorderSurface*[numWires];
+            }
+            
+            //  One parameterisation per holder, or per sub-holder for the
+            //  meshes
+            LUXSimGridWireParameterisation *gridWireParam[4];
+            G4int numParams = 0;
+            if( parameterisedWires ) {
+                numParams = ( i == 1 || i == 3 ) ? 4 : 1;
+                for( G4int k=0; k<numParams; k++ )
+                    gridWireParam[k] =
+                            new LUXSimGridWireParameterisation( rotX90 );
+            }
             
             //  If we're dealing with the mesh, reduce the number of wires by
             //  a factor of 2 to have the proper calculation of the X offset for
@@ -3307,6 +3332,12 @@ LUXSimLZDetector::LUXSimLZDetector( G4double liquidHeight, G4String useGrids )
                     if( i == 1 || i == 3)
                         wireIndex = j*4 + k;
                 
+                    if( parameterisedWires ) {
+                        gridWireParam[k]->AddWire(
+                                G4ThreeVector(xOffset,0,zOffset), wireLength );
+                        continue;
+                    }
+
                     if( !(wireIndex%100) ) {
                         time( &endTime );
                         G4cout << "\t\tPlaced " << wireIndex << " grid wires ("
@@ -3367,6 +3398,45 @@ LUXSimLZDetector::LUXSimLZDetector( G4double liquidHeight, G4String useGrids )
                 
                 xOffset += wireSpacing[i];
             }
+            
+            //  Place the parameterised wire planes. The copy number of each
+            //  wire is its index within that holder or sub-holder.
+            for( G4int k=0; k<numParams; k++ ) {
+                LUXSimDetectorComponent *wireMother = gridHolder[i];
+                if( i == 1 )
+                    wireMother = anodeSubHolder[k];
+                else if( i == 3 )
+                    wireMother = cathodeSubHolder[k];
+                
+                name.str("");
+                name << wireName[i] << "GridWires_" << k+1 << "_solid";
+                G4Tubs *gridWires_solid = new G4Tubs( name.str(), 0,
+                        wireDiameter[i]/2, gridWireParam[k]->GetMaxHalfLength(),
+                        0.*deg, 360.*deg );
+                
+                name.str("");
+                name << wireName[i] << "GridWires_" << k+1 << "_log";
+                G4LogicalVolume *gridWires_log = new G4LogicalVolume(
+                        gridWires_solid, luxMaterials->Steel(), name.str() );
+                gridWires_log->SetVisAttributes( luxMaterials->SteelVis() );
+                
+                name.str("");
+                name << wireName[i] << "GridWires";
+                if( numParams > 1 )
+                    name << "_" << k+1;
+                G4VPhysicalVolume *gridWires = new G4PVParameterised(
+                        name.str(), gridWires_log,
+                        wireMother->GetLogicalVolume(), kUndefined,
+                        gridWireParam[k]->GetNumWires(), gridWireParam[k] );
+                
+                name.str("");
+                name << wireName[i] << "GridWiresSurface_" << k+1;
+                new G4LogicalBorderSurface( name.str(), wireMother, gridWires,
+                        gridOpticalSurface[i] );
+                
+                G4cout << "\t\tPlaced " << gridWireParam[k]->GetNumWires()
+                       << " wires as " << gridWires->GetName() << G4endl;
+            }
         }
         
         time( &endTime );
@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////
+/*	LUXSimLightMap.hh
+*
+* This is the header file for the light collection map builder. Instead of
+* running a separate LUXSim job for every photon bomb position (see
+* tools/photonBomb.sh), the builder runs one event per emission point in a
+* single job, so the geometry, materials and physics tables are only set up
+* once.
+*
+* Each event fires a fixed number of optical photons isotropically from one
+* point. The photons that are converted at each photocathode (by
+* LUXSimQuantumEfficiency) are counted, and at the end of the event a line is
+* written to the map file with the fraction of photons detected by each of the
+* 122 PMTs, in the line format of the FastSim library files:
+*
+*	x y z isS1 positionID probability[122]
+*
+* with x, y and z in mm.
+*
+* The emission points are either a regular x-y-z grid (/LUXSim/lightMap/grid),
+* or the points of an existing FastSim library (/LUXSim/lightMap/samples), in
+* which case the map can be used in place of that library. Only a map built
+* from samples can be loaded by LUXSimFastSim: it has a fixed number of
+* position IDs (numIDs) and z levels, and a grid generally has neither. Points
+* on a grid get position IDs that count across x and then y, starting from 1,
+* and are all flagged as S1, so a grid map is for other tools that read the
+* same line format, not a FastSim library.
+*
+* A build can be split into shards (/LUXSim/lightMap/shard), each of which
+* takes every n-th point and writes its own file, and the shard files can just
+* be concatenated. A build is also resumable: the points already in the file
+* are skipped, so a job that was stopped can be restarted with the same
+* macro. Each line is flushed as soon as it is written, and a line that was
+* cut short is dropped when the build restarts.
+*
+********************************************************************************
+* Change log
+*	19-Oct-26 - Initial submission
+*	19-Oct-26 - Made clear that only maps built from samples are FastSim
+*				libraries
+*	19-Oct-26 - AddDetection takes a count, for weighted photons
+*
+*/
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LUXSimLightMap_HH
+#define LUXSimLightMap_HH 1
+
+//
+//	C/C++ includes
+//
+#include <fstream>
+#include <vector>
+
+//
+//	GEANT4 includes
+//
+#include "globals.hh"
+
+//
+//	Class forwarding
+//
+class G4Event;
+class LUXSimManager;
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+class LUXSimLightMap
+{
+	public:
+		LUXSimLightMap();
+		~LUXSimLightMap();
+
+	public:
+		void SetGrid( G4String );
+		void SetSamples( G4String );
+		void SetNumPhotons( G4int num ) { numPhotons = num; };
+		void SetPhotonEnergy( G4double energy ) { photonEnergy = energy; };
+		void SetShard( G4String );
+		void SetFileName( G4String name ) { fileName = name; };
+
+		//	BeginBuild returns the number of points still to do in this shard,
+		//	which is the number of events to run
+		G4int BeginBuild();
+		void EndBuild();
+		G4bool IsBuilding() { return building; };
+
+		void GeneratePrimaries( G4Event* );
+		void AddDetection( G4int pmtIndex, G4int count = 1 ) {
+			if( pmtIndex >= 0 && pmtIndex < (G4int)detections.size() )
+				detections[pmtIndex] += count;
+		};
+		void EndOfEvent();
+
+	private:
+		struct emissionPoint {
+			G4double x, y, z;
+			G4bool isS1;
+			G4int positionID;
+		};
+
+		G4String GetKey( const emissionPoint& );
+		G4String GetShardFileName();
+		void ReadDoneKeys( G4String, std::vector<G4String>& );
+
+	private:
+		LUXSimManager *luxManager;
+
+		std::vector<emissionPoint> points;
+		G4int numPhotons;
+		G4double photonEnergy;
+		G4int shardIndex;
+		G4int numShards;
+		G4String fileName;
+
+		G4bool building;
+		std::vector<G4int> pendingPoints;
+		G4int nextPending;
+		G4int currentPoint;
+		std::vector<G4int> detections;
+		std::ofstream mapFile;
+};
+
+#endif
@@ -18,6 +18,8 @@
 *				  levels 2-4 and optical record levels 3 and 4 (Kareem)
 *   02 Aug 2013 - Superstitiously changed the order of includes (Kareem)
 *   20 Aug 2015 - Added the step process to the output file (Kareem)
+*   19 Oct 2026 - Added GetBytesWritten for the progress report
+*   19 Oct 2026 - Added the optical path record, which goes to its own file
 */
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -33,15 +35,20 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <map>
 //
 //	GEANT4 includes
 //
 #include "globals.hh"
 
+//
+//	LUXSim includes
+//
+#include "LUXSimManager.hh"
+
 //
 //	Class forwarding
 //
-class LUXSimManager;
 class LUXSimDetectorComponent;
 
 using namespace std;
@@ -56,7 +63,12 @@ class LUXSimOutput
 	public:
 		void RecordEventByVolume( LUXSimDetectorComponent*, G4int );
 		void RecordInputHistory();	
+		G4double GetBytesWritten() { return (G4double)fLUXOutput.tellp(); };
+		void RecordOpticalPath( const LUXSimManager::opticalPathRecord& );
 	
+	private:
+		G4int GetOptPathIndex( G4int, G4String, map<G4String,G4int>& );
+
 	private:
 		LUXSimManager *luxManager;
 		
@@ -110,6 +122,11 @@ class LUXSimOutput
 		G4double primaryParPos_mm[3];
 		G4double primaryParDir[3];
 
+		G4String fOptPathName;
+		ofstream fOptPathOutput;
+		map<G4String,G4int> optPathMaterials;
+		map<G4String,G4int> optPathSurfaces;
+		G4int numOptPathRecords;
 };
 
 #endif
@@ -0,0 +1,371 @@
+////////////////////////////////////////////////////////////////////////////////
+/*	LUXSimLightMap.cc
+*
+* This is the code file for the light collection map builder. See the header
+* file for a description of the build and the map format.
+*
+********************************************************************************
+* Change log
+*	19-Oct-26 - Initial submission
+*	19-Oct-26 - SetGrid says that a grid map isn't a FastSim library
+*
+*/
+////////////////////////////////////////////////////////////////////////////////
+
+//
+//	C/C++ includes
+//
+#include <sstream>
+#include <iomanip>
+#include <set>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+//
+//	GEANT4 includes
+//
+#include "G4Event.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4UIcommand.hh"
+#include "Randomize.hh"
+
+//
+//	LUXSim includes
+//
+#include "LUXSimLightMap.hh"
+#include "LUXSimManager.hh"
+
+//
+//	Definitions
+//
+#define NUM_PMTS 122	//	the number of PMTs in a FastSim library line
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					LUXSimLightMap()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+LUXSimLightMap::LUXSimLightMap()
+{
+	luxManager = LUXSimManager::GetManager();
+	luxManager->Register( this );
+
+	numPhotons = 10000;
+	photonEnergy = 7.*eV;
+	shardIndex = 0;
+	numShards = 1;
+	fileName = "LUXSimLightMap.dat";
+
+	building = false;
+	nextPending = 0;
+	currentPoint = -1;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					~LUXSimLightMap()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+LUXSimLightMap::~LUXSimLightMap()
+{
+	if( mapFile.is_open() )
+		mapFile.close();
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					SetGrid()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimLightMap::SetGrid( G4String info )
+{
+	//	The minimum, maximum and number of points along x, then y, then z,
+	//	and the unit (mm if there's none)
+	std::istringstream input( info );
+	G4double min[3], max[3];
+	G4int num[3];
+	G4String unit = "mm";
+	for( G4int axis=0; axis<3; axis++ )
+		input >> min[axis] >> max[axis] >> num[axis];
+	G4bool valid = !input.fail();
+	input >> unit;
+	for( G4int axis=0; axis<3; axis++ )
+		if( num[axis] < 1 || max[axis] < min[axis] )
+			valid = false;
+	if( !valid ) {
+		G4cout << G4endl << G4endl << G4endl;
+		G4cout << "The light map grid needs the minimum, maximum and number of "
+			   << "points along x, y and z," << G4endl
+			   << "then the unit, e.g. \"-240 240 49 -240 240 49 10 540 53 "
+			   << "mm\" (got \"" << info << "\")" << G4endl;
+		G4cout << G4endl << G4endl << G4endl;
+		exit(0);
+	}
+
+	G4double unitValue = G4UIcommand::ValueOf( unit.c_str() );
+	G4double step[3];
+	for( G4int axis=0; axis<3; axis++ )
+		step[axis] = ( num[axis] > 1 ?
+				( max[axis] - min[axis] ) / ( num[axis] - 1 ) : 0 );
+
+	points.clear();
+	emissionPoint point;
+	point.isS1 = true;
+	for( G4int k=0; k<num[2]; k++ )
+		for( G4int j=0; j<num[1]; j++ )
+			for( G4int i=0; i<num[0]; i++ ) {
+				point.x = ( min[0] + i*step[0] )*unitValue;
+				point.y = ( min[1] + j*step[1] )*unitValue;
+				point.z = ( min[2] + k*step[2] )*unitValue;
+				point.positionID = j*num[0] + i + 1;
+				points.push_back( point );
+			}
+
+	G4cout << "Light map grid of " << points.size() << " points" << G4endl;
+	G4cout << "Note: a grid map uses the FastSim line format, but can't be "
+		   << "loaded as a FastSim library." << G4endl
+		   << "Use /LUXSim/lightMap/samples for that." << G4endl;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					SetSamples()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimLightMap::SetSamples( G4String libraryName )
+{
+	std::ifstream library( libraryName.c_str() );
+	if( !library.is_open() ) {
+		G4cout << G4endl << G4endl << G4endl;
+		G4cout << "Light map sample library File Not Found! " << libraryName
+			   << G4endl;
+		G4cout << G4endl << G4endl << G4endl;
+		exit(0);
+	}
+
+	points.clear();
+	emissionPoint point;
+	G4double probability;
+	while( library >> point.x >> point.y >> point.z >> point.isS1 >>
+			point.positionID ) {
+		for( G4int i=0; i<NUM_PMTS; i++ )
+			library >> probability;
+		if( library.fail() )
+			break;
+		point.x *= mm;
+		point.y *= mm;
+		point.z *= mm;
+		points.push_back( point );
+	}
+	library.close();
+
+	G4cout << "Light map samples: " << points.size() << " points from "
+		   << libraryName << G4endl;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					SetShard()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimLightMap::SetShard( G4String info )
+{
+	//	The shard index, counting from 0, and the number of shards
+	std::istringstream input( info );
+	input >> shardIndex >> numShards;
+	if( input.fail() || numShards < 1 || shardIndex < 0 ||
+			shardIndex >= numShards ) {
+		G4cout << G4endl << G4endl << G4endl;
+		G4cout << "The light map shard needs an index from 0 to the number of "
+			   << "shards minus 1," << G4endl
+			   << "then the number of shards (got \"" << info << "\")"
+			   << G4endl;
+		G4cout << G4endl << G4endl << G4endl;
+		exit(0);
+	}
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					BeginBuild()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4int LUXSimLightMap::BeginBuild()
+{
+	if( !points.size() ) {
+		G4cout << G4endl << G4endl << G4endl;
+		G4cout << "No light map points. Use /LUXSim/lightMap/grid or "
+			   << "/LUXSim/lightMap/samples first." << G4endl;
+		G4cout << G4endl << G4endl << G4endl;
+		exit(0);
+	}
+
+	G4String shardFileName = GetShardFileName();
+	std::vector<G4String> doneKeys;
+	ReadDoneKeys( shardFileName, doneKeys );
+	std::set<G4String> done( doneKeys.begin(), doneKeys.end() );
+
+	pendingPoints.clear();
+	G4int numInShard = 0;
+	for( G4int i=shardIndex; i<(G4int)points.size(); i+=numShards ) {
+		numInShard++;
+		if( !done.count( GetKey( points[i] ) ) )
+			pendingPoints.push_back( i );
+	}
+	nextPending = 0;
+	currentPoint = -1;
+
+	mapFile.open( shardFileName.c_str(), std::ios::out | std::ios::app );
+	if( !mapFile.is_open() ) {
+		G4cout << G4endl << G4endl << G4endl;
+		G4cout << "Could not open the light map file " << shardFileName
+			   << G4endl;
+		G4cout << G4endl << G4endl << G4endl;
+		exit(0);
+	}
+
+	G4cout << "Building the light map in " << shardFileName << ": "
+		   << numInShard << " of " << points.size() << " points in this "
+		   << "shard, " << numInShard - pendingPoints.size() << " already done, "
+		   << numPhotons << " photons of " << photonEnergy/eV << " eV per point"
+		   << G4endl;
+
+	building = ( pendingPoints.size() > 0 );
+	return pendingPoints.size();
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					EndBuild()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimLightMap::EndBuild()
+{
+	if( mapFile.is_open() )
+		mapFile.close();
+	building = false;
+
+	G4cout << "Light map: " << nextPending << " points written to "
+		   << GetShardFileName() << G4endl;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					GeneratePrimaries()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimLightMap::GeneratePrimaries( G4Event *event )
+{
+	currentPoint = pendingPoints[nextPending++];
+	detections.assign( NUM_PMTS, 0 );
+
+	const emissionPoint &point = points[currentPoint];
+	G4PrimaryVertex *vertex = new G4PrimaryVertex(
+			G4ThreeVector( point.x, point.y, point.z ), 0. );
+
+	//	Isotropic directions, with the polarization at a random angle around
+	//	the direction
+	for( G4int i=0; i<numPhotons; i++ ) {
+		G4double cosTheta = 2.*G4UniformRand() - 1.;
+		G4double sinTheta = sqrt( 1. - cosTheta*cosTheta );
+		G4double phi = twopi*G4UniformRand();
+		G4ThreeVector direction( sinTheta*cos(phi), sinTheta*sin(phi),
+				cosTheta );
+		G4ThreeVector polarization = direction.orthogonal().unit();
+		polarization.rotate( twopi*G4UniformRand(), direction );
+
+		G4PrimaryParticle *photon = new G4PrimaryParticle(
+				G4OpticalPhoton::OpticalPhotonDefinition(),
+				photonEnergy*direction.x(), photonEnergy*direction.y(),
+				photonEnergy*direction.z() );
+		photon->SetPolarization( polarization.x(), polarization.y(),
+				polarization.z() );
+		vertex->SetPrimary( photon );
+	}
+	event->AddPrimaryVertex( vertex );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					EndOfEvent()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimLightMap::EndOfEvent()
+{
+	if( currentPoint < 0 )
+		return;
+
+	//	The whole line goes out in one write, so a job that's stopped leaves
+	//	at most one short line behind
+	std::ostringstream line;
+	line << GetKey( points[currentPoint] );
+	for( G4int i=0; i<NUM_PMTS; i++ )
+		line << " " << (G4double)detections[i] / numPhotons;
+	line << "\n";
+	mapFile << line.str();
+	mapFile.flush();
+
+	currentPoint = -1;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					GetKey()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4String LUXSimLightMap::GetKey( const emissionPoint &point )
+{
+	//	The start of a map line, which is also how the points already in the
+	//	file are recognized
+	std::ostringstream key;
+	key << std::setprecision(10) << point.x/mm << " " << point.y/mm << " "
+		<< point.z/mm << " " << ( point.isS1 ? 1 : 0 ) << " "
+		<< point.positionID;
+	return key.str();
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					GetShardFileName()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4String LUXSimLightMap::GetShardFileName()
+{
+	if( numShards == 1 )
+		return fileName;
+
+	std::ostringstream name;
+	name << fileName << "_shard" << shardIndex << "of" << numShards;
+	return name.str();
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					ReadDoneKeys()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimLightMap::ReadDoneKeys( G4String name,
+		std::vector<G4String> &keys )
+{
+	std::ifstream existing( name.c_str() );
+	if( !existing.is_open() )
+		return;
+
+	//	Only whole lines count, and if there are any short ones the file is
+	//	rewritten without them, so that new lines aren't appended to a short
+	//	one
+	std::vector<std::string> lines;
+	G4bool shortLines = false;
+	std::string line;
+	while( std::getline( existing, line ) ) {
+		std::istringstream values( line );
+		std::string token;
+		std::vector<std::string> tokens;
+		while( values >> token )
+			tokens.push_back( token );
+		if( (G4int)tokens.size() != 5 + NUM_PMTS ) {
+			shortLines = true;
+			continue;
+		}
+		lines.push_back( line );
+		keys.push_back( tokens[0] + " " + tokens[1] + " " + tokens[2] + " " +
+				tokens[3] + " " + tokens[4] );
+	}
+	existing.close();
+
+	if( !shortLines )
+		return;
+
+	std::ostringstream tempName;
+	tempName << name << "." << getpid();
+	std::ofstream rewrite( tempName.str().c_str() );
+	for( G4int i=0; i<(G4int)lines.size(); i++ )
+		rewrite << lines[i] << "\n";
+	rewrite.close();
+	if( !rewrite || rename( tempName.str().c_str(), name.c_str() ) ) {
+		G4cout << G4endl << G4endl << G4endl;
+		G4cout << "Could not drop the incomplete lines from the light map "
+			   << "file " << name << G4endl;
+		G4cout << G4endl << G4endl << G4endl;
+		exit(0);
+	}
+}
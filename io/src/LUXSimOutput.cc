@@ -80,6 +80,9 @@
 *   02-Aug-13 - Cleaned up the output directory handling to avoid crashes (Kareem)
 *   29-Apr-14 - The time stamp now records in local time instead of GMT (Kareem)
 *   28-Sep-15 - Handle the case of the code being in an SVN or Git repo (Kareem)
+*   19-Oct-26 - The primary particles are no longer copied for every volume
+*   19-Oct-26 - Added the optical path record (/LUXSim/io/opticalPaths), which
+*				is written to <outputName><seed>_optPaths.bin
 */
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -95,6 +98,8 @@
 #include "LUXSimManager.hh"
 #include "LUXSimDetectorComponent.hh"
 #include "G4Version.hh"
+#include "G4Material.hh"
+#include "G4SurfaceProperty.hh"
 
 #define DEBUGGING 0
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -236,6 +241,21 @@ LUXSimOutput::LUXSimOutput()
 	system(TempName3.c_str());
 
 	numRecords = 0;
+	
+	//	The optical path records go to their own file, so the format of the
+	//	main output file doesn't depend on them
+	numOptPathRecords = 0;
+	if( luxManager->GetRecordOpticalPaths() ) {
+		fOptPathName = luxManager->GetOutputBaseName() + "_optPaths.bin";
+		fOptPathOutput.open( fOptPathName.c_str(), ios::out | ios::binary );
+		if( !fOptPathOutput.is_open() ) {
+			G4cout << G4endl << G4endl << G4endl;
+			G4cout << "Could not open the optical path file " << fOptPathName
+				   << G4endl;
+			G4cout << G4endl << G4endl << G4endl;
+			exit(0);
+		}
+	}
 }
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -259,6 +279,12 @@ LUXSimOutput::~LUXSimOutput()
 	} else
 		G4cout << "\nRun did not end cleanly, file name remains " << fName
 			   << ".tmp" << G4endl;
+	
+	if( fOptPathOutput.is_open() ) {
+		fOptPathOutput.close();
+		G4cout << numOptPathRecords << " optical paths saved to "
+			   << fOptPathName << G4endl << G4endl;
+	}
 }
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -327,7 +353,7 @@ void LUXSimOutput::RecordEventByVolume( LUXSimDetectorComponent* component,
         std::vector<LUXSimManager::stepRecord> eventRecord =
                         component->GetEventRecord();
 
-        std::vector<LUXSimManager::primaryParticleInfo> primaryPar =
+        const std::vector<LUXSimManager::primaryParticleInfo> &primaryPar =
                         luxManager->GetPrimaryParticles();
 
         totalVolumeEnergy = 0.;
@@ -518,3 +544,94 @@ void LUXSimOutput::RecordEventByVolume( LUXSimDetectorComponent* component,
 	}
 	}
 }
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					RecordOpticalPath()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimOutput::RecordOpticalPath(
+		const LUXSimManager::opticalPathRecord &path )
+{
+	//	The optical path file is a sequence of records, each of which starts
+	//	with its type:
+	//	1 - Material name: index, name length, name
+	//	2 - Surface name: index, name length, name
+	//	3 - Photon: event number, track ID, volume ID, number of phe, weight,
+	//		energy (eV), number of materials, then for each material the
+	//		index, path length (mm) and number of Rayleigh scatters, then the
+	//		number of surfaces, and for each surface the index and number of
+	//		reflections
+	//	Materials and surfaces are referred to by index, and each name is
+	//	written once, just before the first photon that uses it. A boundary
+	//	without an optical surface is named after the materials on each side,
+	//	e.g., "liquidXe/gasXe".
+	if( !fOptPathOutput.is_open() )
+		return;
+	
+	G4int numMaterials = path.materials.size();
+	std::vector<G4int> materialIndices( numMaterials );
+	for( G4int i=0; i<numMaterials; i++ )
+		materialIndices[i] = GetOptPathIndex( 1,
+				path.materials[i].material->GetName(), optPathMaterials );
+	
+	G4int numSurfaces = path.surfaces.size();
+	std::vector<G4int> surfaceIndices( numSurfaces );
+	for( G4int i=0; i<numSurfaces; i++ ) {
+		G4String surfaceName;
+		if( path.surfaces[i].surface )
+			surfaceName = path.surfaces[i].surface->GetName();
+		else
+			surfaceName = path.surfaces[i].preMaterial->GetName() + "/" +
+					path.surfaces[i].postMaterial->GetName();
+		surfaceIndices[i] = GetOptPathIndex( 2, surfaceName, optPathSurfaces );
+	}
+	
+	G4int recordType = 3;
+	G4double energy_eV = path.energy / eV;
+	fOptPathOutput.write( (char *)(&recordType), sizeof(int) );
+	fOptPathOutput.write( (char *)(&path.eventNumber), sizeof(int) );
+	fOptPathOutput.write( (char *)(&path.trackID), sizeof(int) );
+	fOptPathOutput.write( (char *)(&path.volumeID), sizeof(int) );
+	fOptPathOutput.write( (char *)(&path.numPhe), sizeof(int) );
+	fOptPathOutput.write( (char *)(&path.weight), sizeof(double) );
+	fOptPathOutput.write( (char *)(&energy_eV), sizeof(double) );
+	
+	fOptPathOutput.write( (char *)(&numMaterials), sizeof(int) );
+	for( G4int i=0; i<numMaterials; i++ ) {
+		G4double pathLength_mm = path.materials[i].pathLength / mm;
+		fOptPathOutput.write( (char *)(&materialIndices[i]), sizeof(int) );
+		fOptPathOutput.write( (char *)(&pathLength_mm), sizeof(double) );
+		fOptPathOutput.write( (char *)(&path.materials[i].numRayleigh),
+				sizeof(int) );
+	}
+	
+	fOptPathOutput.write( (char *)(&numSurfaces), sizeof(int) );
+	for( G4int i=0; i<numSurfaces; i++ ) {
+		fOptPathOutput.write( (char *)(&surfaceIndices[i]), sizeof(int) );
+		fOptPathOutput.write( (char *)(&path.surfaces[i].numReflections),
+				sizeof(int) );
+	}
+	
+	numOptPathRecords++;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					GetOptPathIndex()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4int LUXSimOutput::GetOptPathIndex( G4int recordType, G4String name,
+		map<G4String,G4int> &indices )
+{
+	map<G4String,G4int>::iterator it = indices.find( name );
+	if( it != indices.end() )
+		return it->second;
+	
+	G4int index = indices.size();
+	indices[name] = index;
+	
+	Size = name.length();
+	fOptPathOutput.write( (char *)(&recordType), sizeof(int) );
+	fOptPathOutput.write( (char *)(&index), sizeof(int) );
+	fOptPathOutput.write( (char *)(&Size), sizeof(int) );
+	fOptPathOutput.write( (char *)(name.c_str()), Size );
+	
+	return index;
+}
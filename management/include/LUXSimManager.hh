@@ -99,6 +99,24 @@
 *   27-Aug-15 - Added GetLiquidXenonEnergy method (Kareem)
 *   28-Sep-15 - Added SVN/Git repo check support (Kareem)
 *   06-Oct-15 - Added methods for G4Decay generator
+*   19-Oct-26 - Added registration and Get/Set methods for the run profiler
+*   19-Oct-26 - Added GetOutputBaseName and the progress log switch
+*   19-Oct-26 - Added the LZ background component selection
+*   19-Oct-26 - The events file queues are replaced by LUXSimEventsFileReader,
+*               which streams the file while the run goes
+*   19-Oct-26 - The primary particle records are passed by reference
+*   19-Oct-26 - The field, drift time and radial drift maps are LUXSimFieldMap
+*               objects instead of fixed-size arrays
+*   19-Oct-26 - Added GetXYZDependentValues, which finds any of the map
+*               quantities at once for one point or an array of points
+*   19-Oct-26 - Added the Set methods for the optical photon policies, and
+*               IsRegistered to check that a volume is a detector component
+*   19-Oct-26 - Added registration of the light map builder, and
+*               BuildLightMap
+*   19-Oct-26 - Added the optical path record switch, and the per-photon
+*               optical path record
+*   19-Oct-26 - Added the optical fast path volumes, region and model
+*   19-Oct-26 - Added ClearPhotoCathodes
 */
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -128,6 +146,8 @@
 //
 #include "LUXSimMaterials.hh"
 #include "LUXSimBST.hh"
+#include "LUXSimEventsFileReader.hh"
+#include "LUXSimFieldMap.hh"
 //#include "G4S1Light.hh"
 //#include "LUXSimIsotope.hh"
 
@@ -137,6 +157,10 @@
 class G4UImanager;
 class G4GeneralParticleSource;
 class G4Event;
+class G4Material;
+class G4SurfaceProperty;
+class G4LogicalVolume;
+class G4Region;
 
 class LUXSimPhysicsList;
 class LUXSimPhysicsOpticalPhysics;
@@ -149,6 +173,9 @@ class LUXSimSteppingAction;
 class LUXSimOutput;
 class LUXSimMessenger;
 class LUXSimSourceCatalog;
+class LUXSimProfiler;
+class LUXSimLightMap;
+class LUXSimOpticalFastModel;
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 class LUXSimManager
@@ -174,6 +201,8 @@ class LUXSimManager
 		void Register( LUXSimSteppingAction *step ) { LUXSimStep = step; };
 		void Register( LUXSimOutput *out ) { LUXSimOut = out; };
 		void Register( LUXSimSourceCatalog *cat ) { LUXSimSourceCat = cat; };
+		void Register( LUXSimProfiler *prof ) { LUXSimProf = prof; };
+		void Register( LUXSimLightMap *map ) { LUXSimMap = map; };
 		
 		LUXSimPhysicsList *GetPhysicsList() { return LUXSimPhysics; };
 		LUXSimDetectorConstruction *GetDetectorConstruction() {
@@ -185,9 +214,12 @@ class LUXSimManager
 		LUXSimSteppingAction *GetStep() { return LUXSimStep; };
 		LUXSimOutput *GetOutput() { return LUXSimOut; };
 		LUXSimSourceCatalog *GetSourceCatalog() { return LUXSimSourceCat; };
+		LUXSimProfiler *GetProfiler() { return LUXSimProf; };
+		LUXSimLightMap *GetLightMap() { return LUXSimMap; };
 		
 		//	General-purpose methods
 		void BeamOn( G4int );
+		void BuildLightMap();
 		inline G4int GetRandomSeed() { return randomSeed; };
 		void SetRandomSeed( G4int );
 		
@@ -202,6 +234,7 @@ class LUXSimManager
 		G4String GetOutputDir() { return outputDir; };
 		void SetOutputName( G4String name ) { outputName = name; };
 		G4String GetOutputName() { return outputName; };
+		G4String GetOutputBaseName();
 		G4String GetHistoryFile() { return historyFile; };
 		G4String GetInputCommands() { return listOfCommands; };
 		G4String GetDiffs() { return listOfDiffs; };
@@ -227,8 +260,34 @@ class LUXSimManager
        	void LoadXYZDependentRadialDrift (G4String radialDriftFile);
         double GetXYZDependentRadialDrift (G4ThreeVector x1);
 
+        // any of the three map quantities at a point, or at an array of
+        // points, in one pass through the interpolation kernel. Maps that
+        // haven't been loaded yet are loaded from their files. Quantities
+        // that aren't asked for are set to 0.
+        enum fieldMapQuantity { electricFieldQuantity = 1,
+                driftTimeQuantity = 2, radialDriftQuantity = 4 };
+        struct fieldMapValues {
+            G4double electricField;
+            G4double driftTime;
+            G4double radialDrift;
+        };
+        void GetXYZDependentValues (const G4ThreeVector &x1, G4int quantities,
+                fieldMapValues &values)
+                { GetXYZDependentValues(1, &x1, quantities, &values); };
+        void GetXYZDependentValues (G4int numPoints, const G4ThreeVector *x1,
+                G4int quantities, fieldMapValues *values);
+
         void SetEventProgressFrequency( G4int val ) { eventProgressFrequency = val;};
         G4int GetEventProgressFreqnecy() { return eventProgressFrequency; };
+
+        inline void SetProfiling( G4bool val ) { profiling = val; };
+        inline G4bool GetProfiling() { return (profiling && LUXSimProf); };
+        
+        void SetProgressLog( G4bool val ) { progressLog = val; };
+        G4bool GetProgressLog() { return progressLog; };
+        
+        void SetRecordOpticalPaths( G4bool val ) { recordOpticalPaths = val; };
+        G4bool GetRecordOpticalPaths() { return recordOpticalPaths; };
     
         inline G4double Get100keVHack() { return use100keVHack; };
         inline void Set100keVHack( G4double val ) { use100keVHack = val; };
@@ -287,6 +346,7 @@ class LUXSimManager
                 void SetPMTNumberingScheme( G4String sel );
 
                 G4bool GetPMTNumberingScheme() { return useRealPMTNumberingScheme; };
+		void ClearPhotoCathodes();
 
 		G4bool CapturePhotons( LUXSimDetectorComponent* );
 
@@ -302,6 +362,13 @@ class LUXSimManager
 		std::vector<G4int> GetRecordLevelsThermElec( G4String );
 		G4int GetComponentRecordLevelThermElec( LUXSimDetectorComponent* );
 		
+		void SetOptPhotKill( G4String );
+		void SetOptPhotMaxBounces( G4String );
+		void SetOptPhotMaxPathLength( G4String );
+		void SetOptPhotRoulette( G4String );
+		G4bool GetUseOptPhotPolicies() { return useOptPhotPolicies; };
+		G4bool IsRegistered( LUXSimDetectorComponent* );
+		
 		LUXSimDetectorComponent *GetComponentByName( G4String );
 		
 		void SetCollimatorHeight( G4double );
@@ -433,6 +500,8 @@ class LUXSimManager
          //	Source methods
         void SetSource( G4String );
         void SetPrintEventList( G4bool sel ) { printEventList = sel; };
+        void SetLZbkgComponent( G4String sel ) { lzBkgComponent = sel; };
+        G4String GetLZbkgComponent() { return lzBkgComponent; };
         void ResetSources();
         void BuildEventList();
         void TrimEventList();
@@ -457,10 +526,8 @@ class LUXSimManager
         G4double GetTwoElectronsEmax() {return twoElectronsEmax;}
 
         void LoadEventsFile(G4String);
-        G4int NextEventToGenerate();
-        G4int NextParticleIDToGenerate();
-        G4double NextEnergyDepToGenerate();
-        G4ThreeVector NextPositionToGenerate();
+        LUXSimEventsFileReader *GetEventsFileReader()
+            { return &eventsFileReader; };
 
         G4bool GetG4DecayBool(){ return g4decaybool; };
         void SetG4DecayBool(G4bool val){ g4decaybool = val; };
@@ -505,10 +572,37 @@ class LUXSimManager
 			G4ThreeVector position;
 			G4ThreeVector direction;
 		};
-		void AddPrimaryParticle( primaryParticleInfo particle )
+		void AddPrimaryParticle( const primaryParticleInfo &particle )
 				{ primaryParticles.push_back( particle );}; 
-		std::vector<primaryParticleInfo> GetPrimaryParticles()
+		const std::vector<primaryParticleInfo> &GetPrimaryParticles()
 				{ return primaryParticles; };
+		
+		//	Optical path of a photon that reached a photocathode. The path
+		//	length and number of Rayleigh scatters are kept for each material,
+		//	and the reflections for each optical surface. Reflections off a
+		//	boundary without an optical surface have no surface, and are kept
+		//	by the pair of materials instead.
+		struct optPathMaterial {
+			const G4Material *material;
+			G4double pathLength;
+			G4int numRayleigh;
+		};
+		struct optPathSurface {
+			const G4SurfaceProperty *surface;
+			const G4Material *preMaterial;
+			const G4Material *postMaterial;
+			G4int numReflections;
+		};
+		struct opticalPathRecord {
+			G4int eventNumber;
+			G4int trackID;
+			G4int volumeID;
+			G4int numPhe;
+			G4double weight;
+			G4double energy;
+			std::vector<optPathMaterial> materials;
+			std::vector<optPathSurface> surfaces;
+		};
 
 		//	Physics list methods
 		inline G4bool GetUseOpticalProcesses() { return useOpticalProcesses; };
@@ -524,6 +618,11 @@ class LUXSimManager
 		inline G4double GetDriftElecAttenuation()
 				{ return driftElecAttenuation; };
 		
+		//	The volumes are looked up by name at each BeamOn, so they can be
+		//	given before the geometry is built
+		void SetOpticalFastPath( G4String );
+		void UpdateOpticalFastPath();
+		
 		//	Materials methods
 		void SetLXeTeflonRefl( G4double r );
 		void SetLXeSteelRefl( G4double r );
@@ -555,6 +654,8 @@ class LUXSimManager
 		LUXSimSteppingAction *LUXSimStep;
 		LUXSimOutput *LUXSimOut;
 		LUXSimSourceCatalog *LUXSimSourceCat;
+		LUXSimProfiler *LUXSimProf;
+		LUXSimLightMap *LUXSimMap;
 	
 		G4UImanager *UI;
 		
@@ -574,6 +675,9 @@ class LUXSimManager
 		G4int numEvents;
 		G4bool alwaysRecordPrimary;
 		G4int eventProgressFrequency;
+        G4bool profiling;
+        G4bool progressLog;
+        G4bool recordOpticalPaths;
         G4double use100keVHack;
         G4double liquidXenonTotalEnergy;
         G4int eventCount;
@@ -594,6 +698,7 @@ class LUXSimManager
 		G4String cryoStandSelection;
 		G4String gridWiresSelection;
 		G4bool useRealPMTNumberingScheme;
+		G4bool useOptPhotPolicies;
 		
 		G4double collimator_height;
 		G4double collimator_hole;
@@ -633,15 +738,15 @@ class LUXSimManager
 
         G4bool EFieldFromFile;
         G4String EFieldFile;
-        G4double xyzDependentEField[251][598]; // XYZ-dependent electric field calculated from COMSOL
+        LUXSimFieldMap eFieldMap; // XYZ-dependent electric field calculated from COMSOL
 
         G4bool DriftTimeFromFile;
         G4String DriftTimeFile;
-        G4double xyzDependentDriftTime[251][598]; // XYZ-dependent drift time calculated from COMSOL
+        LUXSimFieldMap driftTimeMap; // XYZ-dependent drift time calculated from COMSOL
 
         G4bool RadialDriftFromFile;
         G4String RadialDriftFile;
-        G4double xyzDependentRadialDrift[251][598]; // XYZ-dependent radial drift calculated from COMSOL
+        LUXSimFieldMap radialDriftMap; // XYZ-dependent radial drift calculated from COMSOL
 
         G4bool luxDoublePheRateFromFile;
 
@@ -660,6 +765,7 @@ class LUXSimManager
         G4double windowStart, windowEnd;
         G4bool hasLUXSimSources, isEventListBuilt;
         G4bool hasDecayChainSources, printEventList;
+        G4String lzBkgComponent;
         LUXSimBST* recordTree;
 
         G4double gammaXFiducialR;
@@ -686,20 +792,13 @@ class LUXSimManager
         G4double s1gain;
         G4double s2gain;
 		G4double driftElecAttenuation;
+		std::vector<G4String> opticalFastPathVolumes;
+		std::vector<G4LogicalVolume*> opticalFastPathRoots;
+		G4Region *opticalFastPathRegion;
+		LUXSimOpticalFastModel *opticalFastPathModel;
 
         // for evnets file generator
-        std::queue<G4int> qEvtN;
-        std::queue<G4int> qParticleID;
-        std::queue<G4double> qEnergyDep_keV;
-        std::queue<G4double> qPositionX_cm;
-        std::queue<G4double> qPositionY_cm;
-        std::queue<G4double> qPositionZ_cm;
-        G4int currentEvtN;
-        std::queue<G4int> currentParticleID;
-        std::queue<G4double> currentEnergyDep_keV;
-        std::queue<G4double> currentX_cm;
-        std::queue<G4double> currentY_cm;
-        std::queue<G4double> currentZ_cm;
+        LUXSimEventsFileReader eventsFileReader;
 
 
 };
@@ -71,6 +71,13 @@
 *   26-Sep-14 - Added option to change YBe pig height and diameter (Kevin)
 *   14-Oct-14 - Added component-wise SetMass and SetVolume commands (Kareem)
 *   02-Feb-15 - Added pencil beam command for the LUX DD generator (Kevin)
+*   19-Oct-26 - Added the run profiler switch
+*   19-Oct-26 - Added the progress log switch
+*   19-Oct-26 - Added the LZ background component command
+*   19-Oct-26 - Added the optical photon policy commands
+*   19-Oct-26 - Added the light map commands
+*   19-Oct-26 - Added the optical path record switch
+*   19-Oct-26 - Added the optical fast path command
 */
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -122,6 +129,9 @@ class LUXSimMessenger : public G4UImessenger
 		G4UIcmdWithABool			*LUXSimAlwaysRecordPrimaryCommand;
         G4UIcmdWithAnInteger        *LUXSimEventProgressCommand;
         G4UIcmdWithADoubleAndUnit   *LUXSim100keVHackCommand;
+        G4UIcmdWithABool            *LUXSimProfileCommand;
+        G4UIcmdWithABool            *LUXSimProgressLogCommand;
+        G4UIcmdWithABool            *LUXSimOpticalPathsCommand;
 
         // User defined variables commands.
 		G4UIcmdWithADouble			*LUXSimUserVar1Command;
@@ -146,6 +156,10 @@ class LUXSimMessenger : public G4UImessenger
 		G4UIcmdWithAString			*LUXSimRecordLevelCommand;
 		G4UIcmdWithAString			*LUXSimRecordLevelOptPhotCommand;
 		G4UIcmdWithAString			*LUXSimRecordLevelThermElecCommand;
+		G4UIcmdWithAString			*LUXSimOptPhotKillCommand;
+		G4UIcmdWithAString			*LUXSimOptPhotMaxBouncesCommand;
+		G4UIcmdWithAString			*LUXSimOptPhotMaxPathLengthCommand;
+		G4UIcmdWithAString			*LUXSimOptPhotRouletteCommand;
 		G4UIcmdWithADoubleAndUnit	*LUXSimCollimatorHeightCommand;
 		G4UIcmdWithADoubleAndUnit	*LUXSimCollimatorHoleCommand;
 		G4UIcmdWithADoubleAndUnit	*LUXSimCollimatorSourceDiameterCommand;
@@ -193,6 +207,7 @@ class LUXSimMessenger : public G4UImessenger
 		G4UIcmdWithAString			*LUXSimSourceSetCommand;
 		G4UIcmdWithoutParameter		*LUXSimSourceResetCommand;
 		G4UIcmdWithABool         	*LUXSimSourcePrintCommand;
+		G4UIcmdWithAString			*LUXSimSourceLZbkgComponentCommand;
 		
 		//	Physics list commands
 		G4UIdirectory				*LUXSimPhysicsListDir;
@@ -201,6 +216,7 @@ class LUXSimMessenger : public G4UImessenger
         G4UIcmdWithADouble          *LUXSimS1GainCommand;
         G4UIcmdWithADouble          *LUXSimS2GainCommand;
 		G4UIcmdWithADoubleAndUnit	*LUXSimDriftingElectronAttenuationCommand;
+		G4UIcmdWithAString			*LUXSimOpticalFastPathCommand;
 		
 		//	Materials commands
 		G4UIdirectory				*LUXSimMaterialsDir;	
@@ -213,6 +229,16 @@ class LUXSimMessenger : public G4UImessenger
 		G4UIcmdWithADoubleAndUnit	*LUXSimGXeAbsCommand;
 		G4UIcmdWithADoubleAndUnit	*LUXSimGXeRayleighCommand;
 		G4UIcmdWithADouble			*LUXSimAlUnoxQuartzReflCommand;
+		
+		//	Light map commands
+		G4UIdirectory				*LUXSimLightMapDir;
+		G4UIcmdWithAString			*LUXSimLightMapGridCommand;
+		G4UIcmdWithAString			*LUXSimLightMapSamplesCommand;
+		G4UIcmdWithAnInteger		*LUXSimLightMapPhotonsCommand;
+		G4UIcmdWithADoubleAndUnit	*LUXSimLightMapEnergyCommand;
+		G4UIcmdWithAString			*LUXSimLightMapShardCommand;
+		G4UIcmdWithAString			*LUXSimLightMapFileCommand;
+		G4UIcmdWithoutParameter		*LUXSimLightMapBuildCommand;
 
 };
 
@@ -174,6 +174,35 @@
 *               (David W)
 *   28-Sep-15 - The manager now supports the code being in an SVN or Git repo
 *               (or no version control) (Kareem)
+*   19-Oct-26 - Added the run profiler pointer and switch
+*   19-Oct-26 - Added GetOutputBaseName for the sidecar files written next to
+*               the binary output, and the progress log switch
+*   19-Oct-26 - The source catalog pointer is now initialized to NULL, so the
+*               manager can be deleted when no catalog was created (e.g., in
+*               the microbenchmarks)
+*   19-Oct-26 - ResetSources also has each source type drop its cached
+*               spectra
+*   19-Oct-26 - The LZ background component defaults to "all"
+*   19-Oct-26 - LoadEventsFile only opens the file now. The events are read
+*               as they are generated, so the Next...ToGenerate methods are
+*               gone.
+*   19-Oct-26 - The field, drift time and radial drift maps are LUXSimFieldMap
+*               objects, with their grid taken from the map files
+*   19-Oct-26 - The three map lookups share one bounds-checked interpolation
+*               kernel, through GetXYZDependentValues
+*   19-Oct-26 - The maps can be 3D as well as r-z
+*   19-Oct-26 - Added the Set methods for the optical photon policies, which
+*               are kept through UpdateGeometry like the record levels
+*   19-Oct-26 - Added BuildLightMap, which runs the light map builder
+*   19-Oct-26 - The optical path record is off by default
+*   19-Oct-26 - Added SetOpticalFastPath and UpdateOpticalFastPath, which put
+*               the named volumes in the region of the optical fast path at
+*               each BeamOn. UpdateGeometry takes them out first.
+*   19-Oct-26 - SetOptPhotRoulette turns the policies on for 0 bounces too
+*   19-Oct-26 - BeamOn stops if a volume holding parameterised grid wires has
+*               a record level or an optical photon policy
+*   19-Oct-26 - UpdateGeometry and SetPMTNumberingScheme clear the QE
+*               process's photocathode lookup
 */
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -184,6 +213,8 @@
 #include <sstream>
 #include <cstdlib>
 #include <vector>
+#include <sys/types.h>
+#include <sys/stat.h>
 
 //
 //	CLHEP includes
@@ -197,8 +228,16 @@
 //	GEANT4 includes
 //
 #include "G4UImanager.hh"
+#include "G4UIcommand.hh"
 #include "G4GeneralParticleSource.hh"
 #include "G4Event.hh"
+#include "G4RunManager.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4GlobalFastSimulationManager.hh"
 #include "globals.hh"
 
 //
@@ -214,6 +253,8 @@
 #include "LUXSimEventAction.hh"
 #include "LUXSimSteppingAction.hh"
 #include "LUXSimOutput.hh"
+#include "LUXSimLightMap.hh"
+#include "LUXSimOpticalFastModel.hh"
 #include "LUXSimSourceCatalog.hh"
 #include "LUXSimSource.hh"
 #include "LUXSimBST.hh"
@@ -229,7 +270,10 @@ using namespace CLHEP;
 //					LUXSimManager()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 LUXSimManager *LUXSimManager::LUXManager = 0;
-LUXSimManager::LUXSimManager()
+LUXSimManager::LUXSimManager() :
+	eFieldMap( "E-Field" ),
+	driftTimeMap( "Drift Time" ),
+	radialDriftMap( "Radial Drift" )
 {
 	//	Set the random seed
 	CLHEP::HepRandom::setTheEngine( &randomizationEngine );
@@ -251,6 +295,10 @@ LUXSimManager::LUXSimManager()
 	LUXManager = this;
 	LUXMessenger = new LUXSimMessenger( this );
 	LUXSimOut = NULL;
+	LUXSimProf = NULL;
+	LUXSimMap = NULL;
+	LUXSimSourceCat = NULL;
+	LUXSimPhysicsOptical = NULL;
 	
 	luxSimComponents.clear();
     
@@ -260,10 +308,14 @@ LUXSimManager::LUXSimManager()
 	
 	alwaysRecordPrimary = true;
     eventProgressFrequency = 100000;
+    profiling = false;
+    progressLog = false;
+    recordOpticalPaths = false;
 
     hasLUXSimSources = false;
     isEventListBuilt = false;
     printEventList = false;
+    lzBkgComponent = "all";
     hasDecayChainSources = false;
     windowEnd = 0.;
     
@@ -273,12 +325,15 @@ LUXSimManager::LUXSimManager()
 	//detectorSelection = "1_0Detector";
 	detectorSelection = "";
     checkVolumeOverlaps = false;
+	useOptPhotPolicies = false;
 	muonVetoSelection = "off";
 	LZVetoSelection = "off";
 	cryoStandSelection = "off";
 	gasRun = false;
 	gridWiresSelection = "off";
 	useOpticalProcesses = false;
+	opticalFastPathRegion = NULL;
+	opticalFastPathModel = NULL;
 	numGNARRLIPMTFlag = false;
 	useRealPMTNumberingScheme = true;
 	luxSurfaceGeometry = false;
@@ -470,6 +525,31 @@ void LUXSimManager::BeamOn( G4int numOfEvents )
 			   << G4endl;
 		luxSimComponents[i]->DetermineCenterAndExtent(
 				LUXSimDetector->GetWorldVolume());
+		
+		//	The steps in parameterised grid wires are given to the component
+		//	that holds them, without saying which wire they were in, so a
+		//	holder can't be recorded or have an optical photon policy
+		G4LogicalVolume *logical = luxSimComponents[i]->GetLogicalVolume();
+		G4bool hasParameterisedWires = false;
+		for( G4int j=0; j<logical->GetNoDaughters(); j++ )
+			if( logical->GetDaughter(j)->IsParameterised() )
+				hasParameterisedWires = true;
+		const LUXSimDetectorComponent::optPhotPolicy &policy =
+				luxSimComponents[i]->GetOptPhotPolicy();
+		if( hasParameterisedWires && ( luxSimComponents[i]->GetRecordLevel() ||
+				luxSimComponents[i]->GetRecordLevelOptPhot() ||
+				luxSimComponents[i]->GetRecordLevelThermElec() ||
+				policy.kill || policy.maxBounces || policy.maxPathLength > 0 ||
+				policy.rouletteSurvival < 1 ) ) {
+			G4cout << G4endl << G4endl << G4endl;
+			G4cout << "Volume \"" << luxSimComponents[i]->GetName()
+				   << "\" holds parameterised grid wires, so it can't have a"
+				   << G4endl << "record level or an optical photon policy. "
+				   << "Use \"/LUXSim/detector/gridWires on\" to record the "
+				   << "wires." << G4endl;
+			G4cout << G4endl << G4endl << G4endl;
+			exit(0);
+		}
 	}
 	G4cout << G4endl << G4endl;
 	
@@ -516,6 +596,7 @@ void LUXSimManager::BeamOn( G4int numOfEvents )
 //		UI->ApplyCommand( "/process/inactivate Scintillation" );
 		UI->ApplyCommand( "/process/inactivate Cerenkov" );	
 	}
+	UpdateOpticalFastPath();
 	
 	//	This next chunk of code opens the stored history of commands, and saves
 	//	that list in the local string.
@@ -605,6 +686,19 @@ void LUXSimManager::BeamOn( G4int numOfEvents )
         CLHEP::HepRandom::setTheSeed( randomSeed );
 }
 
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					BuildLightMap()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimManager::BuildLightMap()
+{
+	//	One event per light map point that isn't done yet. The builder takes
+	//	over the primary generation and the end of each event while it runs.
+	G4int numPoints = LUXSimMap->BeginBuild();
+	if( numPoints )
+		BeamOn( numPoints );
+	LUXSimMap->EndBuild();
+}
+
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //					SetRandomSeed()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -626,6 +720,31 @@ void LUXSimManager::SetOutputDir( G4String dir )
 		outputDir = dir + "/";
 }
 
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					GetOutputBaseName()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4String LUXSimManager::GetOutputBaseName()
+{
+	//	This is the output directory, base name and random seed, i.e., the
+	//	binary output file name without the ".bin" extension. Sidecar files
+	//	(profile, progress log) append their own suffix to it.
+	G4String OutDir = outputDir;
+	if( OutDir.substr( OutDir.length() - 1, 1 ) == "/" )
+		OutDir = OutDir.substr( 0, OutDir.length() - 1 );
+	struct stat st;
+	if ( stat(OutDir.c_str(), &st) == -1 ) mkdir(OutDir.c_str(), 0777);
+	
+	stringstream baseName;
+	baseName << OutDir << "/";
+	if( (outputName.length() > 0) && (outputName != "0") )
+		baseName << outputName;
+	else
+		baseName << "LUXOut";
+	baseName << randomSeed;
+	
+	return baseName.str();
+}
+
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //					UpdateGeometry()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -636,6 +755,7 @@ void LUXSimManager::UpdateGeometry()
 	vector<G4int> recordLevels;
 	vector<G4int> recordLevelsOptPhot;
 	vector<G4int> recordLevelsThermElec;
+	vector<LUXSimDetectorComponent::optPhotPolicy> optPhotPolicies;
 	LUXSimDetectorComponent::source tempSource;
 	vector<LUXSimDetectorComponent::source> sources;
 	vector<G4String> sourceVolNames;
@@ -650,6 +770,7 @@ void LUXSimManager::UpdateGeometry()
 				luxSimComponents[i]->GetRecordLevelOptPhot() );
 		recordLevelsThermElec.push_back(
 				luxSimComponents[i]->GetRecordLevelThermElec() );
+		optPhotPolicies.push_back( luxSimComponents[i]->GetOptPhotPolicy() );
 
 		vector<LUXSimDetectorComponent::source> origSources =
 				luxSimComponents[i]->GetSources();
@@ -666,6 +787,20 @@ void LUXSimManager::UpdateGeometry()
 		}
 	}	
 
+	//	The logical volumes are about to be deleted, so they have to come out
+	//	of the optical fast path region now. BeamOn puts the new ones back.
+	if( opticalFastPathRegion ) {
+		for( G4int i=0; i<(G4int)opticalFastPathRoots.size(); i++ )
+			opticalFastPathRegion->RemoveRootLogicalVolume(
+					opticalFastPathRoots[i] );
+		opticalFastPathRoots.clear();
+		opticalFastPathModel->ClearEnvelopes();
+	}
+
+	//	The QE process knows the photocathodes by address, and the new
+	//	volumes may reuse the old addresses
+	ClearPhotoCathodes();
+
 	//	Next, update the geometry, which wipes out all detector-component-
 	//	related info
 	luxSimComponents.clear();
@@ -711,6 +846,12 @@ void LUXSimManager::UpdateGeometry()
 		info.str("");
 		info << volNames[i] << " " << recordLevelsThermElec[i];
 		SetRecordLevelThermElec( info.str() );
+
+		//	The policies go back by exact name, since they aren't set from a
+		//	single number
+		for( G4int j=0; j<(G4int)luxSimComponents.size(); j++ )
+			if( luxSimComponents[j]->GetName() == volNames[i] )
+				luxSimComponents[j]->SetOptPhotPolicy( optPhotPolicies[i] );
 	}
 	
 	for ( G4int i=0; i<(G4int)sourceVolNames.size(); i++ )
@@ -929,6 +1070,145 @@ G4int LUXSimManager::GetComponentRecordLevelThermElec(
 	return 0;
 }
 
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					SetOptPhotKill()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimManager::SetOptPhotKill( G4String info )
+{
+	//	The volume name, then true or false
+	istringstream input( info );
+	G4String volName, value;
+	input >> volName >> value;
+	G4bool kill = G4UIcommand::ConvertToBool( value.c_str() );
+	
+	for( G4int i=0; i<(G4int)luxSimComponents.size(); i++ )
+		if( volName == "***" ||
+				luxSimComponents[i]->GetName().find(volName) < G4String::npos ) {
+			LUXSimDetectorComponent::optPhotPolicy policy =
+					luxSimComponents[i]->GetOptPhotPolicy();
+			policy.kill = kill;
+			luxSimComponents[i]->SetOptPhotPolicy( policy );
+		}
+	
+	if( kill )
+		useOptPhotPolicies = true;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					SetOptPhotMaxBounces()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimManager::SetOptPhotMaxBounces( G4String info )
+{
+	//	The volume name, then the number of bounces
+	istringstream input( info );
+	G4String volName;
+	G4int maxBounces = 0;
+	input >> volName >> maxBounces;
+	
+	if( maxBounces < 0 ) {
+		G4cout << G4endl << G4endl << G4endl;
+		G4cout << "The maximum number of optical photon bounces in \""
+			   << volName << "\" can't be negative" << G4endl;
+		G4cout << G4endl << G4endl << G4endl;
+		exit(0);
+	}
+	
+	for( G4int i=0; i<(G4int)luxSimComponents.size(); i++ )
+		if( volName == "***" ||
+				luxSimComponents[i]->GetName().find(volName) < G4String::npos ) {
+			LUXSimDetectorComponent::optPhotPolicy policy =
+					luxSimComponents[i]->GetOptPhotPolicy();
+			policy.maxBounces = maxBounces;
+			luxSimComponents[i]->SetOptPhotPolicy( policy );
+		}
+	
+	if( maxBounces )
+		useOptPhotPolicies = true;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					SetOptPhotMaxPathLength()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimManager::SetOptPhotMaxPathLength( G4String info )
+{
+	//	The volume name, then the length and its unit (mm if there's none)
+	istringstream input( info );
+	G4String volName, unit = "mm";
+	G4double maxPathLength = 0;
+	input >> volName >> maxPathLength >> unit;
+	maxPathLength *= G4UIcommand::ValueOf( unit.c_str() );
+	
+	if( maxPathLength < 0 ) {
+		G4cout << G4endl << G4endl << G4endl;
+		G4cout << "The maximum optical photon path length in \"" << volName
+			   << "\" can't be negative" << G4endl;
+		G4cout << G4endl << G4endl << G4endl;
+		exit(0);
+	}
+	
+	for( G4int i=0; i<(G4int)luxSimComponents.size(); i++ )
+		if( volName == "***" ||
+				luxSimComponents[i]->GetName().find(volName) < G4String::npos ) {
+			LUXSimDetectorComponent::optPhotPolicy policy =
+					luxSimComponents[i]->GetOptPhotPolicy();
+			policy.maxPathLength = maxPathLength;
+			luxSimComponents[i]->SetOptPhotPolicy( policy );
+		}
+	
+	if( maxPathLength > 0 )
+		useOptPhotPolicies = true;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					SetOptPhotRoulette()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimManager::SetOptPhotRoulette( G4String info )
+{
+	//	The volume name, the number of bounces after which the roulette
+	//	starts, and the survival probability
+	istringstream input( info );
+	G4String volName;
+	G4int rouletteBounces = 0;
+	G4double rouletteSurvival = 1;
+	input >> volName >> rouletteBounces >> rouletteSurvival;
+	
+	if( rouletteBounces < 0 || rouletteSurvival <= 0 || rouletteSurvival > 1 ) {
+		G4cout << G4endl << G4endl << G4endl;
+		G4cout << "The optical photon roulette in \"" << volName << "\" needs "
+			   << "a number of bounces of at least 0 and a survival" << G4endl
+			   << "probability above 0 and up to 1 (got " << rouletteBounces
+			   << " and " << rouletteSurvival << ")" << G4endl;
+		G4cout << G4endl << G4endl << G4endl;
+		exit(0);
+	}
+	
+	for( G4int i=0; i<(G4int)luxSimComponents.size(); i++ )
+		if( volName == "***" ||
+				luxSimComponents[i]->GetName().find(volName) < G4String::npos ) {
+			LUXSimDetectorComponent::optPhotPolicy policy =
+					luxSimComponents[i]->GetOptPhotPolicy();
+			policy.rouletteBounces = rouletteBounces;
+			policy.rouletteSurvival = rouletteSurvival;
+			luxSimComponents[i]->SetOptPhotPolicy( policy );
+		}
+	
+	//	0 bounces means the roulette starts with the first reflection
+	if( rouletteSurvival < 1 )
+		useOptPhotPolicies = true;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					IsRegistered()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4bool LUXSimManager::IsRegistered( LUXSimDetectorComponent *component )
+{
+	for( G4int i=0; i<(G4int)luxSimComponents.size(); i++ )
+		if( luxSimComponents[i] == component )
+			return true;
+	
+	return false;
+}
+
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //					GetComponentByName()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -2159,6 +2439,9 @@ void LUXSimManager::ResetSources()
     for( G4int i=0; i<(G4int)sourceByVolume.size(); i++ )
       sourceByVolume[i].component->ResetSources();
     sourceByVolume.clear();
+    if( LUXSimSourceCat )
+        for( G4int i=0; i<LUXSimSourceCat->GetNumSourceTypes(); i++ )
+            LUXSimSourceCat->GetSourceType(i)->ResetSourceCache();
     totalSimulationActivity=0;
     hasLUXSimSources=false;
 }
@@ -2177,6 +2460,90 @@ void LUXSimManager::SetUseOpticalProcesses( G4bool use )
         LUXSimPhysics->SetCutsLong();
 }
 
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					SetOpticalFastPath()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimManager::SetOpticalFastPath( G4String info )
+{
+	//	A space-separated list of physical volume names, or "none"
+	opticalFastPathVolumes.clear();
+	istringstream input( info );
+	G4String volName;
+	while( input >> volName )
+		if( volName != "none" )
+			opticalFastPathVolumes.push_back( volName );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					UpdateOpticalFastPath()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimManager::UpdateOpticalFastPath()
+{
+	//	The region and the model are only made the first time the fast path
+	//	is used, so a run without it has nothing extra in the geometry
+	if( !opticalFastPathRegion ) {
+		if( !opticalFastPathVolumes.size() )
+			return;
+		
+		opticalFastPathRegion = new G4Region( "OpticalFastPathRegion" );
+		G4Region *worldRegion = G4RegionStore::GetInstance()->GetRegion(
+				"DefaultRegionForTheWorld", false );
+		if( worldRegion )
+			opticalFastPathRegion->SetProductionCuts(
+					worldRegion->GetProductionCuts() );
+		opticalFastPathModel = new LUXSimOpticalFastModel( "OpticalFastPath",
+				opticalFastPathRegion );
+	}
+	
+	//	The roots of the region are the logical volumes of the named physical
+	//	volumes
+	vector<G4LogicalVolume*> roots;
+	G4PhysicalVolumeStore *pvStore = G4PhysicalVolumeStore::GetInstance();
+	for( G4int i=0; i<(G4int)opticalFastPathVolumes.size(); i++ ) {
+		G4bool found = false;
+		for( G4int j=0; j<(G4int)pvStore->size(); j++ ) {
+			if( (*pvStore)[j]->GetName() != opticalFastPathVolumes[i] )
+				continue;
+			found = true;
+			G4LogicalVolume *logicalVolume = (*pvStore)[j]->GetLogicalVolume();
+			G4bool isNew = true;
+			for( G4int k=0; k<(G4int)roots.size(); k++ )
+				if( roots[k] == logicalVolume )
+					isNew = false;
+			if( isNew )
+				roots.push_back( logicalVolume );
+		}
+		if( !found ) {
+			G4cout << G4endl << G4endl << G4endl;
+			G4cout << "WARNING: there is no volume called "
+				   << opticalFastPathVolumes[i] << " for the optical fast path"
+				   << G4endl;
+			G4cout << G4endl << G4endl << G4endl;
+		}
+	}
+	
+	if( roots != opticalFastPathRoots ) {
+		for( G4int i=0; i<(G4int)opticalFastPathRoots.size(); i++ )
+			opticalFastPathRegion->RemoveRootLogicalVolume(
+					opticalFastPathRoots[i] );
+		for( G4int i=0; i<(G4int)roots.size(); i++ )
+			opticalFastPathRegion->AddRootLogicalVolume( roots[i] );
+		opticalFastPathRoots = roots;
+		opticalFastPathModel->ClearEnvelopes();
+		G4RunManager::GetRunManager()->GeometryHasBeenModified();
+	}
+	
+	G4cout << "Optical fast path volumes = " << opticalFastPathRoots.size()
+		   << G4endl;
+	G4GlobalFastSimulationManager *fastSimulationManager =
+			G4GlobalFastSimulationManager::GetGlobalFastSimulationManager();
+	if( opticalFastPathRoots.size() )
+		fastSimulationManager->ActivateFastSimulationModel( "OpticalFastPath" );
+	else
+		fastSimulationManager->InactivateFastSimulationModel(
+				"OpticalFastPath" );
+}
+
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //					SetLXeTeflonRefl()
@@ -2340,104 +2707,7 @@ void LUXSimManager::GenerateEventList()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 void LUXSimManager::LoadEventsFile(G4String eventsFile)
 {
-    std::ifstream file;
-    file.open(eventsFile);
-    if (!file.is_open()) {
-        G4cout<<G4endl<<G4endl<<G4endl;
-        G4cout<<"Events File Not Found!"<<G4endl;
-        G4cout<<G4endl<<G4endl<<G4endl;
-        exit(0);
-    }
-    G4int evtN;
-    G4int particleID;
-    G4double energyDep_keV;
-    G4double positionX_cm;
-    G4double positionY_cm;
-    G4double positionZ_cm;
-    while( 1 ) {
-        file >> evtN >> particleID >> energyDep_keV >> positionX_cm >> positionY_cm >> positionZ_cm;
-        if( file.fail() ) {
-             break;
-        }
-        qEvtN.push(evtN);
-        qParticleID.push(particleID);
-        qEnergyDep_keV.push(energyDep_keV*keV);
-        qPositionX_cm.push(positionX_cm*cm);
-        qPositionY_cm.push(positionY_cm*cm);
-        qPositionZ_cm.push(positionZ_cm*cm);
-    }
-}
-
-//------++++++------++++++------++++++------++++++------++++++------++++++------
-//					NextEventToGenerate()
-//------++++++------++++++------++++++------++++++------++++++------++++++------
-
-G4int LUXSimManager::NextEventToGenerate()
-{
-
-    currentEvtN = qEvtN.front();
-    while ( qEvtN.front() == currentEvtN && 
-          !qEvtN.empty() ) {
-        qEvtN.pop();
-        currentParticleID.push(qParticleID.front());
-        qParticleID.pop();
-        currentEnergyDep_keV.push(qEnergyDep_keV.front());
-        qEnergyDep_keV.pop();
-        currentX_cm.push(qPositionX_cm.front());
-        qPositionX_cm.pop();
-        currentY_cm.push(qPositionY_cm.front());
-        qPositionY_cm.pop();
-        currentZ_cm.push(qPositionZ_cm.front());
-        qPositionZ_cm.pop();
-        
-    }
-
-    return currentParticleID.size();
-
-}
-
-//------++++++------++++++------++++++------++++++------++++++------++++++------
-//					NextParticleIDToGenerate()
-//------++++++------++++++------++++++------++++++------++++++------++++++------
-
-G4int LUXSimManager::NextParticleIDToGenerate()
-{
-
-    G4int partilceID = currentParticleID.front();
-    currentParticleID.pop();
-    return partilceID;
-
-}
-
-//------++++++------++++++------++++++------++++++------++++++------++++++------
-//					NextEnergyDepToGenerate()
-//------++++++------++++++------++++++------++++++------++++++------++++++------
-
-G4double LUXSimManager::NextEnergyDepToGenerate()
-{
-
-    G4double energyDep = currentEnergyDep_keV.front();
-    currentEnergyDep_keV.pop();
-    return energyDep;
-
-}
-
-//------++++++------++++++------++++++------++++++------++++++------++++++------
-//					NextPositionToGenerate()
-//------++++++------++++++------++++++------++++++------++++++------++++++------
-
-G4ThreeVector LUXSimManager::NextPositionToGenerate()
-{
-
-    G4ThreeVector pos;
-    pos[0] = currentX_cm.front();
-    currentX_cm.pop();
-    pos[1] = currentY_cm.front();
-    currentY_cm.pop();
-    pos[2] = currentZ_cm.front();
-    currentZ_cm.pop();
-    return pos;
-
+    eventsFileReader.Open(eventsFile);
 }
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -2516,6 +2786,17 @@ void LUXSimManager::SetPMTNumberingScheme( G4String sel )
         useRealPMTNumberingScheme = true;
     if(sel == "linear")
         useRealPMTNumberingScheme = false;
+    ClearPhotoCathodes();
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					ClearPhotoCathodes()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimManager::ClearPhotoCathodes()
+{
+	//	The QE process doesn't exist until the physics list is built
+	if( LUXSimPhysicsOptical && LUXSimPhysicsOptical->GetQuantumEfficiency() )
+		LUXSimPhysicsOptical->GetQuantumEfficiency()->ClearPhotoCathodes();
 }
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -2587,259 +2868,95 @@ void LUXSimManager::ClearRecords()
 }
 
 void LUXSimManager::LoadXYZDependentEField (G4String eFieldFile) {
-  std::ifstream gridFile;
-  gridFile.open(eFieldFile);
-  if (!gridFile.is_open()) {
-      G4cout<<G4endl<<G4endl<<G4endl;
-      G4cout<<"E-Field File Not Found!"<<G4endl;
-      G4cout<<G4endl<<G4endl<<G4endl;
-      exit(0);      
-  }
-  for (int j = 0; j < 598; j++) {
-    for (int i = 0; i < 251; i++) {
-      gridFile >> xyzDependentEField[i][j];
-    }
-  }
-  gridFile.close();
+  eFieldMap.Load(eFieldFile);
 }
 
 G4double LUXSimManager::GetXYZDependentElectricField (G4ThreeVector x1) {
-    G4double R = sqrt(x1[0]*x1[0] + x1[1]*x1[1]);
-    G4double Z = x1[2];
-
-    // for now exploit the fact that we know the grid has 1 mm spacing
-    // i.e. if R is in mm then the index for R is between floor(R) and ceil(R)
-    // this needs to be made more flexible in the future
-    G4int R1 = floor(R);
-    G4int R2 = ceil(R);
-    G4int Z1 = floor(Z);
-    G4int Z2 = ceil(Z);
-
-    // need to deal with cases were an RZ position is on one of the grid points
-
-    G4double E3;
-
-    if (R1 == R2 && Z1 == Z2) {
-        E3 = xyzDependentEField[R1][Z1];
-    }
-    else {
-        if (R1 == R2) {
-            G4double E1 = xyzDependentEField[R1][Z1];
-            G4double E2 = xyzDependentEField[R1][Z2];
-            G4double M3 = (E2 - E1)/(Z2 - Z1);
-            G4double B3 = E1 - M3*Z1;
-            E3 = M3*Z + B3;
-        }
-        else if (Z1 == Z2) {
-            G4double E1 = xyzDependentEField[R1][Z1];
-            G4double E2 = xyzDependentEField[R2][Z1];
-            G4double M3 = (E2 - E1)/(R2 - R1);
-            G4double B3 = E1 - M3*R1;
-            E3 = M3*R + B3;
-        }
-        else {
-            // calculate slope from (R1, Z1) to (R2, Z1) and (R1, Z2) to (R2, Z2)
-            // so we will have two slopes: M1 and M2 and two offsets B1 and B2
-
-            G4double M1 = (xyzDependentEField[R2][Z1] - xyzDependentEField[R1][Z1])/(R2 - R1);
-            G4double M2 = (xyzDependentEField[R2][Z2] - xyzDependentEField[R1][Z2])/(R2 - R1);
-
-            G4double B1 = xyzDependentEField[R1][Z1] - M1*R1;
-            G4double B2 = xyzDependentEField[R2][Z2] - M2*R2;
-
-            G4double E1 = M1*R + B1;
-            G4double E2 = M2*R + B2;
-
-            // we now calculate the slope, M3, and intercept, B3, for these two points
-
-            G4double M3 = (E2 - E1)/(Z2 - Z1);
-            G4double B3 = E1 - M3*Z1;
-
-            // we now can calculate the field at our point (R,Z)
-
-            E3 = M3*Z + B3;
-      }
-  }
-
-  E3 = -1.*E3/1e9; // converter V/m to... V/nm?
-
-  return E3;
+    fieldMapValues values;
+    GetXYZDependentValues(x1, electricFieldQuantity, values);
+    return values.electricField;
 }
 
 void LUXSimManager::LoadXYZDependentDriftTime (G4String driftTimeFile) {
-  std::ifstream gridFile;
-  gridFile.open(driftTimeFile);
-  if (!gridFile.is_open()) {
-      G4cout<<G4endl<<G4endl<<G4endl;
-      G4cout<<"Drift Time File Not Found!"<<G4endl;
-      G4cout<<G4endl<<G4endl<<G4endl;
-      exit(0);      
-  }
-  for (int j = 0; j < 598; j++) {
-    for (int i = 0; i < 251; i++) {
-      gridFile >> xyzDependentDriftTime[i][j];
-    }
-  }
-  gridFile.close();
+  driftTimeMap.Load(driftTimeFile);
 }
 
 G4double LUXSimManager::GetXYZDependentDriftTime (G4ThreeVector x1) {
-    G4double R = sqrt(x1[0]*x1[0] + x1[1]*x1[1]);
-    G4double Z = x1[2];
-
-    // for now exploit the fact that we know the grid has 1 mm spacing
-    // i.e. if R is in mm then the index for R is between floor(R) and ceil(R)
-    // this needs to be made more flexible in the future
-    G4int R1 = floor(R);
-    G4int R2 = ceil(R);
-    G4int Z1 = floor(Z);
-    G4int Z2 = ceil(Z);
-
-    G4double dT3;
-
-    // ok, so now we have four points between which is interpolate
-    // (R1, Z1), (R1, Z2), (R2, Z1), and (R2, Z2)
-    // if the drift time from any of these points is -1 we assume
-    // the drift time is -1 at (R, Z) for simplicity
-
-    if (xyzDependentDriftTime[R1][Z1] < 0 ||
-        xyzDependentDriftTime[R1][Z2] < 0 ||
-        xyzDependentDriftTime[R2][Z1] < 0 ||
-        xyzDependentDriftTime[R2][Z2] < 0) {
-        return -1;
-    }
-    else {
-	// need to deal with cases were an RZ position is on one of the grid points
-        if (R1 == R2 && Z1 == Z2) {
-            dT3 = xyzDependentDriftTime[R1][Z1];
-        }
-	else {
-            if (R1 == R2) {
-                G4double dT1 = xyzDependentDriftTime[R1][Z1];
-                G4double dT2 = xyzDependentDriftTime[R1][Z2];
-                G4double M3 = (dT2 - dT1)/(Z2 - Z1);
-                G4double B3 = dT1 - M3*Z1;
-                dT3 = M3*Z + B3;
-            }
-            else if (Z1 == Z2) {
-                G4double dT1 = xyzDependentDriftTime[R1][Z1];
-                G4double dT2 = xyzDependentDriftTime[R2][Z1];
-                G4double M3 = (dT2 - dT1)/(R2 - R1);
-                G4double B3 = dT1 - M3*R1;
-                dT3 = M3*R + B3;
-            }
-            else {
-                // calculate slope from (R1, Z1) to (R2, Z1) and (R1, Z2) to (R2, Z2)
-                // so we will have two slopes: M1 and M2 and two offsets B1 and B2
-                G4double M1 = (xyzDependentDriftTime[R2][Z1] - xyzDependentDriftTime[R1][Z1])/(R2 - R1);
-                G4double M2 = (xyzDependentDriftTime[R2][Z2] - xyzDependentDriftTime[R1][Z2])/(R2 - R1);
-
-                G4double B1 = xyzDependentDriftTime[R1][Z1] - M1*R1;
-                G4double B2 = xyzDependentDriftTime[R2][Z2] - M2*R2;
-
-                G4double dT1 = M1*R + B1;
-                G4double dT2 = M2*R + B2;
-
-                // we now calculate the slope, M3, and intercept, B3, for these two points
-
-                G4double M3 = (dT2 - dT1)/(Z2 - Z1);
-                G4double B3 = dT1 - M3*Z1;
-
-                // we now can calculate the field at our point (R,Z)
-
-                dT3 = M3*Z + B3;
-            }
-	}
-    }
-    dT3 = dT3 * 1000.; // LUXSim wants drift time in units of ns, not us
-    return dT3;
+    fieldMapValues values;
+    GetXYZDependentValues(x1, driftTimeQuantity, values);
+    return values.driftTime;
 }
 
 void LUXSimManager::LoadXYZDependentRadialDrift (G4String radialDriftFile) {
-  std::ifstream gridFile;
-  gridFile.open(radialDriftFile);
-  if (!gridFile.is_open()) {
-      G4cout<<G4endl<<G4endl<<G4endl;
-      G4cout<<"Radial Drift File Not Found!"<<G4endl;
-      G4cout<<G4endl<<G4endl<<G4endl;
-      exit(0);
-  }
-  for (int j = 0; j < 598; j++) {
-    for (int i = 0; i < 251; i++) {
-      gridFile >> xyzDependentRadialDrift[i][j];
-    }
-  }
-  gridFile.close();
+  radialDriftMap.Load(radialDriftFile);
 }
 
 G4double LUXSimManager::GetXYZDependentRadialDrift (G4ThreeVector x1) {
-    G4double R = sqrt(x1[0]*x1[0] + x1[1]*x1[1]);
-    G4double Z = x1[2];
-
-    // for now exploit the fact that we know the grid has 1 mm spacing
-    // i.e. if R is in mm then the index for R is between floor(R) and ceil(R)
-    // this needs to be made more flexible in the future
-    G4int R1 = floor(R);
-    G4int R2 = ceil(R);
-    G4int Z1 = floor(Z);
-    G4int Z2 = ceil(Z);
-
-    G4double tR3;
-
-    // ok, so now we have four points between which is interpolate
-    // (R1, Z1), (R1, Z2), (R2, Z1), and (R2, Z2)
-    // if the drift time from any of these points is -1 we assume
-    // the drift time is -1 at (R, Z) for simplicity
-
-    if (xyzDependentRadialDrift[R1][Z1] < 0 ||
-        xyzDependentRadialDrift[R1][Z2] < 0 ||
-        xyzDependentRadialDrift[R2][Z1] < 0 ||
-        xyzDependentRadialDrift[R2][Z2] < 0) {
-        return -1;
-    }
-    else {
-	// need to deal with cases were an RZ position is on one of the grid points
-        if (R1 == R2 && Z1 == Z2) {
-            tR3 = xyzDependentRadialDrift[R1][Z1];
+    fieldMapValues values;
+    GetXYZDependentValues(x1, radialDriftQuantity, values);
+    return values.radialDrift;
+}
+
+void LUXSimManager::GetXYZDependentValues (G4int numPoints,
+        const G4ThreeVector *x1, G4int quantities, fieldMapValues *values) {
+    G4bool useEField = (quantities & electricFieldQuantity);
+    G4bool useDriftTime = (quantities & driftTimeQuantity);
+    G4bool useRadialDrift = (quantities & radialDriftQuantity);
+    if (!quantities) return;
+    if (useEField && !eFieldMap.IsLoaded()) eFieldMap.Load(EFieldFile);
+    if (useDriftTime && !driftTimeMap.IsLoaded())
+        driftTimeMap.Load(DriftTimeFile);
+    if (useRadialDrift && !radialDriftMap.IsLoaded())
+        radialDriftMap.Load(RadialDriftFile);
+
+    // the maps normally share a grid, in which case the cell is only found
+    // once per point and used for all of them. Each map can be 2D (r, z) or
+    // 3D (x, y, z).
+    const LUXSimFieldMap *firstMap = (useEField ? &eFieldMap :
+            (useDriftTime ? &driftTimeMap : &radialDriftMap));
+    G4bool driftTimeOwnCell = !driftTimeMap.HasSameGrid(*firstMap);
+    G4bool radialDriftOwnCell = !radialDriftMap.HasSameGrid(*firstMap);
+
+    fieldMapCell cell, ownCell;
+    for (G4int i = 0; i < numPoints; i++) {
+        firstMap->FindCell(x1[i], cell);
+
+        values[i].electricField = 0;
+        values[i].driftTime = 0;
+        values[i].radialDrift = 0;
+
+        if (useEField) {
+            // converter V/m to... V/nm?
+            values[i].electricField = -1.*eFieldMap.Interpolate(cell)/1e9;
         }
-	else {
-            if (R1 == R2) {
-                G4double tR1 = xyzDependentRadialDrift[R1][Z1];
-                G4double tR2 = xyzDependentRadialDrift[R1][Z2];
-                G4double M3 = (tR2 - tR1)/(Z2 - Z1);
-                G4double B3 = tR1 - M3*Z1;
-                tR3 = M3*Z + B3;
-            }
-            else if (Z1 == Z2) {
-                G4double tR1 = xyzDependentRadialDrift[R1][Z1];
-                G4double tR2 = xyzDependentRadialDrift[R2][Z1];
-                G4double M3 = (tR2 - tR1)/(R2 - R1);
-                G4double B3 = tR1 - M3*R1;
-                tR3 = M3*R + B3;
-            }
-            else {
-                // calculate slope from (R1, Z1) to (R2, Z1) and (R1, Z2) to (R2, Z2)
-                // so we will have two slopes: M1 and M2 and two offsets B1 and B2
-                G4double M1 = (xyzDependentRadialDrift[R2][Z1] - xyzDependentRadialDrift[R1][Z1])/(R2 - R1);
-                G4double M2 = (xyzDependentRadialDrift[R2][Z2] - xyzDependentRadialDrift[R1][Z2])/(R2 - R1);
-
-                G4double B1 = xyzDependentRadialDrift[R1][Z1] - M1*R1;
-                G4double B2 = xyzDependentRadialDrift[R2][Z2] - M2*R2;
-
-                G4double tR1 = M1*R + B1;
-                G4double tR2 = M2*R + B2;
-
-                // we now calculate the slope, M3, and intercept, B3, for these two points
 
-                G4double M3 = (tR2 - tR1)/(Z2 - Z1);
-                G4double B3 = tR1 - M3*Z1;
-
-                // we now can calculate the field at our point (R,Z)
+        // if the drift time from any of the grid points around the point is
+        // -1 we assume the drift time is -1 there for simplicity, and the
+        // same for the radial drift
+        if (useDriftTime) {
+            const fieldMapCell *driftCell = &cell;
+            if (driftTimeOwnCell) {
+                driftTimeMap.FindCell(x1[i], ownCell);
+                driftCell = &ownCell;
+            }
+            if (driftTimeMap.HasNegativeCorner(*driftCell))
+                values[i].driftTime = -1;
+            else // LUXSim wants drift time in units of ns, not us
+                values[i].driftTime =
+                        driftTimeMap.Interpolate(*driftCell) * 1000.;
+        }
 
-                tR3 = M3*Z + B3;
+        if (useRadialDrift) {
+            const fieldMapCell *radialCell = &cell;
+            if (radialDriftOwnCell) {
+                radialDriftMap.FindCell(x1[i], ownCell);
+                radialCell = &ownCell;
             }
-	}
+            if (radialDriftMap.HasNegativeCorner(*radialCell))
+                values[i].radialDrift = -1;
+            else // convert cm to mm
+                values[i].radialDrift =
+                        radialDriftMap.Interpolate(*radialCell) * 10.;
+        }
     }
-    tR3 = tR3 * 10.; // convert cm to mm
-    return tR3;
 }
@@ -96,6 +96,27 @@
 *   14-Oct-14 - Added component-wise SetMass and SetVolume commands (Kareem)
 *   02-Feb-15 - Added pencil beam command for the LUX DD generator (Kevin)
 *   15-Jul-15 - Added option to turn on/off the cavern rock geometry (David W)
+*   19-Oct-26 - Added /LUXSim/io/profile to turn on the run profiler
+*   19-Oct-26 - Added /LUXSim/io/progressLog, and updated the updateFrequency
+*               guidance for the new progress report contents
+*   19-Oct-26 - Added the "parameterised" choice to /LUXSim/detector/gridWires
+*   19-Oct-26 - Added /LUXSim/source/LZbkgComponent
+*   19-Oct-26 - Added /LUXSim/detector/optPhotKill, optPhotMaxBounces,
+*               optPhotMaxPathLength and optPhotRoulette
+*   19-Oct-26 - Added the /LUXSim/lightMap/ commands
+*   19-Oct-26 - Added /LUXSim/io/opticalPaths
+*   19-Oct-26 - Added /LUXSim/physicsList/opticalFastPath
+*   19-Oct-26 - The optPhotRoulette guidance says what 0 reflections means
+*   19-Oct-26 - The LZbkgComponent guidance says LZbkgGammas only has "all"
+*   19-Oct-26 - The progress guidance says which rates need the progress log
+*   19-Oct-26 - The gridWires guidance says the parameterised wires can't be
+*               looked up by name
+*   19-Oct-26 - The lightMap guidance says grid maps aren't FastSim libraries
+*   19-Oct-26 - The optical photon policy guidance says which volume a
+*               reflection counts in
+*   19-Oct-26 - The step and track rates no longer need the progress log
+*   19-Oct-26 - The gridWires guidance says the holders of parameterised wires
+*               can't be recorded
 */
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -118,6 +139,7 @@
 //
 #include "LUXSimMessenger.hh"
 #include "LUXSimManager.hh"
+#include "LUXSimLightMap.hh"
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //					LUXSimMessenger()
@@ -159,7 +181,9 @@ LUXSimMessenger::LUXSimMessenger( LUXSimManager *man )
     LUXSimEventProgressCommand = new G4UIcmdWithAnInteger( "/LUXSim/io/updateFrequency", this );
     LUXSimEventProgressCommand->SetGuidance( "This controls after how many events a progress report is printed to screen that" );
     LUXSimEventProgressCommand->SetGuidance( "includes the current event number and the total number of seconds that have" );
-    LUXSimEventProgressCommand->SetGuidance( "elapsed since the begininning of Event 1." );
+    LUXSimEventProgressCommand->SetGuidance( "elapsed since the begininning of Event 1, followed by the event, step and" );
+    LUXSimEventProgressCommand->SetGuidance( "track rates, optical photons and thermal electrons per event, output rate," );
+    LUXSimEventProgressCommand->SetGuidance( "resident memory and the estimated time to completion." );
     
     LUXSim100keVHackCommand = new G4UIcmdWithADoubleAndUnit( "/LUXSim/io/upperEnergyHack", this );
     LUXSim100keVHackCommand->SetGuidance( "Sets the upper energy cut for the active liquid xenon. If the total energy" );
@@ -168,6 +192,29 @@ LUXSimMessenger::LUXSimMessenger( LUXSimManager *man )
     LUXSim100keVHackCommand->SetGuidance( "active liquid xenon will be recorded. Default is off.");
     LUXSim100keVHackCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
 
+    LUXSimProfileCommand = new G4UIcmdWithABool( "/LUXSim/io/profile", this );
+    LUXSimProfileCommand->SetGuidance( "Turns on the run profiler. The number of steps, tracks, secondaries and the CPU" );
+    LUXSimProfileCommand->SetGuidance( "time are accumulated by volume, particle and process, printed as a sorted table" );
+    LUXSimProfileCommand->SetGuidance( "at the end of each run, and written to <outputName><seed>_profile.txt in the" );
+    LUXSimProfileCommand->SetGuidance( "output directory. The default is false." );
+    LUXSimProfileCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
+
+    LUXSimProgressLogCommand = new G4UIcmdWithABool( "/LUXSim/io/progressLog", this );
+    LUXSimProgressLogCommand->SetGuidance( "Writes every progress report (see /LUXSim/io/updateFrequency) as one JSON" );
+    LUXSimProgressLogCommand->SetGuidance( "object per line to <outputName><seed>_progress.jsonl in the output directory," );
+    LUXSimProgressLogCommand->SetGuidance( "so batch jobs can be monitored for stalls and slowdowns. Each run is appended" );
+    LUXSimProgressLogCommand->SetGuidance( "to the file, and each line has its run number. The default is false." );
+    LUXSimProgressLogCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
+
+    LUXSimOpticalPathsCommand = new G4UIcmdWithABool( "/LUXSim/io/opticalPaths", this );
+    LUXSimOpticalPathsCommand->SetGuidance( "Writes a record of the optical path of every photon that reaches a photocathode" );
+    LUXSimOpticalPathsCommand->SetGuidance( "to <outputName><seed>_optPaths.bin in the output directory: the path length and" );
+    LUXSimOpticalPathsCommand->SetGuidance( "Rayleigh scatters in each material, and the reflections off each optical surface." );
+    LUXSimOpticalPathsCommand->SetGuidance( "tools/LUXSimOpticalReweight.py uses these records to reweight the events for" );
+    LUXSimOpticalPathsCommand->SetGuidance( "other reflectivities, absorption lengths and Rayleigh lengths. The default is" );
+    LUXSimOpticalPathsCommand->SetGuidance( "false." );
+    LUXSimOpticalPathsCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
+
     // User defined variables commands.
 	LUXSimUserVar1Command = new G4UIcmdWithADouble( "/LUXSim/io/userVar1", this);
 	LUXSimUserVar1Command->SetGuidance("Set userVar1 in the manager class. Useful for passing arbitrary parameters from macros." );
@@ -242,7 +289,17 @@ LUXSimMessenger::LUXSimMessenger( LUXSimManager *man )
 	LUXSimGridWiresCommand = new G4UIcmdWithAString( "/LUXSim/detector/gridWires", this );
 	LUXSimGridWiresCommand->SetGuidance( "Selects grid wire option. The default" );
 	LUXSimGridWiresCommand->SetGuidance( "choice is \"off\"." );
-	LUXSimGridWiresCommand->SetCandidates( "on off" );
+	LUXSimGridWiresCommand->SetGuidance( "\"on\" builds each wire as its own volume." );
+	LUXSimGridWiresCommand->SetGuidance( "\"parameterised\" builds each wire plane as a" );
+	LUXSimGridWiresCommand->SetGuidance( "single parameterised volume, which is much faster" );
+	LUXSimGridWiresCommand->SetGuidance( "to build and navigate. The wires are then not" );
+	LUXSimGridWiresCommand->SetGuidance( "detector components, so anything that finds a" );
+	LUXSimGridWiresCommand->SetGuidance( "volume by name (record levels, sources, optical" );
+	LUXSimGridWiresCommand->SetGuidance( "photon policies) can't be applied to the wires," );
+	LUXSimGridWiresCommand->SetGuidance( "and the run won't start if a volume holding them" );
+	LUXSimGridWiresCommand->SetGuidance( "has a record level or an optical photon policy." );
+	LUXSimGridWiresCommand->SetGuidance( "Use \"on\" for that." );
+	LUXSimGridWiresCommand->SetCandidates( "on off parameterised" );
 	LUXSimGridWiresCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
 
 	LUXSimRecordLevelCommand = new G4UIcmdWithAString( "/LUXSim/detector/recordLevel", this );
@@ -257,6 +314,39 @@ LUXSimMessenger::LUXSimMessenger( LUXSimManager *man )
 	LUXSimRecordLevelThermElecCommand->SetGuidance( "Sets the thermal electron record level of a volume according to the volume name." );
 	LUXSimRecordLevelThermElecCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
 	
+	LUXSimOptPhotKillCommand = new G4UIcmdWithAString( "/LUXSim/detector/optPhotKill", this );
+	LUXSimOptPhotKillCommand->SetGuidance( "Kills optical photons as soon as they enter a volume, for volumes" );
+	LUXSimOptPhotKillCommand->SetGuidance( "from which they can never reach a photocathode. The volume name is" );
+	LUXSimOptPhotKillCommand->SetGuidance( "followed by true or false, e.g. \"OuterCryostat true\". Photons that" );
+	LUXSimOptPhotKillCommand->SetGuidance( "are only reflected off the volume's surface aren't killed." );
+	LUXSimOptPhotKillCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
+	
+	LUXSimOptPhotMaxBouncesCommand = new G4UIcmdWithAString( "/LUXSim/detector/optPhotMaxBounces", this );
+	LUXSimOptPhotMaxBouncesCommand->SetGuidance( "Kills optical photons in a volume once they have been reflected" );
+	LUXSimOptPhotMaxBouncesCommand->SetGuidance( "this many times, counting every reflection since the photon was made." );
+	LUXSimOptPhotMaxBouncesCommand->SetGuidance( "The volume name is followed by the number of reflections. 0 (the" );
+	LUXSimOptPhotMaxBouncesCommand->SetGuidance( "default) means no limit. A reflection counts in the volume the photon" );
+	LUXSimOptPhotMaxBouncesCommand->SetGuidance( "is reflected back into, not the one it was reflected off, and the same" );
+	LUXSimOptPhotMaxBouncesCommand->SetGuidance( "goes for optPhotMaxPathLength and optPhotRoulette." );
+	LUXSimOptPhotMaxBouncesCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
+	
+	LUXSimOptPhotMaxPathLengthCommand = new G4UIcmdWithAString( "/LUXSim/detector/optPhotMaxPathLength", this );
+	LUXSimOptPhotMaxPathLengthCommand->SetGuidance( "Kills optical photons in a volume once they have travelled this far." );
+	LUXSimOptPhotMaxPathLengthCommand->SetGuidance( "The volume name is followed by the length and its unit (mm if no" );
+	LUXSimOptPhotMaxPathLengthCommand->SetGuidance( "unit is given). 0 (the default) means no limit." );
+	LUXSimOptPhotMaxPathLengthCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
+	
+	LUXSimOptPhotRouletteCommand = new G4UIcmdWithAString( "/LUXSim/detector/optPhotRoulette", this );
+	LUXSimOptPhotRouletteCommand->SetGuidance( "Plays Russian roulette with optical photons in a volume. Past the" );
+	LUXSimOptPhotRouletteCommand->SetGuidance( "given number of reflections, each reflection keeps the photon with the" );
+	LUXSimOptPhotRouletteCommand->SetGuidance( "given survival probability, and the photons that are kept count for" );
+	LUXSimOptPhotRouletteCommand->SetGuidance( "1/probability photons at the photocathodes. The volume name is followed" );
+	LUXSimOptPhotRouletteCommand->SetGuidance( "by the number of reflections and the survival probability, e.g." );
+	LUXSimOptPhotRouletteCommand->SetGuidance( "\"LiquidXenon 20 0.5\" for the reflections of photons in the liquid off" );
+	LUXSimOptPhotRouletteCommand->SetGuidance( "the PTFE and the grids. With 0 reflections the roulette starts at the first" );
+	LUXSimOptPhotRouletteCommand->SetGuidance( "reflection, and a survival probability of 1 turns it off." );
+	LUXSimOptPhotRouletteCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
+	
 	LUXSimCollimatorHeightCommand = new G4UIcmdWithADoubleAndUnit( "/LUXSim/detector/collimatorHeight", this );
 	LUXSimCollimatorHeightCommand->SetGuidance( "Sets the height of the collimator relative to detector center." );
 	LUXSimCollimatorHeightCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
@@ -454,6 +544,14 @@ LUXSimMessenger::LUXSimMessenger( LUXSimManager *man )
 	LUXSimSourceResetCommand->SetGuidance( "Clears all previously set sources" );
 	LUXSimSourceResetCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
 
+	LUXSimSourceLZbkgComponentCommand = new G4UIcmdWithAString( "/LUXSim/source/LZbkgComponent", this );
+	LUXSimSourceLZbkgComponentCommand->SetGuidance( "Selects which component's position map and energy spectrum the" );
+	LUXSimSourceLZbkgComponentCommand->SetGuidance( "LZbkgGammas and LZbkgNeutrons generators use. The default is \"all\"." );
+	LUXSimSourceLZbkgComponentCommand->SetGuidance( "LZbkgGammas only has the \"all\" map; pmt, ptfe and cryo are for" );
+	LUXSimSourceLZbkgComponentCommand->SetGuidance( "LZbkgNeutrons only." );
+	LUXSimSourceLZbkgComponentCommand->SetCandidates( "all pmt ptfe cryo" );
+	LUXSimSourceLZbkgComponentCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
+
 	//	Physics list commands
 	LUXSimPhysicsListDir = new G4UIdirectory( "/LUXSim/physicsList/" );
 	LUXSimPhysicsListDir->SetGuidance( "Commands to control the physics list" );
@@ -478,6 +576,17 @@ LUXSimMessenger::LUXSimMessenger( LUXSimManager *man )
  	LUXSimDriftingElectronAttenuationCommand->SetGuidance( "Sets the attenuation length for drifting electrons" );
 	LUXSimDriftingElectronAttenuationCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
 	
+	LUXSimOpticalFastPathCommand = new G4UIcmdWithAString( "/LUXSim/physicsList/opticalFastPath", this );
+	LUXSimOpticalFastPathCommand->SetGuidance( "Names the optically homogeneous volumes in which optical photons are moved from" );
+	LUXSimOpticalFastPathCommand->SetGuidance( "one absorption or Rayleigh scatter to the next analytically, rather than one step" );
+	LUXSimOpticalFastPathCommand->SetGuidance( "at a time. Every boundary is still handled by the normal tracking, so the results" );
+	LUXSimOpticalFastPathCommand->SetGuidance( "are the same in distribution. The volumes are given as a space-separated list of" );
+	LUXSimOpticalFastPathCommand->SetGuidance( "physical volume names, such as LiquidXenon (LUX), LiquidXenonTarget (LZDetector)" );
+	LUXSimOpticalFastPathCommand->SetGuidance( "or ActiveLiquidXenon (LZSimple). A volume with replicated or parameterised" );
+	LUXSimOpticalFastPathCommand->SetGuidance( "daughters, such as parameterised grid wires, is tracked as usual. Use \"none\" to" );
+	LUXSimOpticalFastPathCommand->SetGuidance( "turn the fast path off, which is the default." );
+	LUXSimOpticalFastPathCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
+	
 	//	Materials commands
 	LUXSimMaterialsDir = new G4UIdirectory( "/LUXSim/materials/" );
 	LUXSimMaterialsDir->SetGuidance( "Commands to control material properties" );
@@ -517,6 +626,50 @@ LUXSimMessenger::LUXSimMessenger( LUXSimManager *man )
 	LUXSimAlUnoxQuartzReflCommand = new G4UIcmdWithADouble( "/LUXSim/materials/AlUnoxidizedQuartzRefl", this );
 	LUXSimAlUnoxQuartzReflCommand->SetGuidance( "Sets the unoxidized Al / quartz reflectivity (value between 0 and 1)" );
 	LUXSimAlUnoxQuartzReflCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
+	
+	//	Light map commands
+	LUXSimLightMapDir = new G4UIdirectory( "/LUXSim/lightMap/" );
+	LUXSimLightMapDir->SetGuidance( "Commands to build a light collection map in one job. Only a map built with" );
+	LUXSimLightMapDir->SetGuidance( "/LUXSim/lightMap/samples can be loaded as a FastSim library." );
+	
+	LUXSimLightMapGridCommand = new G4UIcmdWithAString( "/LUXSim/lightMap/grid", this );
+	LUXSimLightMapGridCommand->SetGuidance( "Sets the emission points to a regular grid. Give the minimum, maximum" );
+	LUXSimLightMapGridCommand->SetGuidance( "and number of points along x, then y, then z, and the unit, e.g." );
+	LUXSimLightMapGridCommand->SetGuidance( "\"-240 240 49 -240 240 49 10 540 53 mm\". The map has the FastSim line" );
+	LUXSimLightMapGridCommand->SetGuidance( "format, but FastSim's fixed position IDs and z levels don't match a grid," );
+	LUXSimLightMapGridCommand->SetGuidance( "so it can't be loaded as a FastSim library." );
+	LUXSimLightMapGridCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
+	
+	LUXSimLightMapSamplesCommand = new G4UIcmdWithAString( "/LUXSim/lightMap/samples", this );
+	LUXSimLightMapSamplesCommand->SetGuidance( "Sets the emission points to the points of an existing FastSim library" );
+	LUXSimLightMapSamplesCommand->SetGuidance( "file, so that the new map can replace it." );
+	LUXSimLightMapSamplesCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
+	
+	LUXSimLightMapPhotonsCommand = new G4UIcmdWithAnInteger( "/LUXSim/lightMap/photons", this );
+	LUXSimLightMapPhotonsCommand->SetGuidance( "Sets the number of photons fired from each point. The default is 10000." );
+	LUXSimLightMapPhotonsCommand->SetParameterName( "photons", false );
+	LUXSimLightMapPhotonsCommand->SetRange( "photons > 0" );
+	LUXSimLightMapPhotonsCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
+	
+	LUXSimLightMapEnergyCommand = new G4UIcmdWithADoubleAndUnit( "/LUXSim/lightMap/energy", this );
+	LUXSimLightMapEnergyCommand->SetGuidance( "Sets the energy of the photons. The default is 7 eV." );
+	LUXSimLightMapEnergyCommand->SetDefaultUnit( "eV" );
+	LUXSimLightMapEnergyCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
+	
+	LUXSimLightMapShardCommand = new G4UIcmdWithAString( "/LUXSim/lightMap/shard", this );
+	LUXSimLightMapShardCommand->SetGuidance( "Builds only one shard of the map. Give the shard index, from 0, and the" );
+	LUXSimLightMapShardCommand->SetGuidance( "number of shards, e.g. \"3 16\". Each shard takes every n-th point and" );
+	LUXSimLightMapShardCommand->SetGuidance( "writes <file>_shard<index>of<n>. The shard files can be concatenated." );
+	LUXSimLightMapShardCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
+	
+	LUXSimLightMapFileCommand = new G4UIcmdWithAString( "/LUXSim/lightMap/file", this );
+	LUXSimLightMapFileCommand->SetGuidance( "Sets the map file name. The default is LUXSimLightMap.dat." );
+	LUXSimLightMapFileCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
+	
+	LUXSimLightMapBuildCommand = new G4UIcmdWithoutParameter( "/LUXSim/lightMap/build", this );
+	LUXSimLightMapBuildCommand->SetGuidance( "Builds the map, with one event per point. Points already in the map" );
+	LUXSimLightMapBuildCommand->SetGuidance( "file are skipped, so a build that was stopped can be picked up again." );
+	LUXSimLightMapBuildCommand->AvailableForStates( G4State_PreInit, G4State_Idle );
 }
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -536,6 +689,9 @@ LUXSimMessenger::~LUXSimMessenger()
 	delete LUXSimAlwaysRecordPrimaryCommand;
     delete LUXSimEventProgressCommand;
     delete LUXSim100keVHackCommand;
+    delete LUXSimProfileCommand;
+    delete LUXSimProgressLogCommand;
+    delete LUXSimOpticalPathsCommand;
 
 	// User defined variables commands.
 	delete LUXSimUserVar1Command;
@@ -559,6 +715,10 @@ LUXSimMessenger::~LUXSimMessenger()
 	delete LUXSimRecordLevelCommand;
 	delete LUXSimRecordLevelOptPhotCommand;
 	delete LUXSimRecordLevelThermElecCommand;
+	delete LUXSimOptPhotKillCommand;
+	delete LUXSimOptPhotMaxBouncesCommand;
+	delete LUXSimOptPhotMaxPathLengthCommand;
+	delete LUXSimOptPhotRouletteCommand;
 	delete LUXSimCollimatorHeightCommand;
     delete LUXSimCollimatorHoleCommand;
 	delete LUXSimCollimatorSourceDiameterCommand;
@@ -608,6 +768,7 @@ LUXSimMessenger::~LUXSimMessenger()
 	delete LUXSimSourceSetCommand;
 	delete LUXSimSourceResetCommand;
 	delete LUXSimSourcePrintCommand;
+	delete LUXSimSourceLZbkgComponentCommand;
 
 	//	Physics list commands
 	delete LUXSimPhysicsListDir;
@@ -616,6 +777,7 @@ LUXSimMessenger::~LUXSimMessenger()
     delete LUXSimS1GainCommand;
     delete LUXSimS2GainCommand;
 	delete LUXSimDriftingElectronAttenuationCommand;
+	delete LUXSimOpticalFastPathCommand;
 	
 	//	Materials commands
 	delete LUXSimMaterialsDir;	
@@ -628,6 +790,16 @@ LUXSimMessenger::~LUXSimMessenger()
 	delete LUXSimGXeAbsCommand;
 	delete LUXSimGXeRayleighCommand;
 	delete LUXSimAlUnoxQuartzReflCommand;
+	
+	//	Light map commands
+	delete LUXSimLightMapDir;
+	delete LUXSimLightMapGridCommand;
+	delete LUXSimLightMapSamplesCommand;
+	delete LUXSimLightMapPhotonsCommand;
+	delete LUXSimLightMapEnergyCommand;
+	delete LUXSimLightMapShardCommand;
+	delete LUXSimLightMapFileCommand;
+	delete LUXSimLightMapBuildCommand;
 }
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -653,6 +825,12 @@ void LUXSimMessenger::SetNewValue( G4UIcommand *command, G4String newValue )
 		luxManager->SetEventProgressFrequency( LUXSimEventProgressCommand->GetNewIntValue(newValue) );
 	else if( command == LUXSim100keVHackCommand )
 		luxManager->Set100keVHack( LUXSim100keVHackCommand->GetNewDoubleValue( newValue.data() ) );
+	else if( command == LUXSimProfileCommand )
+		luxManager->SetProfiling( LUXSimProfileCommand->GetNewBoolValue(newValue) );
+	else if( command == LUXSimProgressLogCommand )
+		luxManager->SetProgressLog( LUXSimProgressLogCommand->GetNewBoolValue(newValue) );
+	else if( command == LUXSimOpticalPathsCommand )
+		luxManager->SetRecordOpticalPaths( LUXSimOpticalPathsCommand->GetNewBoolValue(newValue) );
 
 	// User defined variables commands
 	else if( command == LUXSimUserVar1Command )
@@ -709,6 +887,18 @@ void LUXSimMessenger::SetNewValue( G4UIcommand *command, G4String newValue )
 	else if( command == LUXSimRecordLevelThermElecCommand )
 		luxManager->SetRecordLevelThermElec( newValue );
 	
+	else if( command == LUXSimOptPhotKillCommand )
+		luxManager->SetOptPhotKill( newValue );
+	
+	else if( command == LUXSimOptPhotMaxBouncesCommand )
+		luxManager->SetOptPhotMaxBounces( newValue );
+	
+	else if( command == LUXSimOptPhotMaxPathLengthCommand )
+		luxManager->SetOptPhotMaxPathLength( newValue );
+	
+	else if( command == LUXSimOptPhotRouletteCommand )
+		luxManager->SetOptPhotRoulette( newValue );
+	
 	else if( command == LUXSimCollimatorHeightCommand )
 		luxManager->SetCollimatorHeight( G4UIcmdWithADoubleAndUnit::GetNewDoubleValue( newValue.data() ) );
 	
@@ -827,6 +1017,9 @@ void LUXSimMessenger::SetNewValue( G4UIcommand *command, G4String newValue )
 	else if( command == LUXSimSourcePrintCommand )
 		luxManager->SetPrintEventList( newValue );
 
+	else if( command == LUXSimSourceLZbkgComponentCommand )
+		luxManager->SetLZbkgComponent( newValue );
+
 	//	Physics list commands
 	else if( command == LUXSimOpticalPhotonsCommand )
 		luxManager->SetUseOpticalProcesses( LUXSimOpticalPhotonsCommand->GetNewBoolValue(newValue) );
@@ -843,6 +1036,9 @@ void LUXSimMessenger::SetNewValue( G4UIcommand *command, G4String newValue )
 	else if( command == LUXSimDriftingElectronAttenuationCommand )
 		luxManager->SetDriftElecAttenuation( G4UIcmdWithADoubleAndUnit::GetNewDoubleValue( newValue.data() ) );
 	
+	else if( command == LUXSimOpticalFastPathCommand )
+		luxManager->SetOpticalFastPath( newValue );
+	
 	//	Materials commands
 	else if ( command == LUXSimLXeTeflonReflCommand )
 		luxManager->SetLXeTeflonRefl( G4UIcmdWithADouble::GetNewDoubleValue( newValue.data() ) );
@@ -871,4 +1067,25 @@ void LUXSimMessenger::SetNewValue( G4UIcommand *command, G4String newValue )
 	else if ( command == LUXSimAlUnoxQuartzReflCommand )
 		luxManager->SetAlUnoxQuartzRefl( G4UIcmdWithADouble::GetNewDoubleValue( newValue.data() ) );
 	
+	else if( command == LUXSimLightMapGridCommand )
+		luxManager->GetLightMap()->SetGrid( newValue );
+	
+	else if( command == LUXSimLightMapSamplesCommand )
+		luxManager->GetLightMap()->SetSamples( newValue );
+	
+	else if( command == LUXSimLightMapPhotonsCommand )
+		luxManager->GetLightMap()->SetNumPhotons( LUXSimLightMapPhotonsCommand->GetNewIntValue( newValue ) );
+	
+	else if( command == LUXSimLightMapEnergyCommand )
+		luxManager->GetLightMap()->SetPhotonEnergy( G4UIcmdWithADoubleAndUnit::GetNewDoubleValue( newValue.data() ) );
+	
+	else if( command == LUXSimLightMapShardCommand )
+		luxManager->GetLightMap()->SetShard( newValue );
+	
+	else if( command == LUXSimLightMapFileCommand )
+		luxManager->GetLightMap()->SetFileName( newValue );
+	
+	else if( command == LUXSimLightMapBuildCommand )
+		luxManager->BuildLightMap();
+	
 }
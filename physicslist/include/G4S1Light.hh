@@ -86,12 +86,8 @@ public: // methods, with descriptions
         G4double GetScintillationExcitationRatio() const;
         // Returns the ratio of the number of excitons to ions. Read above.
 
-        // the next block of functions are for loading XYZ dependent drift times
-        // and radial drift from charging teflon from Scott's COMSOL simulations
-        void LoadXYZDependentDriftTime (G4String driftTimeFile);
-        double GetXYZDependentDriftTime (G4ThreeVector x1);
-        void LoadXYZDependentRadialDrift (G4String radialDriftFile);
-        double GetXYZDependentRadialDrift (G4ThreeVector x1);
+        // the XYZ dependent drift times and radial drift from charging teflon
+        // are held by LUXSimManager, so there is only one copy of each map
         void LoadS1PulseShape(G4String fileName);
         G4double GetLiquidElectronDriftSpeed( G4double, G4double, G4bool, G4int,
                 G4bool, G4double, G4double);
@@ -112,8 +108,6 @@ protected:
         G4double YieldFactor; // turns scint. on/off
         G4double ExcitationRatio; // N_ex/N_i, the dimensionless ratio of
         //initial excitons to ions
-        G4double xyzDependentDriftTime[251][598]; // grid for drift time
-        G4double xyzDependentRadialDrift[251][598]; // grid for final R position
         G4double s1PulseShape[201];
         
 
@@ -0,0 +1,209 @@
+////////////////////////////////////////////////////////////////////////////////
+/*	LUXSimFieldMap.hh
+*
+* This is the header file for a map of one quantity (electric field, drift
+* time or radial drift) on a regular grid, as calculated by COMSOL. The grid is
+* either 2D in r and z, for axisymmetric fields, or 3D in x, y and z. The
+* manager holds one map per quantity, and everything that needs the maps goes
+* through the manager, so each map is only in memory once.
+*
+* The 2D text maps have a line per z value, with the r values across each line.
+* The number of lines and of values per line set the size of the grid. The
+* origin and spacing of the grid default to 0 and 1 mm, and can be changed
+* with header lines at the top of the file, e.g.
+*
+*	# rOrigin 0
+*	# zOrigin 0
+*	# rSpacing 0.5
+*	# zSpacing 0.5
+*
+* in mm. "# numR" and "# numZ" header lines are also allowed, and are checked
+* against the data.
+*
+* A 3D map starts with a "# coordinates xyz" header line, and needs a "# numY"
+* line. The x values go across each line, and there is a line for each y value
+* for each z value, y varying fastest. The origin and spacing are set with the
+* xOrigin, yOrigin, zOrigin, xSpacing, ySpacing and zSpacing header lines.
+*
+* A "# precision float" header line keeps the values in single precision,
+* which halves the memory a large 3D map takes.
+*
+* Because the text maps are several MB, the parsed grid is also written to a
+* binary cache next to the map (<map>.cache). The cache is a fixed 88-byte
+* header followed by the values, and is memory mapped rather than read, so
+* loading a map costs next to nothing once the cache exists. The cache is used
+* for as long as the size and modification time of the map haven't changed.
+*
+* Values between the grid points are interpolated bilinearly in r and z, or
+* trilinearly in x, y and z. Points off the grid are moved to the nearest edge,
+* so each map is flat beyond its edges.
+*
+********************************************************************************
+* Change log
+*	19-Oct-26 - Initial submission
+*	19-Oct-26 - Added FindCell(), Interpolate(), HasNegativeCorner() and
+*				HasSameGrid(), the interpolation kernel shared by all the maps
+*	19-Oct-26 - Added 3D maps and single precision storage
+*
+*/
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LUXSimFieldMap_HH
+#define LUXSimFieldMap_HH 1
+
+//
+//	C/C++ includes
+//
+#include <vector>
+#include <cstddef>
+#include <cmath>
+
+//
+//	GEANT4 includes
+//
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+
+//
+//	Definitions
+//
+struct fieldMapCell {
+	G4int index;			//	of the corner at the lowest coordinates
+	G4double xFraction;		//	how far across the cell the point is, 0 to 1.
+	G4double yFraction;		//	For 2D maps x is r, and yFraction is 0.
+	G4double zFraction;
+};
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+class LUXSimFieldMap
+{
+	public:
+		LUXSimFieldMap( G4String description );
+		~LUXSimFieldMap();
+
+	public:
+		//	Does nothing if the map was already loaded from this file
+		void Load( G4String fileName );
+		G4bool IsLoaded() const { return( doubleValues || floatValues ); };
+
+		G4bool Is3D() const { return is3D; };
+		G4bool IsSinglePrecision() const { return( floatValues != 0 ); };
+
+		//	The interpolation kernel. The cell depends only on the grid, so
+		//	maps with the same grid can share it.
+		void FindCell( const G4ThreeVector &position,
+				fieldMapCell &cell ) const {
+			G4double x = ( is3D ? position.x() :
+					sqrt( position.x()*position.x() +
+					position.y()*position.y() ) );
+			G4int iX = FindIndex( x, 0, cell.xFraction );
+			G4int iY = 0;
+			cell.yFraction = 0;
+			if( is3D )
+				iY = FindIndex( position.y(), 1, cell.yFraction );
+			G4int iZ = FindIndex( position.z(), 2, cell.zFraction );
+			cell.index = ( iZ*numPoints[1] + iY )*numPoints[0] + iX;
+		};
+		G4double Interpolate( const fieldMapCell &cell ) const {
+			if( floatValues )
+				return InterpolateValues( floatValues, cell );
+			return InterpolateValues( doubleValues, cell );
+		};
+		//	Only the corners that contribute to the interpolation are looked
+		//	at, so a point on a grid line doesn't see across it
+		G4bool HasNegativeCorner( const fieldMapCell &cell ) const {
+			if( floatValues )
+				return NegativeCorner( floatValues, cell );
+			return NegativeCorner( doubleValues, cell );
+		};
+		G4bool HasSameGrid( const LUXSimFieldMap &map ) const;
+
+	private:
+		struct cacheHeader {
+			char magic[8];
+			long long mapSize;
+			long long mapTime;
+			G4int numPoints[3];
+			G4int flags;
+			G4double origin[3];
+			G4double spacing[3];
+		};
+
+		G4int FindIndex( G4double coordinate, G4int axis,
+				G4double &fraction ) const {
+			G4double index = ( coordinate - origin[axis] ) / spacing[axis];
+			if( index < 0 ) index = 0;
+			else if( index > numPoints[axis] - 1 ) index = numPoints[axis] - 1;
+			G4int i = (G4int)index;
+			if( i == numPoints[axis] - 1 ) i--;
+			fraction = index - i;
+			return i;
+		};
+
+		template <class valueType>
+		G4double InterpolateValues( const valueType *values,
+				const fieldMapCell &cell ) const {
+			const valueType *corner = values + cell.index;
+			G4double low = corner[0] +
+					cell.xFraction*( corner[1] - corner[0] );
+			G4double high = corner[zStride] +
+					cell.xFraction*( corner[zStride+1] - corner[zStride] );
+			if( is3D ) {
+				const valueType *cornerY = corner + yStride;
+				G4double lowY = cornerY[0] +
+						cell.xFraction*( cornerY[1] - cornerY[0] );
+				G4double highY = cornerY[zStride] +
+						cell.xFraction*( cornerY[zStride+1] - cornerY[zStride] );
+				low += cell.yFraction*( lowY - low );
+				high += cell.yFraction*( highY - high );
+			}
+			return( low + cell.zFraction*( high - low ) );
+		};
+
+		template <class valueType>
+		G4bool NegativeCorner( const valueType *values,
+				const fieldMapCell &cell ) const {
+			const valueType *corner = values + cell.index;
+			G4bool useX[2] = { cell.xFraction < 1, cell.xFraction > 0 };
+			G4bool useY[2] = { cell.yFraction < 1, cell.yFraction > 0 };
+			G4bool useZ[2] = { cell.zFraction < 1, cell.zFraction > 0 };
+			for( G4int k=0; k<2; k++ ) {
+				if( !useZ[k] ) continue;
+				for( G4int j=0; j<( is3D ? 2 : 1 ); j++ ) {
+					if( !useY[j] ) continue;
+					for( G4int i=0; i<2; i++ )
+						if( useX[i] && corner[k*zStride + j*yStride + i] < 0 )
+							return true;
+				}
+			}
+			return false;
+		};
+
+		void Unload();
+		void ReadText( G4String fileName );
+		G4bool MapCache( G4String fileName );
+		void WriteCache( G4String fileName );
+
+	private:
+		G4String description;
+		G4String loadedFileName;
+
+		//	Indexed by axis, x (or r), y and z. 2D maps have one point in y.
+		G4bool is3D;
+		G4int numPoints[3];
+		G4double origin[3];
+		G4double spacing[3];
+		G4int yStride;
+		G4int zStride;
+
+		//	One of these points either into the parsed values or into the
+		//	mapped cache, with x varying fastest and z slowest
+		const G4double *doubleValues;
+		const float *floatValues;
+		std::vector<G4double> parsedDoubleValues;
+		std::vector<float> parsedFloatValues;
+		void *mappedCache;
+		size_t mappedCacheSize;
+};
+
+#endif
@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////////////
+/*	LUXSimFunctionTable.hh
+*
+* This is the header file for a table of a smooth function of one variable,
+* used in place of fits that are too expensive to evaluate for every step or
+* every quantum (the NEST drift speed and recombination fits, in G4S1Light).
+*
+* The function is sampled on a grid that is uniform in the square root of the
+* argument, and interpolated linearly, so a lookup is a square root, an index
+* calculation and two loads. The square root puts the points closer together
+* at low arguments, which is where the fits bend the most, and keeps the
+* tables to a few thousand points. The argument can't be negative.
+*
+* When the table is built, the interpolation is checked against the function
+* at the middle of every bin, which is where the error of linear interpolation
+* peaks, and the spacing is halved until the worst relative error is within
+* the requested tolerance.
+* The worst error found is kept, so it can be reported.
+*
+* Arguments outside the table are passed straight to the function, so the
+* table only changes the speed, not the range, of the function.
+*
+********************************************************************************
+* Change log
+*	19-Oct-26 - Initial submission
+*
+*/
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LUXSimFunctionTable_HH
+#define LUXSimFunctionTable_HH 1
+
+//
+//	C/C++ includes
+//
+#include <vector>
+#include <cmath>
+
+//
+//	GEANT4 includes
+//
+#include "globals.hh"
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+class LUXSimFunctionTable
+{
+	public:
+		LUXSimFunctionTable();
+		~LUXSimFunctionTable();
+
+	public:
+		void Build( G4double (*func)( G4double ), G4double min, G4double max,
+				G4double tolerance, G4int maxPoints=1048577 );
+		G4bool IsBuilt() const { return !values.empty(); };
+
+		G4double Value( G4double x ) const {
+			if( x < xMin || x > xMax )
+				return function( x );
+			G4double index = ( sqrt( x ) - uMin ) * inverseSpacing;
+			G4int i = (G4int)index;
+			if( i >= (G4int)values.size() - 1 ) i = values.size() - 2;
+			return( values[i] + ( index - i )*( values[i+1] - values[i] ) );
+		};
+
+		G4int GetNumPoints() const { return values.size(); };
+		G4double GetMaxRelativeError() const { return maxRelativeError; };
+
+	private:
+		G4double (*function)( G4double );
+		G4double xMin;
+		G4double xMax;
+		G4double uMin;				//	sqrt( xMin )
+		G4double inverseSpacing;	//	in sqrt( x )
+		std::vector<G4double> values;
+		G4double maxRelativeError;
+};
+
+#endif
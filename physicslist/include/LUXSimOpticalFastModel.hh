@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////////////
+/*	LUXSimOpticalFastModel.hh
+*
+* This is the header file for the optical photon fast path, a fast simulation
+* model for the optically homogeneous volumes of the TPC (the liquid xenon
+* target and the gas gap). The volumes are named with
+* /LUXSim/physicsList/opticalFastPath, and become the envelopes of the model.
+*
+* Inside an envelope, the normal tracking takes one step per Rayleigh scatter,
+* each with the full set of processes and the stepping action. The model
+* instead samples the distance to the next absorption or Rayleigh scatter
+* analytically from the mean free paths of G4OpAbsorption and G4OpRayleigh,
+* and scatters the photon the way G4OpRayleigh does. The distance to the
+* boundary is worked out directly from the solid of the envelope (the cylinder
+* walls and the liquid surface) and of any placed daughter volumes.
+*
+* Once a sampled distance reaches the boundary, the photon is moved along its
+* direction, without interacting, to a micron short of the boundary, and handed
+* back to the normal tracking there. That means every reflection and refraction
+* at the PTFE walls, the liquid surface, the grids and the PMT windows is still
+* done by G4OpBoundaryProcess, with the surface models in LUXSimMaterials. The
+* photon isn't put on the boundary itself, because it would then be located in
+* the volume on the other side, and the boundary process would never see it
+* cross. The normal tracking draws a new free path for the last micron, which
+* is fine because the photon has moved on from where the last one was drawn.
+*
+* Whether the model takes a step depends only on where the photon is and where
+* it's going, never on a sampled distance. Drawing a free path, throwing it
+* away because it reaches the boundary and letting the normal tracking draw
+* another from the same point would favour interactions, and a photon would
+* get to the boundary unscattered with probability exp(-2 mu d) rather than
+* exp(-mu d).
+*
+* The model stands aside, and the normal tracking takes over, for photons in a
+* daughter volume, in an envelope with replicated or parameterised daughters,
+* and in an envelope where wavelength shifting or phe conversion can happen.
+*
+********************************************************************************
+* Change log
+*	19-Oct-26 - Initial submission
+*	19-Oct-26 - The model is triggered from the geometry alone, and takes the
+*				photon to just short of the boundary instead of leaving it at
+*				its last scatter. Transport() is public, for the
+*				microbenchmarks.
+*
+*/
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LUXSimOpticalFastModel_HH
+#define LUXSimOpticalFastModel_HH 1
+
+//
+//	C/C++ includes
+//
+#include <map>
+#include <vector>
+
+//
+//	GEANT4 includes
+//
+#include "G4VFastSimulationModel.hh"
+#include "G4AffineTransform.hh"
+#include "globals.hh"
+
+//
+//	Class forwarding
+//
+class G4LogicalVolume;
+class G4VSolid;
+class G4OpAbsorption;
+class G4OpRayleigh;
+class G4OpWLS;
+class LUXSimQuantumEfficiency;
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+class LUXSimOpticalFastModel : public G4VFastSimulationModel
+{
+	public:
+		LUXSimOpticalFastModel( G4String, G4Envelope* );
+		~LUXSimOpticalFastModel();
+
+	public:
+		G4bool IsApplicable( const G4ParticleDefinition& );
+		G4bool ModelTrigger( const G4FastTrack& );
+		void DoIt( const G4FastTrack&, G4FastStep& );
+
+		//	The envelopes are looked at again after a geometry update
+		void ClearEnvelopes() { envelopes.clear(); };
+
+		//	The fast path on its own, for DoIt and the microbenchmarks. A photon
+		//	is only taken if it's more than two gaps from a boundary. It's then
+		//	moved until it's absorbed, in which case Transport() returns true,
+		//	or until it's a gap short of a boundary. The rates are in 1/mm.
+		G4bool IsClearOfBoundary( const G4LogicalVolume*, const G4ThreeVector&,
+				const G4ThreeVector& );
+		G4bool Transport( const G4LogicalVolume*, G4double absorption,
+				G4double rayleigh, G4ThreeVector &position,
+				G4ThreeVector &direction, G4ThreeVector &polarization,
+				G4double &pathLength );
+
+		//	The number of Rayleigh scatters in the last fast step, for the
+		//	optical path record. The tracks are stepped one at a time, so this
+		//	belongs to the photon being stepped.
+		static G4int GetNumRayleigh() { return numRayleigh; };
+
+	private:
+		struct envelope {
+			G4bool usable;
+			G4VSolid *solid;
+			std::vector<G4VSolid*> daughterSolids;
+			std::vector<G4AffineTransform> daughterTransforms;
+		};
+		const envelope &GetEnvelope( const G4LogicalVolume* );
+		G4bool FindProcesses();
+		G4bool IsBeforeBoundary( const G4ThreeVector&, const G4ThreeVector&,
+				G4double );
+		G4double GetDistanceToBoundary( const G4ThreeVector&,
+				const G4ThreeVector& );
+		void RayleighScatter( G4ThreeVector&, G4ThreeVector& );
+
+	private:
+		std::map<const G4LogicalVolume*, envelope> envelopes;
+		const envelope *currentEnvelope;
+
+		G4bool processesFound;
+		G4OpAbsorption *absorptionProcess;
+		G4OpRayleigh *rayleighProcess;
+		G4OpWLS *wlsProcess;
+		LUXSimQuantumEfficiency *pheProcess;
+
+		//	Set by ModelTrigger for DoIt
+		G4double absorptionRate;
+		G4double rayleighRate;
+
+		static G4int numRayleigh;
+};
+
+#endif
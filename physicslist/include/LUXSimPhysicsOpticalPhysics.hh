@@ -12,6 +12,7 @@
 *				theScintProcess and theCerenovProcess private variables,
 *				added Get methods for scintillation and Cerenkov (Kareem)
 *       13-Sep-11 - Changed G4Scintillation calls to G4S1Light (Matthew)
+*	19-Oct-26 - Added a Get method for the QE process
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -26,6 +27,7 @@
 #include "G4VPhysicsConstructor.hh"
 #include "G4S1Light.hh"
 #include "G4Cerenkov.hh"
+#include "LUXSimQuantumEfficiency.hh"
 
 //
 //  LUXSim includes
@@ -40,6 +42,7 @@ class LUXSimPhysicsOpticalPhysics : public G4VPhysicsConstructor
 
 		G4S1Light *theScintProcess;
 		G4Cerenkov *theCerenkovProcess;
+		LUXSimQuantumEfficiency *thePheProcess;
 
 	public:
 
@@ -51,5 +54,7 @@ class LUXSimPhysicsOpticalPhysics : public G4VPhysicsConstructor
 		
 		G4S1Light *GetScintillation() { return theScintProcess; };
 		G4Cerenkov *GetCerenkov() { return theCerenkovProcess; };
+		LUXSimQuantumEfficiency *GetQuantumEfficiency()
+				{ return thePheProcess; };
 };
 #endif
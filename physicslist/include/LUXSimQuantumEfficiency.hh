@@ -6,6 +6,11 @@
  ******************************************************************************
  * Change log           
  *       20 Feb   2012 - Initial submission (Matthew)    
+ *       19 Oct   2026 - Added the per-volume photocathode lookup
+ *       19 Oct   2026 - Flag for the one-time uncalibrated photocathode warning
+ *       19 Oct   2026 - Flag for the one-time roulette weight warning
+ *       19 Oct   2026 - ClearPhotoCathodes, so the lookup is by volume address
+ *                       alone
  *                                 
  */
 ///////////////////////////////////////////////////////////////////////////////
@@ -13,12 +18,15 @@
 #ifndef LUXSimQuantumEfficiency_h
 #define LUXSimQuantumEfficiency_h 1
 
+#include <map>
+
 #include "globals.hh"
 #include "G4VRestDiscreteProcess.hh"
 class G4Track;
 class G4Step;
 class G4ParticleDefinition;
 class G4VParticleChange;
+class G4VPhysicalVolume;
 
 class LUXSimQuantumEfficiency : public G4VRestDiscreteProcess //class def'n
 {
@@ -37,6 +45,10 @@ public: // methods, with descriptions
   G4VParticleChange* PostStepDoIt(const G4Track& aTrack, const G4Step& aStep );
   G4double GetMeanFreePath(const G4Track& aTrack,G4double,G4ForceCondition*);
   G4double GetMeanLifeTime ( const G4Track& aTrack, G4ForceCondition*);
+
+  // Forgets what was worked out about each volume. The manager calls this
+  // when the geometry is rebuilt or the PMT numbering scheme changes.
+  void ClearPhotoCathodes();
   
 protected:
   
@@ -46,6 +58,25 @@ private:
   void LoadQEValuesFromFile(G4String fileName);
   G4double doublePheProb[122];
   G4double QEvals[122];
+
+  // What the name of a volume says about it, worked out the first time a
+  // photon reaches the volume rather than for every photon. The volumes are
+  // known by address only, so the lookup has to be cleared (with
+  // ClearPhotoCathodes) whenever the addresses or the numbering scheme could
+  // change.
+  struct photoCathode {
+    G4bool isPhotoCathode;
+    G4bool isWaterPMT;
+    G4int pmtIndex;        // the PMT number - 1, or -1 if uncalibrated
+    G4double qeScale;      // QEvals / (doublePheProb + 1)
+  };
+  const photoCathode &GetPhotoCathode(const G4VPhysicalVolume *volume);
+  photoCathode MakePhotoCathode(const G4VPhysicalVolume *volume);
+  std::map<const G4VPhysicalVolume*, photoCathode> photoCathodes;
+  const G4VPhysicalVolume *lastVolume;
+  const photoCathode *lastPhotoCathode;
+  G4bool warnedUncalibrated;
+  G4bool warnedWeight;
   
 };
 
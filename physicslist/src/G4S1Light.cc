@@ -55,6 +55,7 @@
 
 #include "LUXSimDetectorComponent.hh"
 #include "LUXSimFastSim.hh"
+#include "LUXSimFunctionTable.hh"
 
 #define MIN_ENE -1*eV //lets you turn NEST off BELOW a certain energy
 #define MAX_ENE 1.*TeV //lets you turn NEST off ABOVE a certain energy
@@ -75,9 +76,25 @@ G4double biExc = 0.77; //for alpha particles (bi-excitonic collisions)
 G4double UnivScreenFunc ( G4double E, G4double Z, G4double A );
 
 G4int BinomFluct(G4int N0, G4double prob); //function for doing fluctuations
+G4int PoisFluct(G4double mean); //and the Poisson equivalent
 int modPoisRnd ( double poisMean, double preFactor );
 void InitMatPropValues ( G4MaterialPropertiesTable* nobleElementMat );
 
+//the field-dependent fits, and tables of them that are built when the first
+//S1 process is. Temperature enters the drift speed linearly, so the tables are
+//in field alone, and stay valid whatever the temperature of the liquid.
+G4double MillerDriftSpeedFit ( G4double efield );
+G4double LiquidDriftSpeedFit165K ( G4double efield );
+G4double LiquidDriftSpeedFit200K ( G4double efield );
+G4double LiquidDriftSpeedFit230K ( G4double efield );
+G4double RecombinationLengthFit ( G4double efield );
+G4double DokeBirksFit ( G4double efield );
+void BuildFieldTables ();
+LUXSimFunctionTable millerDriftSpeedTable, liquidDriftSpeedTables[3];
+LUXSimFunctionTable recombinationLengthTable, dokeBirksTable;
+#define TABLE_TOLERANCE 1e-5 //relative, far below the accuracy of the fits
+#define TABLE_MAX_FIELD 1e5 //V/cm
+
 #define Density_LXe 2.888 //reference density for density-dep. effects
 #define Density_LAr 1.393
 #define Density_LNe 1.207
@@ -102,6 +119,8 @@ G4S1Light::G4S1Light(const G4String& processName,
         }
     
     SetLUXGeoValues();
+
+    if ( !millerDriftSpeedTable.IsBuilt() ) BuildFieldTables();
 }
 
 G4S1Light::~G4S1Light(){} //destructor needed to avoid linker error
@@ -237,6 +256,17 @@ G4S1Light::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
           G4String radialDriftFile  = luxManager->GetRadialDriftFile();
           luxManager->LoadXYZDependentRadialDrift(radialDriftFile);
         }
+        // the map quantities at the end of the step are found once here, in
+        // one pass, instead of once for each electron
+        G4int mapQuantities = 0;
+        if (EFieldFromFile)
+          mapQuantities |= LUXSimManager::electricFieldQuantity;
+        if (DriftTimeFromFile)
+          mapQuantities |= LUXSimManager::driftTimeQuantity;
+        if (RadialDriftFromFile)
+          mapQuantities |= LUXSimManager::radialDriftQuantity;
+        LUXSimManager::fieldMapValues mapValues;
+        luxManager->GetXYZDependentValues(x1, mapQuantities, mapValues);
 	if ( WIN>0 && TOP>0 && ANE>0 && SRF>0 && GAT>0 && CTH>0 && BOT>0 && PMT>0 ) {
           ElectricField = aMaterialPropertiesTable->GetConstProperty("ELECTRICFIELD");
         }
@@ -253,7 +283,7 @@ G4S1Light::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
 	  else if ( Phase == kStateLiquid ) {
             if (EFieldFromFile) {
   	      if ( x1[2] < TOP && x1[2] > PMT ) {
-                ElectricField = luxManager->GetXYZDependentElectricField (x1);
+                ElectricField = mapValues.electricField;
               }
               else {
                 ElectricField = 0;
@@ -290,7 +320,7 @@ G4S1Light::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
 	}
         if ( ElectricField >= 0 ) FieldSign = 1; else FieldSign = -1;
         if (luxManager->GetDriftTimeFromFile() &&
-            luxManager->GetXYZDependentDriftTime(x1) < 0) { // if drifttime is negative, produce no S2
+            mapValues.driftTime < 0) { // if drifttime is negative, produce no S2
             FieldSign = 1;
         }
 	ElectricField = fabs((1e3*ElectricField)/(kilovolt/cm));
@@ -361,9 +391,9 @@ G4S1Light::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
 	    R0 = 16.6*um; //for zero electric field
 	    //length scale above which Doke model used instead of Thomas-Imel
 	    if(ElectricField) //change it with field (see NEST paper)
-	      R0 = 69.492*pow(ElectricField,-0.50422)*um;
+	      R0 = recombinationLengthTable.Value(ElectricField)*um;
 	    if(ElectricField) { //formulae & values all from NEST paper
-	      DokeBirks[0]= 19.171*pow(ElectricField+25.552,-0.83057)+0.026772;
+	      DokeBirks[0]= dokeBirksTable.Value(ElectricField);
 	      DokeBirks[2] = 0.00; //only volume recombination (above)
 	    }
 	    else { //zero electric field magnitude
@@ -527,6 +557,7 @@ G4S1Light::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
 	  if ( aParticle->GetPDGcode() == 11 && !OutElectrons )
 	    fMultipleScattering = true;
 	  x1 = x0; //prevents generation of quanta outside active volume
+	  luxManager->GetXYZDependentValues(x1, mapQuantities, mapValues);
 	} //no scint. for e-'s that leave
 	
 	char xCoord[80]; char yCoord[80]; char zCoord[80];
@@ -569,14 +600,15 @@ G4S1Light::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
 	if ( fAlpha || abs(aParticle->GetPDGcode()) == 2112 )
           a2 = a1; //get average A for element at hand
 	G4double epsilon = 11.5*(TotalEnergyDeposit/keV)*pow(z1,(-7./3.));
-	G4double gamma = 3.*pow(epsilon,0.15)+0.7*pow(epsilon,0.6)+epsilon;
-	G4double kappa = 0.1394*sqrt(a2/131.293);//0.133*pow(z1,(2./3.))*pow(a2,(-1./2.))*(2./3.);
-        if ( (z1 == z2 && z1 == 54) )
-            kappa = 0.1735; // 2015-11-27 - Brian L.
 	//check if we are dealing with nuclear recoil (Z same as material)
 	if ( (z1 == z2 && pDef->GetParticleType() == "nucleus" &&
 	      !fExcitedNucleus) ||
 	     particleName == "neutron" || particleName == "antineutron" ) {
+	  //the Lindhard terms are only needed for nuclear recoils
+	  G4double gamma = 3.*pow(epsilon,0.15)+0.7*pow(epsilon,0.6)+epsilon;
+	  G4double kappa = 0.1394*sqrt(a2/131.293);//0.133*pow(z1,(2./3.))*pow(a2,(-1./2.))*(2./3.);
+          if ( (z1 == z2 && z1 == 54) )
+            kappa = 0.1735; // 2015-11-27 - Brian L.
           //YieldFactor=UnivScreenFunc(TotalEnergyDeposit/keV, z1, a1);
           YieldFactor=( kappa * gamma ) / ( 1 + kappa * gamma ); // 2015-11-23 - Brian L.
 	  if ( z1 == 18 && Phase == kStateLiquid )
@@ -945,6 +977,23 @@ G4S1Light::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
 	      NumQuanta = NumPhotons + NumElectrons;
 	    else NumQuanta = 0;
 	    
+	    //every electron from this site drifts at the same speed, so it is
+	    //only worked out once
+	    G4double electronDriftEnergy = 0.;
+	    if ( ElectricField && NumQuanta > NumPhotons ) {
+	      if ( Phase == kStateGas )
+		electronDriftEnergy =
+		  GetGasElectronDriftSpeed(ElectricField,nDensity);
+	      else if (luxManager->GetDriftTimeFromFile())
+		electronDriftEnergy = GetLiquidElectronDriftSpeed(
+		  Temperature, ElectricField, MillerDriftSpeed, z1, true, x1[2],
+		  mapValues.driftTime);
+	      else
+		electronDriftEnergy = GetLiquidElectronDriftSpeed(
+		  Temperature, ElectricField, MillerDriftSpeed, z1, false, x1[0],
+		  0.);
+	    }
+	    
 	    for(k = 0; k < NumQuanta; k++) {
 	      G4double sampledEnergy;
 	      G4DynamicParticle* aQuantum;
@@ -992,21 +1041,7 @@ G4S1Light::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
 		  aQuantum = 
 		    new G4DynamicParticle(G4ThermalElectron::ThermalElectron(),
 					  electronMomentum);
-		  if ( Phase == kStateGas ) {
-		    sampledEnergy =
-		      GetGasElectronDriftSpeed(ElectricField,nDensity);
-		  }
-		  else {
-                    if (luxManager->GetDriftTimeFromFile()) {
-                      G4double calculatedDriftTime = luxManager->GetXYZDependentDriftTime(x1);
-		      sampledEnergy = GetLiquidElectronDriftSpeed(
-		      Temperature, ElectricField, MillerDriftSpeed, z1, luxManager->GetDriftTimeFromFile(), x1[2], calculatedDriftTime);
-                    }
-                    else {
-		      sampledEnergy = GetLiquidElectronDriftSpeed(
-		      Temperature, ElectricField, MillerDriftSpeed, z1, luxManager->GetDriftTimeFromFile(), x1[0], 0.);
-                    }
-                  }
+		  sampledEnergy = electronDriftEnergy;
 		}
 		else {
 		  // use "photonMomentum" for the electrons in the case of zero
@@ -1144,7 +1179,7 @@ G4S1Light::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
                 G4double sigmaDT;
                 G4double sigmaDL;
                 if (luxManager->GetDriftTimeFromFile()) { // determine whether to use drift velocity of COMSOL sim
-                  driftTime = luxManager->GetXYZDependentDriftTime(x1);
+                  driftTime = mapValues.driftTime;
  		  sigmaDT = sqrt(2*D_T*driftTime);
 		  sigmaDL = sqrt(2*D_L*driftTime);
                 }
@@ -1157,7 +1192,7 @@ G4S1Light::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
 		G4double dr = fabs(G4RandGauss::shoot(0.,sigmaDT));
 		phi = twopi * G4UniformRand();
                 if (luxManager->GetRadialDriftFromFile()) { // determine whether to use final radius from COMSOL sim
-                  G4double driftedR = luxManager->GetXYZDependentRadialDrift(x1);
+                  G4double driftedR = mapValues.radialDrift;
                   G4double theta;
                   if (x1[0] != 0) {
                     theta = atan(x1[1]/x1[0]); // get current theta position, if will stay the same
@@ -1335,8 +1370,7 @@ G4S1Light::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
 	  fAlpha = false;
 	  
 	  G4double MeanNumberOfLiquidElectrons=DAQWIN_MS*E_RATE_HZ;
-	  G4int NumLiqElec = G4int(G4Poisson(
-		MeanNumberOfLiquidElectrons));
+	  G4int NumLiqElec = PoisFluct(MeanNumberOfLiquidElectrons);
 	  G4ThreeVector RandomPos; G4double RandomTim;
 	  if(NumQuanta == 0 || fVeryHighEnergy || FastSimBool || E_RATE_HZ == 0) NumLiqElec=0;
 	  for ( G4int aa = 0; aa < NumLiqElec; aa++ ) {
@@ -1429,90 +1463,13 @@ G4double G4S1Light::GetLiquidElectronDriftSpeed(G4double tempinput,
   }
   else {
     if(efieldinput<0) efieldinput *= (-1);
-    //Liquid equation one (165K) coefficients
-    G4double onea=144623.235704015,
-      oneb=850.812714257629,
-      onec=1192.87056676815,
-      oned=-395969.575204061,
-      onef=-355.484170008875,
-      oneg=-227.266219627672,
-      oneh=223831.601257495,
-      onei=6.1778950907965,
-      onej=18.7831533426398,
-      onek=-76132.6018884368;
-    //Liquid equation two (200K) coefficients
-    G4double twoa=17486639.7118995,
-      twob=-113.174284723134,
-      twoc=28.005913193763,
-      twod=167994210.094027,
-      twof=-6766.42962575088,
-      twog=901.474643115395,
-      twoh=-185240292.471665,
-      twoi=-633.297790813084,
-      twoj=87.1756135457949;
-    //Liquid equation three (230K) coefficients
-    G4double thra=10626463726.9833,
-      thrb=224025158.134792,
-      thrc=123254826.300172,
-      thrd=-4563.5678061122,
-      thrf=-1715.269592063,
-      thrg=-694181.921834368,
-      thrh=-50.9753281079838,
-      thri=58.3785811395493,
-      thrj=201512.080026704;
-    G4double y1=0,y2=0,f1=0,f2=0,f3=0,
-      t1=0,t2=0,frac=0,slope=0,intercept=0;
-
-    //Equations defined
-    f1=onea/(1+exp(-(efieldinput-oneb)/onec))+oned/
-      (1+exp(-(efieldinput-onef)/oneg))+
-      oneh/(1+exp(-(efieldinput-onei)/onej))+onek;
-    f2=twoa/(1+exp(-(efieldinput-twob)/twoc))+twod/
-      (1+exp(-(efieldinput-twof)/twog))+
-      twoh/(1+exp(-(efieldinput-twoi)/twoj));
-    f3=thra*exp(-thrb*efieldinput)+thrc*exp(-(pow(efieldinput-thrd,2))/
-                                            (thrf*thrf))+
-      thrg*exp(-(pow(efieldinput-thrh,2)/(thri*thri)))+thrj;
-
-    if(efieldinput<20 && efieldinput>=0) {
-      f1=2951*efieldinput;
-      f2=5312*efieldinput;
-      f3=7101*efieldinput;
-    }
-    //Cases for tempinput decides which 2 equations to use lin. interpolation
-    if(tempinput<200.0 && tempinput>165.0) {
-      y1=f1;
-      y2=f2;
-      t1=165.0;
-      t2=200.0;
-    }
-    if(tempinput<230.0 && tempinput>200.0) {
-      y1=f2;
-      y2=f3;
-      t1=200.0;
-      t2=230.0;
-    }
-    if((tempinput>230.0 || tempinput<165.0) && !Miller) {
-      G4cout << "\nWARNING: TEMPERATURE OUT OF RANGE (165-230 K)\n";
-      return 0;
-    }
-    if (tempinput == 165.0) edrift = f1;
-    else if (tempinput == 200.0) edrift = f2;
-    else if (tempinput == 230.0) edrift = f3;
-    else { //Linear interpolation
-      frac=(tempinput-t1)/(t2-t1);
-      slope = (y1-y2)/(t1-t2);
-      intercept=y1-slope*t1;
-      edrift=slope*tempinput+intercept;
-    }
-  
     if ( Miller ) {
       if ( efieldinput <= 40. )
-        edrift = -0.13274+0.041082*efieldinput-0.0006886*pow(efieldinput,2.)+
-        5.5503e-6*pow(efieldinput,3.);
-      else
-        edrift = 0.060774*efieldinput/pow(1+0.11336*pow(efieldinput,0.5218),2.);
-      if ( efieldinput >= 1e5 ) edrift = 2.7;
+        edrift = -0.13274+efieldinput*(0.041082+efieldinput*(-0.0006886+
+        5.5503e-6*efieldinput));
+      else if ( efieldinput < 1e5 )
+        edrift = millerDriftSpeedTable.Value(efieldinput);
+      else edrift = 2.7;
       if ( efieldinput >= 500 )
         edrift -= 0.017 * ( tempinput - 163 );
       else if ( efieldinput < 100 )
@@ -1520,34 +1477,150 @@ G4double G4S1Light::GetLiquidElectronDriftSpeed(G4double tempinput,
       else { ;}
       edrift *= 1e5; //put into units of cm/sec. from mm/usec.
     }
+    else {
+      if(tempinput>230.0 || tempinput<165.0) {
+        G4cout << "\nWARNING: TEMPERATURE OUT OF RANGE (165-230 K)\n";
+        return 0;
+      }
+      //the fits at 165, 200 and 230 K, from the tables
+      G4double f[3];
+      if(efieldinput<20) {
+        f[0]=2951*efieldinput;
+        f[1]=5312*efieldinput;
+        f[2]=7101*efieldinput;
+      }
+      else
+        for ( G4int i=0; i<3; i++ )
+          f[i] = liquidDriftSpeedTables[i].Value(efieldinput);
+      //Cases for tempinput decides which 2 equations to use lin. interpolation
+      G4double y1=0,y2=0,t1=0,t2=0,slope=0,intercept=0;
+      if(tempinput<200.0 && tempinput>165.0) {
+        y1=f[0];
+        y2=f[1];
+        t1=165.0;
+        t2=200.0;
+      }
+      if(tempinput<230.0 && tempinput>200.0) {
+        y1=f[1];
+        y2=f[2];
+        t1=200.0;
+        t2=230.0;
+      }
+      if (tempinput == 165.0) edrift = f[0];
+      else if (tempinput == 200.0) edrift = f[1];
+      else if (tempinput == 230.0) edrift = f[2];
+      else { //Linear interpolation
+        slope = (y1-y2)/(t1-t2);
+        intercept=y1-slope*t1;
+        edrift=slope*tempinput+intercept;
+      }
+    }
   }
   if ( Z == 18 ) edrift = 1e5 * (
     .097384*pow(log10(efieldinput),3.0622)-.018614*sqrt(efieldinput) );
   if ( edrift < 0 ) edrift = 0.;
-  edrift = 0.5*EMASS*pow(edrift*cm/s,2.);
+  edrift *= cm/s;
+  edrift = 0.5*EMASS*edrift*edrift;
   return edrift;
 }
 
+G4double MillerDriftSpeedFit ( G4double efield ) { //mm/us, above 40 V/cm
+  return 0.060774*efield/pow(1+0.11336*pow(efield,0.5218),2.);
+}
+
+G4double LiquidDriftSpeedFit165K ( G4double efield ) { //cm/s, above 20 V/cm
+  //Liquid equation one (165K) coefficients
+  G4double onea=144623.235704015,
+    oneb=850.812714257629,
+    onec=1192.87056676815,
+    oned=-395969.575204061,
+    onef=-355.484170008875,
+    oneg=-227.266219627672,
+    oneh=223831.601257495,
+    onei=6.1778950907965,
+    onej=18.7831533426398,
+    onek=-76132.6018884368;
+  return onea/(1+exp(-(efield-oneb)/onec))+oned/
+    (1+exp(-(efield-onef)/oneg))+
+    oneh/(1+exp(-(efield-onei)/onej))+onek;
+}
+
+G4double LiquidDriftSpeedFit200K ( G4double efield ) {
+  //Liquid equation two (200K) coefficients
+  G4double twoa=17486639.7118995,
+    twob=-113.174284723134,
+    twoc=28.005913193763,
+    twod=167994210.094027,
+    twof=-6766.42962575088,
+    twog=901.474643115395,
+    twoh=-185240292.471665,
+    twoi=-633.297790813084,
+    twoj=87.1756135457949;
+  return twoa/(1+exp(-(efield-twob)/twoc))+twod/
+    (1+exp(-(efield-twof)/twog))+
+    twoh/(1+exp(-(efield-twoi)/twoj));
+}
+
+G4double LiquidDriftSpeedFit230K ( G4double efield ) {
+  //Liquid equation three (230K) coefficients
+  G4double thra=10626463726.9833,
+    thrb=224025158.134792,
+    thrc=123254826.300172,
+    thrd=-4563.5678061122,
+    thrf=-1715.269592063,
+    thrg=-694181.921834368,
+    thrh=-50.9753281079838,
+    thri=58.3785811395493,
+    thrj=201512.080026704;
+  return thra*exp(-thrb*efield)+thrc*exp(-(pow(efield-thrd,2))/
+                                         (thrf*thrf))+
+    thrg*exp(-(pow(efield-thrh,2)/(thri*thri)))+thrj;
+}
+
+G4double RecombinationLengthFit ( G4double efield ) { //um
+  return 69.492*pow(efield,-0.50422);
+}
+
+G4double DokeBirksFit ( G4double efield ) {
+  return 19.171*pow(efield+25.552,-0.83057)+0.026772;
+}
+
+void BuildFieldTables () {
+  millerDriftSpeedTable.Build( MillerDriftSpeedFit, 40., TABLE_MAX_FIELD,
+                               TABLE_TOLERANCE );
+  liquidDriftSpeedTables[0].Build( LiquidDriftSpeedFit165K, 20.,
+                                   TABLE_MAX_FIELD, TABLE_TOLERANCE );
+  liquidDriftSpeedTables[1].Build( LiquidDriftSpeedFit200K, 20.,
+                                   TABLE_MAX_FIELD, TABLE_TOLERANCE );
+  liquidDriftSpeedTables[2].Build( LiquidDriftSpeedFit230K, 20.,
+                                   TABLE_MAX_FIELD, TABLE_TOLERANCE );
+  //below 10 V/cm the recombination length rises too steeply to tabulate
+  recombinationLengthTable.Build( RecombinationLengthFit, 10.,
+                                  TABLE_MAX_FIELD, TABLE_TOLERANCE );
+  dokeBirksTable.Build( DokeBirksFit, 0., TABLE_MAX_FIELD, TABLE_TOLERANCE );
+}
+
 G4double CalculateElectronLET ( G4double E, G4int Z ) {
   G4double LET;
   switch ( Z ) {
   case 54:
   //use a spline fit to online ESTAR data
-  if ( E >= 1 ) LET = 58.482-61.183*log10(E)+19.749*pow(log10(E),2)+
-    2.3101*pow(log10(E),3)-3.3469*pow(log10(E),4)+
-    0.96788*pow(log10(E),5)-0.12619*pow(log10(E),6)+0.0065108*pow(log10(E),7);
+  //(the polynomials are written out in nested form, one log10 per call)
+  if ( E >= 1 ) { G4double L = log10(E);
+    LET = 58.482+L*(-61.183+L*(19.749+L*(2.3101+L*(-3.3469+L*(0.96788+
+      L*(-0.12619+L*0.0065108)))))); }
   //at energies <1 keV, use a different spline, determined manually by
   //generating sub-keV electrons in Geant4 and looking at their ranges, since
   //ESTAR does not go this low
-  else if ( E>0 && E<1 ) LET = 6.9463+815.98*E-4828*pow(E,2)+17079*pow(E,3)-
-    36394*pow(E,4)+44553*pow(E,5)-28659*pow(E,6)+7483.8*pow(E,7);
+  else if ( E>0 && E<1 ) LET = 6.9463+E*(815.98+E*(-4828+E*(17079+E*(-36394+
+    E*(44553+E*(-28659+E*7483.8))))));
   else
     LET = 0;
   break;
   case 18: default:
-  if ( E >= 1 ) LET = 116.70-162.97*log10(E)+99.361*pow(log10(E),2)-
-    33.405*pow(log10(E),3)+6.5069*pow(log10(E),4)-
-    0.69334*pow(log10(E),5)+.031563*pow(log10(E),6);
+  if ( E >= 1 ) { G4double L = log10(E);
+    LET = 116.70+L*(-162.97+L*(99.361+L*(-33.405+L*(6.5069+L*(-0.69334+
+      L*.031563))))); }
   else if ( E>0 && E<1 ) LET = 100;
   else
     LET = 0;
@@ -1555,24 +1628,101 @@ G4double CalculateElectronLET ( G4double E, G4int Z ) {
   return LET;
 }
 
+//log(k!), from a table for small k and Stirling's series above it, which is
+//good to double precision there and much quicker than lgamma
+G4double LogFactorial ( G4double k ) {
+  static G4double table[256]; static G4bool filled = false;
+  if ( k < 256 ) {
+    if ( !filled ) {
+      table[0] = 0.;
+      for ( G4int i=1; i<256; i++ ) table[i] = table[i-1] + log(G4double(i));
+      filled = true;
+    }
+    return table[G4int(k)];
+  }
+  G4double r = 1./k, r2 = r*r;
+  return (k+0.5)*log(k) - k + 0.91893853320467274 +
+    r*(1./12. - r2*(1./360. - r2/1260.));
+}
+
+//exact binomial fluctuations, at a cost that doesn't grow with N0: inversion
+//when the mean is small, otherwise the transformed rejection with squeeze
+//(BTRS) of W. Hormann, J. Comput. Appl. Math. 48 (1993) 235
 G4int BinomFluct ( G4int N0, G4double prob ) {
-  G4double mean = N0*prob;
-  G4double sigma = sqrt(N0*prob*(1-prob));
-  G4int N1 = 0;
-  if ( prob <= 0.00 ) return N1;
+  if ( prob <= 0.00 || N0 <= 0 ) return 0;
   if ( prob >= 1.00 ) return N0;
-  
+  G4int N1 = 0;
   if ( N0 < 10 ) {
     for(G4int i = 0; i < N0; i++) {
       if(G4UniformRand() < prob) N1++;
     }
+    return N1;
   }
-  else {
-    N1 = G4int(floor(G4RandGauss::shoot(mean,sigma)+0.5));
+  //sample the rarer of the two outcomes
+  if ( prob > 0.5 ) return N0 - BinomFluct(N0,1.-prob);
+  
+  G4double q = 1. - prob;
+  if ( N0*prob < 10. ) {
+    G4double s = prob/q, a = (N0+1)*s, r = pow(q,G4double(N0));
+    G4double u = G4UniformRand();
+    N1 = 0;
+    while ( u > r && N1 < N0 ) {
+      u -= r; N1++; r *= a/N1 - s;
+    }
+    return N1;
+  }
+  
+  G4double spq = sqrt(N0*prob*q);
+  G4double b = 1.15 + 2.53*spq;
+  G4double a = -0.0873 + 0.0248*b + 0.01*prob;
+  G4double c = N0*prob + 0.5;
+  G4double alpha = (2.83 + 5.1/b)*spq;
+  G4double vr = 0.92 - 4.2/b;
+  G4double lpq = log(prob/q);
+  G4int m = G4int(floor((N0+1)*prob));
+  G4double h = LogFactorial(m) + LogFactorial(N0-m);
+  while ( true ) {
+    G4double u = G4UniformRand() - 0.5, v = G4UniformRand();
+    G4double us = 0.5 - fabs(u);
+    G4double k = floor((2.*a/us + b)*u + c);
+    if ( k < 0 || k > N0 ) continue;
+    N1 = G4int(k);
+    if ( us >= 0.07 && v <= vr ) return N1;
+    v = log(v*alpha/(a/(us*us) + b));
+    if ( v <= h - LogFactorial(k) - LogFactorial(N0-k) + (k-m)*lpq )
+      return N1;
+  }
+}
+
+//exact Poisson fluctuations, likewise: inversion for small means, otherwise
+//the PTRS method from the same paper. G4Poisson switches to a Gaussian above
+//a mean of 16, which is too early for the number of quanta at WIMP energies.
+G4int PoisFluct ( G4double mean ) {
+  if ( mean <= 0. ) return 0;
+  
+  if ( mean < 10. ) {
+    G4double p = exp(-mean), F = p, u = G4UniformRand();
+    G4int N = 0;
+    while ( u > F && p > 0. ) {
+      N++; p *= mean/N; F += p;
+    }
+    return N;
+  }
+  
+  G4double slam = sqrt(mean), loglam = log(mean);
+  G4double b = 0.931 + 2.53*slam;
+  G4double a = -0.059 + 0.02483*b;
+  G4double invalpha = 1.1239 + 1.1328/(b-3.4);
+  G4double vr = 0.9277 - 3.6224/(b-2.);
+  while ( true ) {
+    G4double u = G4UniformRand() - 0.5, v = G4UniformRand();
+    G4double us = 0.5 - fabs(u);
+    G4double k = floor((2.*a/us + b)*u + mean + 0.43);
+    if ( us >= 0.07 && v <= vr ) return G4int(k);
+    if ( k < 0 || (us < 0.013 && v > us) ) continue;
+    if ( log(v*invalpha/(a/(us*us) + b)) <= -mean + k*loglam - LogFactorial(k) )
+      return G4int(k);
   }
-  if ( N1 > N0 ) N1 = N0;
-  if ( N1 < 0 ) N1 = 0;
-  return N1;
 }
 
 void InitMatPropValues ( G4MaterialPropertiesTable *nobleElementMat ) {
@@ -1649,11 +1799,11 @@ int modPoisRnd(double poisMean, double preFactor) {
   if ( preFactor >= 1. ) {
     poisMean = G4RandGauss::shoot(poisMean,sqrt((preFactor-1.)*poisMean));
     if ( poisMean < 0. ) poisMean = 0.;
-    randomNumber = G4Poisson(poisMean);
+    randomNumber = PoisFluct(poisMean);
   }
   else
     randomNumber =
-      int(floor(double(G4Poisson(poisMean/preFactor))*preFactor+G4UniformRand()));
+      int(floor(double(PoisFluct(poisMean/preFactor))*preFactor+G4UniformRand()));
 
   if ( randomNumber < 0 ) randomNumber = 0; //jic
 
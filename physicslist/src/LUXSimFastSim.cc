@@ -8,6 +8,8 @@
 const int numZLevels = 25;
 const int numPMTs = 122;
 
+G4int BinomFluct(G4int N0, G4double prob); //in G4S1Light.cc
+
 FastSim::FastSim(const char* libraryFilename, const char* connectFileName){
     //The kludge mentioned here is marked with a TODO in electronsToPHE()
     std::cout << "Note: FastSim S2 is being corrected.  This is correct for\n"
@@ -814,24 +816,9 @@ int FastSim::inverseSkewGaussianCDF(double beta) {
     return skewCDF_X[indexMin];
 }
 
+//The same exact sampler as the full simulation, which is in G4S1Light.cc
 G4int FastSim::BinomFluct ( G4int N0, G4double prob ) {
-  G4double mean = N0*prob;
-  G4double sigma = sqrt(N0*prob*(1-prob));
-  G4int N1 = 0;
-  if ( prob == 0.00 ) return N1;
-  if ( prob == 1.00 ) return N0;
-
-  if ( N0 < 10 ) {
-    for(G4int i = 0; i < N0; i++) {
-      if(G4UniformRand() < prob) N1++;
-    }
-  }
-  else {
-    N1 = G4int(floor(G4RandGauss::shoot(mean,sigma)+0.5));
-  }
-  if ( N1 > N0 ) N1 = N0;
-  if ( N1 < 0 ) N1 = 0;
-  return N1;
+  return ::BinomFluct(N0,prob);
 }
 
 void FastSim::LoadDoublePHEProb(G4String fileName) {
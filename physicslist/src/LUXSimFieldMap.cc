@@ -0,0 +1,341 @@
+////////////////////////////////////////////////////////////////////////////////
+/*	LUXSimFieldMap.cc
+*
+* This is the code file for the r-z field, drift time and radial drift maps.
+* See the header file for a description of the file formats.
+*
+********************************************************************************
+* Change log
+*	19-Oct-26 - Initial submission
+*	19-Oct-26 - Added 3D maps and single precision storage
+*
+*/
+////////////////////////////////////////////////////////////////////////////////
+
+//
+//	C/C++ includes
+//
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+//
+//	GEANT4 includes
+//
+#include "globals.hh"
+
+//
+//	LUXSim includes
+//
+#include "LUXSimFieldMap.hh"
+
+//
+//	Definitions
+//
+#define CACHE_MAGIC "LUXmap02"
+#define CACHE_XYZ 1
+#define CACHE_FLOAT 2
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					LUXSimFieldMap()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+LUXSimFieldMap::LUXSimFieldMap( G4String desc )
+{
+	description = desc;
+
+	is3D = false;
+	for( G4int axis=0; axis<3; axis++ ) {
+		numPoints[axis] = 0;
+		origin[axis] = 0;
+		spacing[axis] = 1.*mm;
+	}
+	yStride = zStride = 0;
+
+	doubleValues = 0;
+	floatValues = 0;
+	mappedCache = 0;
+	mappedCacheSize = 0;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					~LUXSimFieldMap()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+LUXSimFieldMap::~LUXSimFieldMap()
+{
+	Unload();
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					Load()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimFieldMap::Load( G4String fileName )
+{
+	if( IsLoaded() && fileName == loadedFileName )
+		return;
+
+	Unload();
+	if( !MapCache( fileName ) ) {
+		ReadText( fileName );
+		WriteCache( fileName );
+	}
+	yStride = numPoints[0];
+	zStride = numPoints[0]*numPoints[1];
+	loadedFileName = fileName;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					HasSameGrid()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4bool LUXSimFieldMap::HasSameGrid( const LUXSimFieldMap &map ) const
+{
+	if( is3D != map.is3D )
+		return false;
+	for( G4int axis=0; axis<3; axis++ )
+		if( numPoints[axis] != map.numPoints[axis] ||
+				origin[axis] != map.origin[axis] ||
+				spacing[axis] != map.spacing[axis] )
+			return false;
+
+	return true;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					Unload()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimFieldMap::Unload()
+{
+	if( mappedCache )
+		munmap( mappedCache, mappedCacheSize );
+	mappedCache = 0;
+	mappedCacheSize = 0;
+
+	std::vector<G4double>().swap( parsedDoubleValues );
+	std::vector<float>().swap( parsedFloatValues );
+	doubleValues = 0;
+	floatValues = 0;
+	loadedFileName = "";
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					ReadText()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimFieldMap::ReadText( G4String fileName )
+{
+	std::ifstream gridFile( fileName.c_str() );
+	if( !gridFile.is_open() ) {
+		G4cout << G4endl << G4endl << G4endl;
+		G4cout << description << " File Not Found! " << fileName << G4endl;
+		G4cout << G4endl << G4endl << G4endl;
+		exit(0);
+	}
+
+	G4int headerNumPoints[3] = { 0, 0, 0 };
+	G4bool singlePrecision = false;
+	is3D = false;
+	for( G4int axis=0; axis<3; axis++ ) {
+		numPoints[axis] = 0;
+		origin[axis] = 0;
+		spacing[axis] = 1.*mm;
+	}
+
+	G4int numLines = 0;
+	std::string line;
+	while( std::getline( gridFile, line ) ) {
+		if( line.find_first_not_of( " \t\r" ) == std::string::npos )
+			continue;
+
+		if( line[ line.find_first_not_of( " \t" ) ] == '#' ) {
+			std::istringstream header( line.substr( line.find( '#' ) + 1 ) );
+			std::string key, value;
+			if( !( header >> key >> value ) )
+				continue;
+			G4double number = atof( value.c_str() );
+
+			//	r is the first axis of a 2D map, in the place of x
+			G4int axis = -1;
+			if( key.size() > 1 && key[0] == 'r' ) axis = 0;
+			else if( key.size() > 1 && key[0] == 'x' ) axis = 0;
+			else if( key.size() > 1 && key[0] == 'y' ) axis = 1;
+			else if( key.size() > 1 && key[0] == 'z' ) axis = 2;
+			if( key.size() == 4 && key.substr( 0, 3 ) == "num" )
+				axis = ( key[3] == 'Y' ? 1 : ( key[3] == 'Z' ? 2 : 0 ) );
+
+			if( key == "coordinates" ) is3D = ( value == "xyz" );
+			else if( key == "precision" ) singlePrecision = ( value == "float" );
+			else if( axis >= 0 && key.substr( 0, 3 ) == "num" )
+				headerNumPoints[axis] = (G4int)number;
+			else if( axis >= 0 && key.substr( 1 ) == "Origin" )
+				origin[axis] = number*mm;
+			else if( axis >= 0 && key.substr( 1 ) == "Spacing" )
+				spacing[axis] = number*mm;
+			continue;
+		}
+
+		//	strtod is used because this runs over a few hundred thousand
+		//	values, and a stream extraction per value is slow
+		const char *start = line.c_str();
+		char *end;
+		G4int numOnLine = 0;
+		while( true ) {
+			G4double value = strtod( start, &end );
+			if( end == start )
+				break;
+			parsedDoubleValues.push_back( value );
+			numOnLine++;
+			start = end;
+		}
+
+		if( !numPoints[0] )
+			numPoints[0] = numOnLine;
+		if( numOnLine != numPoints[0] ) {
+			G4cout << G4endl << G4endl << G4endl;
+			G4cout << "Line " << numLines+1 << " of the " << description
+				   << " file " << fileName << " has " << numOnLine
+				   << " values instead of " << numPoints[0] << G4endl;
+			G4cout << G4endl << G4endl << G4endl;
+			exit(0);
+		}
+		numLines++;
+	}
+	gridFile.close();
+
+	numPoints[1] = ( is3D ? headerNumPoints[1] : 1 );
+	if( numPoints[1] > 0 && numLines % numPoints[1] == 0 )
+		numPoints[2] = numLines / numPoints[1];
+
+	G4bool validGrid = ( numPoints[0] > 1 && numPoints[2] > 1 &&
+			( !is3D || numPoints[1] > 1 ) );
+	for( G4int axis=0; axis<3; axis++ )
+		if( spacing[axis] <= 0 || ( headerNumPoints[axis] &&
+				headerNumPoints[axis] != numPoints[axis] ) )
+			validGrid = false;
+	if( !validGrid ) {
+		G4cout << G4endl << G4endl << G4endl;
+		G4cout << "The " << description << " file " << fileName
+			   << " does not hold a valid grid (" << numPoints[0] << " x "
+			   << numPoints[1] << " x " << numPoints[2] << " values from "
+			   << numLines << " lines)" << G4endl;
+		G4cout << G4endl << G4endl << G4endl;
+		exit(0);
+	}
+
+	if( singlePrecision ) {
+		parsedFloatValues.assign( parsedDoubleValues.begin(),
+				parsedDoubleValues.end() );
+		std::vector<G4double>().swap( parsedDoubleValues );
+		floatValues = &parsedFloatValues[0];
+	} else
+		doubleValues = &parsedDoubleValues[0];
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					MapCache()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4bool LUXSimFieldMap::MapCache( G4String fileName )
+{
+	//	The cache is only good if the map it came from hasn't changed
+	struct stat mapStat;
+	if( stat( fileName.c_str(), &mapStat ) )
+		return false;
+
+	G4String cacheName = fileName + ".cache";
+	int cacheFile = open( cacheName.c_str(), O_RDONLY );
+	if( cacheFile < 0 )
+		return false;
+
+	struct stat cacheStat;
+	if( fstat( cacheFile, &cacheStat ) ||
+			cacheStat.st_size < (off_t)sizeof(cacheHeader) ) {
+		close( cacheFile );
+		return false;
+	}
+
+	void *cache = mmap( 0, cacheStat.st_size, PROT_READ, MAP_PRIVATE,
+			cacheFile, 0 );
+	close( cacheFile );
+	if( cache == MAP_FAILED )
+		return false;
+
+	const cacheHeader *header = (const cacheHeader*)cache;
+	size_t valueSize = ( header->flags & CACHE_FLOAT ) ? sizeof(float) :
+			sizeof(G4double);
+	if( strncmp( header->magic, CACHE_MAGIC, 8 ) ||
+			header->mapSize != (long long)mapStat.st_size ||
+			header->mapTime != (long long)mapStat.st_mtime ||
+			header->numPoints[0] < 2 || header->numPoints[1] < 1 ||
+			header->numPoints[2] < 2 ||
+			cacheStat.st_size != (off_t)( sizeof(cacheHeader) +
+					(size_t)header->numPoints[0]*header->numPoints[1]*
+					header->numPoints[2]*valueSize ) ) {
+		munmap( cache, cacheStat.st_size );
+		return false;
+	}
+
+	mappedCache = cache;
+	mappedCacheSize = cacheStat.st_size;
+
+	is3D = ( header->flags & CACHE_XYZ );
+	for( G4int axis=0; axis<3; axis++ ) {
+		numPoints[axis] = header->numPoints[axis];
+		origin[axis] = header->origin[axis];
+		spacing[axis] = header->spacing[axis];
+	}
+	const char *data = (const char*)cache + sizeof(cacheHeader);
+	if( header->flags & CACHE_FLOAT )
+		floatValues = (const float*)data;
+	else
+		doubleValues = (const G4double*)data;
+
+	return true;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					WriteCache()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimFieldMap::WriteCache( G4String fileName )
+{
+	struct stat mapStat;
+	if( stat( fileName.c_str(), &mapStat ) )
+		return;
+
+	//	Write to a temporary file and rename it, so that jobs sharing a
+	//	checkout never see a half-written cache
+	G4String cacheName = fileName + ".cache";
+	std::stringstream tempName;
+	tempName << cacheName << "." << getpid();
+
+	std::ofstream cache( tempName.str().c_str(),
+			std::ios::out | std::ios::binary );
+	if( !cache.is_open() )
+		return;
+
+	cacheHeader header;
+	memset( &header, 0, sizeof(header) );
+	memcpy( header.magic, CACHE_MAGIC, 8 );
+	header.mapSize = mapStat.st_size;
+	header.mapTime = mapStat.st_mtime;
+	header.flags = ( is3D ? CACHE_XYZ : 0 ) | ( floatValues ? CACHE_FLOAT : 0 );
+	for( G4int axis=0; axis<3; axis++ ) {
+		header.numPoints[axis] = numPoints[axis];
+		header.origin[axis] = origin[axis];
+		header.spacing[axis] = spacing[axis];
+	}
+	cache.write( (char*)&header, sizeof(header) );
+
+	size_t numValues = (size_t)numPoints[0]*numPoints[1]*numPoints[2];
+	if( floatValues )
+		cache.write( (char*)floatValues, numValues*sizeof(float) );
+	else
+		cache.write( (char*)doubleValues, numValues*sizeof(G4double) );
+	cache.close();
+
+	if( !cache || rename( tempName.str().c_str(), cacheName.c_str() ) )
+		remove( tempName.str().c_str() );
+}
@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////
+/*	LUXSimFunctionTable.cc
+*
+* This is the code file for the interpolation tables of one-variable fits.
+* See the header file for a description.
+*
+********************************************************************************
+* Change log
+*	19-Oct-26 - Initial submission
+*
+*/
+////////////////////////////////////////////////////////////////////////////////
+
+//
+//	C/C++ includes
+//
+#include <cmath>
+
+//
+//	GEANT4 includes
+//
+#include "globals.hh"
+
+//
+//	LUXSim includes
+//
+#include "LUXSimFunctionTable.hh"
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					LUXSimFunctionTable()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+LUXSimFunctionTable::LUXSimFunctionTable()
+{
+	function = 0;
+	xMin = xMax = 0;
+	uMin = 0;
+	inverseSpacing = 0;
+	maxRelativeError = 0;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					~LUXSimFunctionTable()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+LUXSimFunctionTable::~LUXSimFunctionTable()
+{}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					Build()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimFunctionTable::Build( G4double (*func)( G4double ), G4double min,
+		G4double max, G4double tolerance, G4int maxPoints )
+{
+	function = func;
+	xMin = min;
+	xMax = max;
+	uMin = sqrt( xMin );
+
+	//	Start with 64 bins, and double the number of bins until the
+	//	interpolation is good enough everywhere
+	G4int numBins = 64;
+	while( true ) {
+		G4double spacing = ( sqrt( xMax ) - uMin ) / numBins;
+		values.resize( numBins + 1 );
+		for( G4int i=0; i<=numBins; i++ ) {
+			G4double u = uMin + i*spacing;
+			values[i] = function( u*u );
+		}
+		values[0] = function( xMin );
+		values[numBins] = function( xMax );
+
+		maxRelativeError = 0;
+		for( G4int i=0; i<numBins; i++ ) {
+			G4double u = uMin + ( i + 0.5 )*spacing;
+			G4double exact = function( u*u );
+			G4double error = fabs( 0.5*( values[i] + values[i+1] ) - exact );
+			if( exact != 0 )
+				error /= fabs( exact );
+			if( error > maxRelativeError )
+				maxRelativeError = error;
+		}
+
+		if( maxRelativeError <= tolerance || 2*numBins + 1 > maxPoints ) {
+			inverseSpacing = 1. / spacing;
+			break;
+		}
+		numBins *= 2;
+	}
+
+	if( maxRelativeError > tolerance ) {
+		G4cout << G4endl << G4endl << G4endl;
+		G4cout << "WARNING: the interpolation table from " << xMin << " to "
+			   << xMax << " is only good to " << maxRelativeError
+			   << " with " << values.size() << " points" << G4endl;
+		G4cout << G4endl << G4endl << G4endl;
+	}
+}
@@ -0,0 +1,393 @@
+////////////////////////////////////////////////////////////////////////////////
+/*	LUXSimOpticalFastModel.cc
+*
+* This is the code file for the optical photon fast path. See the header file
+* for a description.
+*
+********************************************************************************
+* Change log
+*	19-Oct-26 - Initial submission
+*	19-Oct-26 - The model is triggered from the geometry alone, and a photon
+*				whose path reaches a boundary is moved to just short of it
+*				rather than left at its last scatter
+*
+*/
+////////////////////////////////////////////////////////////////////////////////
+
+//
+//	C/C++ includes
+//
+#include <cmath>
+
+//
+//	CLHEP includes
+//
+#include "CLHEP/Units/PhysicalConstants.h"
+
+//
+//	GEANT4 includes
+//
+#include "globals.hh"
+#include "G4FastTrack.hh"
+#include "G4FastStep.hh"
+#include "G4Track.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4ProcessManager.hh"
+#include "G4OpAbsorption.hh"
+#include "G4OpRayleigh.hh"
+#include "G4OpWLS.hh"
+#include "Randomize.hh"
+
+//
+//	LUXSim includes
+//
+#include "LUXSimOpticalFastModel.hh"
+#include "LUXSimQuantumEfficiency.hh"
+
+//
+//	Definitions
+//
+#define BOUNDARY_GAP 1.e-3	//	mm, how far short of a boundary photons are left
+
+G4int LUXSimOpticalFastModel::numRayleigh = 0;
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					LUXSimOpticalFastModel()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+LUXSimOpticalFastModel::LUXSimOpticalFastModel( G4String name,
+		G4Envelope *region )
+	: G4VFastSimulationModel( name, region )
+{
+	currentEnvelope = 0;
+
+	processesFound = false;
+	absorptionProcess = 0;
+	rayleighProcess = 0;
+	wlsProcess = 0;
+	pheProcess = 0;
+
+	absorptionRate = 0;
+	rayleighRate = 0;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					~LUXSimOpticalFastModel()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+LUXSimOpticalFastModel::~LUXSimOpticalFastModel()
+{}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					IsApplicable()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4bool LUXSimOpticalFastModel::IsApplicable(
+		const G4ParticleDefinition &particle )
+{
+	return( &particle == G4OpticalPhoton::OpticalPhotonDefinition() );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					ModelTrigger()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4bool LUXSimOpticalFastModel::ModelTrigger( const G4FastTrack &fastTrack )
+{
+	const G4Track *track = fastTrack.GetPrimaryTrack();
+
+	//	The daughter volumes of the envelope are in the same region, but they
+	//	aren't homogeneous with it
+	if( track->GetVolume()->GetLogicalVolume() !=
+			fastTrack.GetEnvelopeLogicalVolume() )
+		return false;
+
+	//	A photon that was left just short of a boundary, or that has scattered
+	//	back towards it, is taken across by the normal tracking
+	if( !FindProcesses() || !IsClearOfBoundary(
+			fastTrack.GetEnvelopeLogicalVolume(),
+			fastTrack.GetPrimaryTrackLocalPosition(),
+			fastTrack.GetPrimaryTrackLocalDirection() ) )
+		return false;
+
+	//	The mean free paths come from the processes themselves, so they are
+	//	the ones the normal tracking would use for this photon
+	G4ForceCondition condition;
+	if( wlsProcess &&
+			wlsProcess->GetMeanFreePath( *track, 0, &condition ) < DBL_MAX )
+		return false;
+	if( pheProcess &&
+			pheProcess->GetMeanFreePath( *track, 0, &condition ) < DBL_MAX )
+		return false;
+
+	absorptionRate = 0;
+	if( absorptionProcess ) {
+		G4double length =
+				absorptionProcess->GetMeanFreePath( *track, 0, &condition );
+		if( length < DBL_MAX )
+			absorptionRate = 1. / length;
+	}
+	rayleighRate = 0;
+	if( rayleighProcess ) {
+		G4double length =
+				rayleighProcess->GetMeanFreePath( *track, 0, &condition );
+		if( length < DBL_MAX )
+			rayleighRate = 1. / length;
+	}
+
+	//	Nothing is sampled here. Whether the photon interacts before the
+	//	boundary is up to DoIt, which then has to take it either way.
+	return( absorptionRate + rayleighRate > 0 );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					DoIt()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimOpticalFastModel::DoIt( const G4FastTrack &fastTrack,
+		G4FastStep &fastStep )
+{
+	const G4Track *track = fastTrack.GetPrimaryTrack();
+
+	//	Everything is done in the frame of the envelope. Rayleigh scattering
+	//	doesn't care about the orientation of the frame.
+	G4ThreeVector position = fastTrack.GetPrimaryTrackLocalPosition();
+	G4ThreeVector direction = fastTrack.GetPrimaryTrackLocalDirection();
+	G4ThreeVector polarization = fastTrack.GetPrimaryTrackLocalPolarization();
+	G4double pathLength = 0;
+
+	G4bool absorbed = Transport( fastTrack.GetEnvelopeLogicalVolume(),
+			absorptionRate, rayleighRate, position, direction, polarization,
+			pathLength );
+
+	fastStep.ProposePrimaryTrackFinalPosition( position );
+	fastStep.ProposePrimaryTrackFinalTime( track->GetGlobalTime() +
+			pathLength / track->GetVelocity() );
+	fastStep.ProposePrimaryTrackPathLength( pathLength );
+
+	if( absorbed ) {
+		fastStep.KillPrimaryTrack();
+		return;
+	}
+
+	fastStep.ProposePrimaryTrackFinalMomentumDirection( direction );
+	fastStep.ProposePrimaryTrackFinalPolarization( polarization );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					IsClearOfBoundary()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4bool LUXSimOpticalFastModel::IsClearOfBoundary(
+		const G4LogicalVolume *logicalVolume, const G4ThreeVector &position,
+		const G4ThreeVector &direction )
+{
+	//	Two gaps, so that a photon left a gap short of the boundary is never
+	//	taken again, however the distance rounds
+	currentEnvelope = &GetEnvelope( logicalVolume );
+	if( !currentEnvelope->usable )
+		return false;
+
+	return IsBeforeBoundary( position, direction, 2.*BOUNDARY_GAP );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					Transport()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4bool LUXSimOpticalFastModel::Transport( const G4LogicalVolume *logicalVolume,
+		G4double absorption, G4double rayleigh,
+		G4ThreeVector &position, G4ThreeVector &direction,
+		G4ThreeVector &polarization, G4double &pathLength )
+{
+	currentEnvelope = &GetEnvelope( logicalVolume );
+
+	G4double totalRate = absorption + rayleigh;
+	numRayleigh = 0;
+
+	//	Each free path is drawn from the point the photon has got to, and is
+	//	used whether or not it reaches the boundary
+	while( true ) {
+		G4double distance = -log( G4UniformRand() ) / totalRate;
+
+		if( !IsBeforeBoundary( position, direction, distance + BOUNDARY_GAP ) ) {
+			G4double flight = GetDistanceToBoundary( position, direction ) -
+					BOUNDARY_GAP;
+			if( flight > 0 ) {
+				position += flight*direction;
+				pathLength += flight;
+			}
+			return false;
+		}
+
+		position += distance*direction;
+		pathLength += distance;
+
+		if( G4UniformRand()*totalRate < absorption )
+			return true;
+
+		RayleighScatter( direction, polarization );
+		numRayleigh++;
+	}
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					GetEnvelope()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+const LUXSimOpticalFastModel::envelope &LUXSimOpticalFastModel::GetEnvelope(
+		const G4LogicalVolume *logicalVolume )
+{
+	std::map<const G4LogicalVolume*, envelope>::iterator it =
+			envelopes.find( logicalVolume );
+	if( it != envelopes.end() )
+		return it->second;
+
+	//	The transforms take a point from the frame of the envelope to the
+	//	frame of the daughter, the same way the navigator does it
+	envelope &newEnvelope = envelopes[logicalVolume];
+	newEnvelope.usable = true;
+	newEnvelope.solid = logicalVolume->GetSolid();
+	for( G4int i=0; i<logicalVolume->GetNoDaughters(); i++ ) {
+		G4VPhysicalVolume *daughter = logicalVolume->GetDaughter(i);
+		if( daughter->IsReplicated() || daughter->IsParameterised() ) {
+			G4cout << G4endl << G4endl << G4endl;
+			G4cout << "WARNING: the optical fast path can't be used in "
+				   << logicalVolume->GetName() << ", because its daughter "
+				   << daughter->GetName() << G4endl
+				   << "is replicated or parameterised. The photons in it are "
+				   << "tracked as usual." << G4endl;
+			G4cout << G4endl << G4endl << G4endl;
+			newEnvelope.usable = false;
+			break;
+		}
+		G4AffineTransform transform( daughter->GetRotation(),
+				daughter->GetTranslation() );
+		transform.Invert();
+		newEnvelope.daughterSolids.push_back(
+				daughter->GetLogicalVolume()->GetSolid() );
+		newEnvelope.daughterTransforms.push_back( transform );
+	}
+
+	return newEnvelope;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					FindProcesses()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4bool LUXSimOpticalFastModel::FindProcesses()
+{
+	//	The processes can't be found in the constructor, because the model is
+	//	made before the physics list
+	if( processesFound )
+		return( absorptionProcess || rayleighProcess );
+
+	G4ProcessVector *processes = G4OpticalPhoton::OpticalPhoton()->
+			GetProcessManager()->GetProcessList();
+	for( G4int i=0; i<(G4int)processes->size(); i++ ) {
+		G4String name = (*processes)[i]->GetProcessName();
+		if( name == "OpAbsorption" )
+			absorptionProcess = (G4OpAbsorption*)(*processes)[i];
+		else if( name == "OpRayleigh" )
+			rayleighProcess = (G4OpRayleigh*)(*processes)[i];
+		else if( name == "OpWLS" )
+			wlsProcess = (G4OpWLS*)(*processes)[i];
+		else if( name == "pheConv" )
+			pheProcess = (LUXSimQuantumEfficiency*)(*processes)[i];
+	}
+	processesFound = true;
+
+	return( absorptionProcess || rayleighProcess );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					IsBeforeBoundary()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4bool LUXSimOpticalFastModel::IsBeforeBoundary( const G4ThreeVector &position,
+		const G4ThreeVector &direction, G4double distance )
+{
+	//	The isotropic safety is cheaper than the distance along the direction,
+	//	and is usually enough to decide
+	const envelope &env = *currentEnvelope;
+	G4int numDaughters = env.daughterSolids.size();
+
+	G4double safety = env.solid->DistanceToOut( position );
+	for( G4int i=0; i<numDaughters && distance < safety; i++ ) {
+		G4double daughterSafety = env.daughterSolids[i]->DistanceToIn(
+				env.daughterTransforms[i].TransformPoint( position ) );
+		if( daughterSafety < safety )
+			safety = daughterSafety;
+	}
+	if( distance < safety )
+		return true;
+
+	if( distance >= env.solid->DistanceToOut( position, direction ) )
+		return false;
+	for( G4int i=0; i<numDaughters; i++ )
+		if( distance >= env.daughterSolids[i]->DistanceToIn(
+				env.daughterTransforms[i].TransformPoint( position ),
+				env.daughterTransforms[i].TransformAxis( direction ) ) )
+			return false;
+
+	return true;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					GetDistanceToBoundary()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4double LUXSimOpticalFastModel::GetDistanceToBoundary(
+		const G4ThreeVector &position, const G4ThreeVector &direction )
+{
+	const envelope &env = *currentEnvelope;
+	G4int numDaughters = env.daughterSolids.size();
+
+	G4double distance = env.solid->DistanceToOut( position, direction );
+	for( G4int i=0; i<numDaughters; i++ ) {
+		G4double daughterDistance = env.daughterSolids[i]->DistanceToIn(
+				env.daughterTransforms[i].TransformPoint( position ),
+				env.daughterTransforms[i].TransformAxis( direction ) );
+		if( daughterDistance < distance )
+			distance = daughterDistance;
+	}
+
+	return distance;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					RayleighScatter()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimOpticalFastModel::RayleighScatter( G4ThreeVector &direction,
+		G4ThreeVector &polarization )
+{
+	//	This is the sampling in G4OpRayleigh::PostStepDoIt, so that the
+	//	scattered photons have the same distribution of direction and
+	//	polarization
+	G4ThreeVector oldDirection = direction.unit();
+	G4ThreeVector oldPolarization = polarization;
+	G4ThreeVector newDirection, newPolarization;
+	G4double cosTheta;
+
+	do {
+		G4double CosTheta = G4UniformRand();
+		G4double SinTheta = sqrt( 1. - CosTheta*CosTheta );
+		if( G4UniformRand() < 0.5 ) CosTheta = -CosTheta;
+
+		G4double phi = CLHEP::twopi*G4UniformRand();
+		newDirection.set( SinTheta*cos( phi ), SinTheta*sin( phi ), CosTheta );
+		newDirection.rotateUz( oldDirection );
+		newDirection = newDirection.unit();
+
+		//	The new polarization is in the plane of the new direction and the
+		//	old polarization
+		G4double constant = -1. / newDirection.dot( oldPolarization );
+		newPolarization = newDirection + constant*oldPolarization;
+		newPolarization = newPolarization.unit();
+
+		if( newPolarization.mag() == 0. ) {
+			phi = CLHEP::twopi*G4UniformRand();
+			newPolarization.set( cos( phi ), sin( phi ), 0. );
+			newPolarization.rotateUz( newDirection );
+		} else if( G4UniformRand() < 0.5 )
+			newPolarization = -newPolarization;
+
+		cosTheta = newPolarization.dot( oldPolarization );
+	} while( cosTheta*cosTheta < G4UniformRand() );
+
+	direction = newDirection;
+	polarization = newPolarization;
+}
@@ -15,6 +15,8 @@
 *       02-Nov-12 - Improved Cerenkov options (Matthew, Henrique)
 *       08-Jun-15 - The G4S2Light class now gets invoked via a different call,
 *                   it now includes a pointer to the G4S1Light class (Kareem)
+*	19-Oct-26 - Added the optical photon fast path process
+*	19-Oct-26 - The QE process is kept, so the manager can reach it
 */
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -28,6 +30,7 @@
 #include "G4OpRayleigh.hh"
 #include "G4OpBoundaryProcess.hh"
 #include "G4OpWLS.hh"
+#include "G4FastSimulationManagerProcess.hh"
 
 #include "LUXSimQuantumEfficiency.hh"
 
@@ -48,6 +51,10 @@
 LUXSimPhysicsOpticalPhysics::LUXSimPhysicsOpticalPhysics()
     : G4VPhysicsConstructor("Optical")
 {
+	theScintProcess = NULL;
+	theCerenkovProcess = NULL;
+	thePheProcess = NULL;
+
 	luxManager = LUXSimManager::GetManager();
 	luxManager->Register( this );
 }
@@ -82,7 +89,7 @@ void LUXSimPhysicsOpticalPhysics::ConstructProcess()
 	theCerenkovProcess->SetTrackSecondariesFirst(true);
 	theCerenkovProcess->SetMaxNumPhotonsPerStep(MaxNumPhotons);
 	
-	LUXSimQuantumEfficiency *PHE = new LUXSimQuantumEfficiency();
+	thePheProcess = new LUXSimQuantumEfficiency();
 	
 	G4OpAbsorption* theAbsorptionProcess = new G4OpAbsorption();
 	G4OpRayleigh* theRayleighScattering = new G4OpRayleigh();
@@ -113,6 +120,12 @@ void LUXSimPhysicsOpticalPhysics::ConstructProcess()
 
 	pManager->AddDiscreteProcess(theWLSProcess);
 
+	//	The optical fast path (LUXSimOpticalFastModel) only acts in the volumes
+	//	named with /LUXSim/physicsList/opticalFastPath, so the process is
+	//	always there, and costs next to nothing when no volume is named
+	pManager->AddDiscreteProcess(
+			new G4FastSimulationManagerProcess( "OpFastPath" ) );
+
 	//theScintProcess->SetScintillationYieldFactor(1.);
 	//theScintProcess->SetScintillationExcitationRatio(0.06);
 	theScintProcess->SetTrackSecondariesFirst(true);
@@ -139,7 +152,7 @@ void LUXSimPhysicsOpticalPhysics::ConstructProcess()
 		  pManager->AddProcess(theScintProcess,ordDefault,ordInActive,ordDefault);
 		if( theLuminProcess->IsApplicable(*particle) )
 		  pManager->AddProcess(theLuminProcess,ordDefault,ordInActive,ordDefault);
-		if( PHE->IsApplicable(*particle) )
-		  pManager->AddProcess(PHE,ordDefault,ordInActive,ordDefault);
+		if( thePheProcess->IsApplicable(*particle) )
+		  pManager->AddProcess(thePheProcess,ordDefault,ordInActive,ordDefault);
 	}
 }
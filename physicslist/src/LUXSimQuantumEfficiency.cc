@@ -32,6 +32,25 @@
  *       15 Apr 2015 - Adjusting the top PMT QE according to the output of the 
  *                     light collection simulations and applying the "cold 
  *                     bonus" to the PMT QE too.  (Vic)
+ *       19 Oct 2026 - The PMT number and QE scaling of each photocathode are
+ *                     looked up by volume, instead of being parsed from the
+ *                     volume name for every photon. The angular term uses the
+ *                     direction cosine directly, without acos and cos.
+ *       19 Oct 2026 - Photons that survived the optical photon roulette are
+ *                     converted as many times as their weight, rounded up or
+ *                     down at random, so the mean phe count is unchanged.
+ *       19 Oct 2026 - Converted photons are counted by the light map builder
+ *                     while it's running.
+ *       19 Oct 2026 - A photocathode whose number has no calibration (e.g., in
+ *                     the LZ geometry) keeps the nominal QE and the default
+ *                     double-phe rate, with a warning, rather than using PMT
+ *                     1's numbers.
+ *       19 Oct 2026 - The phe from a weighted photon are drawn with BinomFluct
+ *                     instead of one try per unit of weight, and weights are
+ *                     capped at MAX_PHOTON_WEIGHT.
+ *       19 Oct 2026 - The photocathode lookup compares volume addresses only.
+ *                     The manager clears it when the geometry or the PMT
+ *                     numbering scheme changes.
  */
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -50,20 +69,31 @@
 #include "G4DynamicParticle.hh"
 #include "G4VParticleChange.hh"
 #include "G4ThreeVector.hh"
+#include "G4VPhysicalVolume.hh"
 
 #include "LUXSimQuantumEfficiency.hh"
 #include "LUXSimManager.hh"
 #include "LUXSim1_0PMTRenumbering.hh"
+#include "LUXSimOpticalTrackInformation.hh"
+#include "LUXSimLightMap.hh"
 #include <iostream>
 #include <string>
 #include <fstream>
 using namespace std;
 
+#define MAX_PHOTON_WEIGHT 1.e6 //roulette weight cap, so the phe count fits an int
+
+G4int BinomFluct(G4int N0, G4double prob); //in G4S1Light.cc
+
 LUXSimQuantumEfficiency::LUXSimQuantumEfficiency(const G4String& processName)
       : G4VRestDiscreteProcess(processName) 
 {
   LoadDoublePHEProb("physicslist/src/DoublePHEperDPH.txt");
   LoadQEValuesFromFile("physicslist/src/PMTQEvals.txt");
+  lastVolume = 0;
+  lastPhotoCathode = 0;
+  warnedUncalibrated = false;
+  warnedWeight = false;
 }
 
 LUXSimQuantumEfficiency::~LUXSimQuantumEfficiency() {}
@@ -85,12 +115,12 @@ const G4Track& aTrack, const G4Step& aStep)
     G4ThreeVector x1 = pPostStepPoint->GetPosition();
     G4double      t1 = pPostStepPoint->GetGlobalTime();
     
-    //find current direction of the photon, and angle
+    //find current direction of the photon, and the cosine of its angle to
+    //the PMT axis (the angle itself isn't needed)
     G4ParticleMomentum oldMoment = aParticle->GetMomentumDirection().unit();
-    G4double Angle = acos ( fabs(oldMoment.z()) / 
-     sqrt(pow(oldMoment.x(),2.)+pow(oldMoment.y(),2.)+pow(oldMoment.z(),2.)) );
+    G4double cosAngle = fabs(oldMoment.z());
     if ( oldMoment.x() == 0 && oldMoment.y() == 0 )
-      Angle = 0.; //point photon straight up when x and y are zero
+      cosAngle = 1.; //point photon straight up when x and y are zero
     //G4double Direction = oldMoment.z();
     G4int sign = 0; //which way are you going? Up or down?
     if ( x1[2] < 0 ) sign = -1;
@@ -105,7 +135,7 @@ const G4Track& aTrack, const G4Step& aStep)
     //calculate the quantum efficiency
     G4double fOptPhoWaveLength_nm = (1.2398/(KE/keV));
     G4double QE = 1.5343 - 0.0062269*fOptPhoWaveLength_nm;
-    QE *= (1-exp(-1.7/cos(Angle)))/(1-exp(-1.7)); //angular dependence (Luiz)
+    QE *= (1-exp(-1.7/cosAngle))/(1-exp(-1.7)); //angular dependence (Luiz)
     //fprintf(stderr,"%f rad\n",Angle*sign);
     G4double Temperature = aMaterial->GetTemperature()/kelvin;
     if ( Temperature < 200 ) {
@@ -127,53 +157,16 @@ const G4Track& aTrack, const G4Step& aStep)
     if(QE<0) QE=0; if(QE>1) QE=1; //physicality enforced on poly. spline
     G4double DE = 0.90; //dynode efficiency (from CHF)
 
-    string volumeName = aTrack.GetVolume()->GetName();
-    //Need to get at the numbering-tracking variable
+    //PMT number and QE scaling, including the translation to real PMT
+    //numbers if useRealNumbers is false, from the photocathode lookup
     LUXSimManager *luxManager = LUXSimManager::GetManager();
-    G4bool useRealNumber = luxManager->GetPMTNumberingScheme();
-    //Manipulate volumeName to match real PMT numbers, if useRealNumbers false
-    if(!useRealNumber && 
-       (volumeName.substr(0,21) == "Top_PMT_PhotoCathode_" ||
-	volumeName.substr(0,24) == "Bottom_PMT_PhotoCathode_")) {
-      int pmtNamePosition = 0;
-      if(volumeName[0] == 'T')
-	pmtNamePosition = 21;
-      else
-	pmtNamePosition = 24;
-      string pmtNumString = volumeName.substr(pmtNamePosition);
-      stringstream str;
-      str << pmtNumString;
-      int pmtNum = 0;
-      str >> pmtNum;
-      //Convert pmtNum to real number
-      if(volumeName[0] == 'B')
-	pmtNum += 61;
-      pmtNum = LUXSim1_0PMTRenumbering::GetRealFromOldSim(pmtNum);
-      //Clear stringstream to allow writing
-      pmtNumString.clear();
-      str.str(pmtNumString);
-      str.clear();
-      str.width(2);
-      str.fill('0');
-      str << pmtNum;
-      //Rewrite volume name
-      volumeName.replace(pmtNamePosition, 5, str.str());
-    }
-    char * volName = new char[volumeName.size()+1];
-    volName[volumeName.size()] = 0;
-    memcpy(volName,volumeName.c_str(),volumeName.size());
-    string vStr = volName;
-
-    //get PMT number
-    unsigned pos = vStr.rfind("_");
-    stringstream stream(vStr.substr(pos + 1));
-    unsigned pmtNum;
-    stream >> pmtNum;
+    const photoCathode &cathode = GetPhotoCathode(aTrack.GetVolume());
+    G4int pmtIndex = cathode.pmtIndex;
     
     // QE values should have been loaded into the array 'QEvals[122]' in the
     // constructor function.  Now the following snippet sets the QE values, in 
     // addition to taking into account the ratio of VUV_gains/LED_gains.
-	QE *= QEvals[pmtNum-1] / (doublePheProb[pmtNum-1]+1.);
+	QE *= cathode.qeScale;
     /*
     else {
       if ( sign > 0 ) QE *= 0.30413;
@@ -188,7 +181,7 @@ const G4Track& aTrack, const G4Step& aStep)
     
     int vetoFlag = 0;
     // R5912/R7081 water tank PMTs
-    if ( volumeName.substr(0,23) == "Water_PMT_PhotoCathode_" ) {
+    if ( cathode.isWaterPMT ) {
       vetoFlag = 1;
       if ( fOptPhoWaveLength_nm < 290 || fOptPhoWaveLength_nm > 620)
         QE = 0;
@@ -201,29 +194,55 @@ const G4Track& aTrack, const G4Step& aStep)
       pheMomentum = oldMoment; // propagate phe in direction of photon.
     }
     
-    //phe conversion fails OR 1st dynode not attained
-    if ( G4UniformRand() > QE || G4UniformRand() > DE ) {
-      aParticleChange.SetNumberOfSecondaries(0);
-      return G4VRestDiscreteProcess::PostStepDoIt(aTrack, aStep);
-    }
+    //a photon that survived the roulette in the stepping action stands for
+    //several photons. The output counts phe, so a fractional weight is
+    //rounded up or down at random, and the number of those photons that make
+    //a phe is drawn in one go rather than photon by photon.
+    G4double weight = LUXSimOpticalTrackInformation::GetTrackWeight(&aTrack);
+    G4double doublePhe = 0.2;
+    if ( luxManager->GetLUXDoublePheRateFromFile() && pmtIndex >= 0 )
+      doublePhe = doublePheProb[pmtIndex];
+    if ( fOptPhoWaveLength_nm >= 300. || vetoFlag != 0 ) doublePhe = 0.;
     
-    //generate the photo-electron in the PMT otherwise
-    int phePerDetPhot;
-    if (luxManager->GetLUXDoublePheRateFromFile()) {
-      if ( G4UniformRand() < doublePheProb[pmtNum-1] && fOptPhoWaveLength_nm < 300. && vetoFlag == 0 ) {
-        phePerDetPhot = 2;
-      }
-      else {
-        phePerDetPhot = 1;
-      }
+    int numConverted = 0;
+    if ( weight == 1. ) {
+      //phe conversion fails OR 1st dynode not attained
+      if ( G4UniformRand() <= QE && G4UniformRand() <= DE ) numConverted = 1;
     }
     else {
-      if ( G4UniformRand() < 0.2 && fOptPhoWaveLength_nm < 300. && vetoFlag == 0 ) {
-        phePerDetPhot = 2;
-      }
-      else {
-        phePerDetPhot = 1;
+      if ( weight > MAX_PHOTON_WEIGHT ) {
+        if ( !warnedWeight ) {
+          G4cout<<G4endl<<G4endl<<G4endl;
+          G4cout<<"WARNING: an optical photon reached a photocathode with a "
+                <<"roulette weight of "<<weight<<"."<<G4endl;
+          G4cout<<"Weights are capped at "<<MAX_PHOTON_WEIGHT<<", so the phe "
+                <<"counts are biased low. Use a higher survival probability "
+                <<"or fewer roulette volumes."<<G4endl;
+          G4cout<<G4endl<<G4endl<<G4endl;
+          warnedWeight = true;
+        }
+        weight = MAX_PHOTON_WEIGHT;
       }
+      int numTries = (int)weight;
+      if ( G4UniformRand() < weight - numTries ) numTries++;
+      numConverted = BinomFluct( numTries, ( QE < 1. ? QE : 1. )*DE );
+    }
+    
+    LUXSimLightMap *lightMap = luxManager->GetLightMap();
+    if ( numConverted && lightMap && lightMap->IsBuilding() && vetoFlag == 0 )
+      lightMap->AddDetection( pmtIndex, numConverted );
+    
+    //generate the photo-electrons in the PMT, some of the conversions giving
+    //two
+    int phePerDetPhot = numConverted;
+    if ( numConverted == 1 ) {
+      if ( G4UniformRand() < doublePhe ) phePerDetPhot++;
+    }
+    else
+      phePerDetPhot += BinomFluct( numConverted, doublePhe );
+    if ( !phePerDetPhot ) {
+      aParticleChange.SetNumberOfSecondaries(0);
+      return G4VRestDiscreteProcess::PostStepDoIt(aTrack, aStep);
     }
     aParticleChange.SetNumberOfSecondaries ( phePerDetPhot );
     for ( int i = 0; i < phePerDetPhot; i++ ) {
@@ -257,12 +276,111 @@ G4double LUXSimQuantumEfficiency::GetMeanFreePath(const G4Track& aTrack,
                                           G4double,
                                           G4ForceCondition*)
 {
-  string volumeName = aTrack.GetVolume()->GetName();
-  size_t found = volumeName.find("PhotoCathode"); //only absorb in PMTs
-  if ( found != string::npos ) return 0*nm;
+  //only absorb in PMTs
+  if ( GetPhotoCathode(aTrack.GetVolume()).isPhotoCathode ) return 0*nm;
   else return DBL_MAX; //otherwise do nothing at all
 }
 
+// GetPhotoCathode
+// ---------------
+const LUXSimQuantumEfficiency::photoCathode &
+LUXSimQuantumEfficiency::GetPhotoCathode(const G4VPhysicalVolume *volume)
+{
+  //optical photons tend to take several steps in the same volume, so the
+  //last volume is checked before the map
+  if ( volume == lastVolume && lastPhotoCathode )
+    return *lastPhotoCathode;
+
+  map<const G4VPhysicalVolume*, photoCathode>::iterator found =
+    photoCathodes.find(volume);
+  if ( found == photoCathodes.end() )
+    found = photoCathodes.insert( make_pair(volume,
+                                  MakePhotoCathode(volume)) ).first;
+  lastVolume = volume;
+  lastPhotoCathode = &found->second;
+  return found->second;
+}
+
+// ClearPhotoCathodes
+// ------------------
+void LUXSimQuantumEfficiency::ClearPhotoCathodes()
+{
+  photoCathodes.clear();
+  lastVolume = 0;
+  lastPhotoCathode = 0;
+}
+
+// MakePhotoCathode
+// ----------------
+LUXSimQuantumEfficiency::photoCathode
+LUXSimQuantumEfficiency::MakePhotoCathode(const G4VPhysicalVolume *volume)
+{
+  G4bool useRealNumber = LUXSimManager::GetManager()->GetPMTNumberingScheme();
+  photoCathode cathode;
+  string volumeName = volume->GetName();
+  cathode.isPhotoCathode =
+    ( volumeName.find("PhotoCathode") != string::npos );
+  cathode.isWaterPMT =
+    ( volumeName.substr(0,23) == "Water_PMT_PhotoCathode_" );
+
+  //Manipulate volumeName to match real PMT numbers, if useRealNumbers false
+  if(!useRealNumber && 
+     (volumeName.substr(0,21) == "Top_PMT_PhotoCathode_" ||
+      volumeName.substr(0,24) == "Bottom_PMT_PhotoCathode_")) {
+    int pmtNamePosition = 0;
+    if(volumeName[0] == 'T')
+      pmtNamePosition = 21;
+    else
+      pmtNamePosition = 24;
+    string pmtNumString = volumeName.substr(pmtNamePosition);
+    stringstream str;
+    str << pmtNumString;
+    int pmtNum = 0;
+    str >> pmtNum;
+    //Convert pmtNum to real number
+    if(volumeName[0] == 'B')
+      pmtNum += 61;
+    pmtNum = LUXSim1_0PMTRenumbering::GetRealFromOldSim(pmtNum);
+    //Clear stringstream to allow writing
+    pmtNumString.clear();
+    str.str(pmtNumString);
+    str.clear();
+    str.width(2);
+    str.fill('0');
+    str << pmtNum;
+    //Rewrite volume name
+    volumeName.replace(pmtNamePosition, 5, str.str());
+  }
+
+  //get PMT number, which for anything but a photocathode is meaningless
+  unsigned pos = volumeName.rfind("_");
+  stringstream stream(volumeName.substr(pos + 1));
+  unsigned pmtNum = 0;
+  stream >> pmtNum;
+  if ( pmtNum >= 1 && pmtNum <= 122 ) {
+    cathode.pmtIndex = pmtNum - 1;
+    cathode.qeScale = QEvals[pmtNum-1] / (doublePheProb[pmtNum-1]+1.);
+  }
+  else {
+    //no calibration for this PMT, so the QE is left at the nominal curve
+    //(the scale cancels QE_AVG) instead of borrowing another PMT's numbers
+    cathode.pmtIndex = -1;
+    cathode.qeScale = QE_AVG;
+    if ( cathode.isPhotoCathode && !cathode.isWaterPMT &&
+         !warnedUncalibrated ) {
+      G4cout<<G4endl<<G4endl<<G4endl;
+      G4cout<<"WARNING: photocathode "<<volume->GetName()<<" has no PMT "
+            <<"number between 1 and 122,"<<G4endl;
+      G4cout<<"so it has no QE or double-phe calibration. It and any others "
+            <<"like it use the nominal QE."<<G4endl;
+      G4cout<<G4endl<<G4endl<<G4endl;
+      warnedUncalibrated = true;
+    }
+  }
+
+  return cathode;
+}
+
 // GetMeanLifeTime
 // ---------------
 G4double LUXSimQuantumEfficiency::GetMeanLifeTime(const G4Track&,
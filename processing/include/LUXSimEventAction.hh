@@ -8,6 +8,8 @@
 *	13-Mar-2009 - Initial submission (Kareem)
 *	23-Oct-2012 - Added a hook for recording the global time of the primary
 *				  particle (Kareem)
+*	19-Oct-2026 - Added step, track and photon counters and the timing
+*				  variables for the throughput report
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -15,6 +17,12 @@
 #ifndef LUXSimEventAction_HH
 #define LUXSimEventAction_HH 1
 
+//
+//	C/C++ includes
+//
+#include <fstream>
+#include <sys/time.h>
+
 //
 //	GEANT4 includes
 //
@@ -25,6 +33,8 @@
 //	Class forwarding
 //
 class G4Event;
+class G4Track;
+class G4ParticleDefinition;
 class LUXSimManager;
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -48,11 +58,28 @@ class LUXSimEventAction : public G4UserEventAction
 				{ radioactivePrimaryTime = val; };
 		inline G4double GetRadioactivePrimaryTime()
 				{ return radioactivePrimaryTime; };
+		
+		void AddStep( const G4Track* );
 			
+	private:
+		void PrintProgress();
+		G4double GetResidentMemory();
+		
 	private:
 		time_t simStartTime, simEndTime;
 		G4int eventNum;
 		G4double radioactivePrimaryTime;
+		
+		//	Throughput counters, reset at every progress report
+		G4double numSteps, numTracks, numOptPhot, numThermElec;
+		G4int numEventsSinceReport;
+		G4double bytesAtLastReport;
+		struct timeval runStartTime, lastReportTime;
+		
+		G4ParticleDefinition *opticalPhotonDef;
+		G4ParticleDefinition *thermalElectronDef;
+		
+		std::ofstream progressLog;
 	
 		LUXSimManager *luxManager;
 };
@@ -0,0 +1,58 @@
+////////////////////////////////////////////////////////////////////////////////
+/*	LUXSimOpticalTrackInformation.hh
+*
+* This is the header file for the information LUXSim attaches to an optical
+* photon track. At the moment that is only the statistical weight the photon
+* picked up from the Russian roulette in the stepping action: a photon that
+* survives a roulette with probability p stands for 1/p photons from then on.
+*
+* The weight isn't kept in the G4Track weight, because the S2 code uses the
+* thermal electron weights as flags, and the photons inherit them.
+*
+* Only photons that have survived a roulette carry this information, so a track
+* without it has a weight of 1.
+*
+********************************************************************************
+* Change log
+*	19-Oct-26 - Initial submission
+*
+*/
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LUXSimOpticalTrackInformation_HH
+#define LUXSimOpticalTrackInformation_HH 1
+
+//
+//	GEANT4 includes
+//
+#include "G4VUserTrackInformation.hh"
+#include "G4Track.hh"
+#include "globals.hh"
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+class LUXSimOpticalTrackInformation : public G4VUserTrackInformation
+{
+	public:
+		LUXSimOpticalTrackInformation() { weight = 1; };
+		~LUXSimOpticalTrackInformation() {};
+
+	public:
+		G4double GetWeight() const { return weight; };
+		void SetWeight( G4double w ) { weight = w; };
+
+		void Print() const
+				{ G4cout << "Optical photon weight " << weight << G4endl; };
+
+		//	The weight of any track, 1 if it has no LUXSim information
+		static G4double GetTrackWeight( const G4Track *track ) {
+			const LUXSimOpticalTrackInformation *info =
+					dynamic_cast<const LUXSimOpticalTrackInformation*>(
+					track->GetUserInformation() );
+			return( info ? info->GetWeight() : 1. );
+		};
+
+	private:
+		G4double weight;
+};
+
+#endif
@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+/*	LUXSimProfiler.hh
+*
+* This is the header file for the optional run profiler. When profiling is
+* turned on with /LUXSim/io/profile, the stepping, stacking and event actions
+* report to this class, which accumulates step counts, track counts, secondary
+* counts and CPU time broken down by volume, particle species and step-limiting
+* process. The time spent generating and stacking the primaries of each event
+* is kept apart from the steps. At the end of each run a sorted table is
+* printed to the screen and the full breakdown is written to a tab-separated
+* file in the output directory.
+*
+********************************************************************************
+* Change log
+*	19-Oct-26 - Initial submission
+*	19-Oct-26 - Added EndOfPrimaryGeneration(), and the primary generation
+*				time
+*
+*/
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LUXSimProfiler_HH
+#define LUXSimProfiler_HH 1
+
+//
+//	C/C++ includes
+//
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <vector>
+
+//
+//	GEANT4 includes
+//
+#include "globals.hh"
+
+//
+//	Class forwarding
+//
+class G4Step;
+class G4Track;
+class G4VPhysicalVolume;
+class G4ParticleDefinition;
+class G4VProcess;
+class LUXSimManager;
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+class LUXSimProfiler
+{
+	public:
+		LUXSimProfiler();
+		~LUXSimProfiler();
+
+	public:
+		void BeginOfRun();
+		void EndOfRun( G4int );
+		void BeginOfEvent();
+		void EndOfPrimaryGeneration();
+		void EndOfEvent();
+
+		void AddStep( const G4Step* );
+		void AddSecondary( const G4Track* );
+
+		struct profileEntry {
+			G4String name;
+			long steps;
+			long tracks;
+			long secondaries;
+			G4double cpuTime;	//	seconds
+
+			profileEntry() : steps(0), tracks(0), secondaries(0),
+					cpuTime(0.) {};
+		};
+
+	private:
+		void PrintTable( G4String, std::vector<profileEntry>& );
+		void WriteTable( std::ofstream&, G4String,
+				std::vector<profileEntry>& );
+
+		template <class T> std::vector<profileEntry> Sorted(
+				std::map<const T*, profileEntry>& );
+
+	private:
+		LUXSimManager *luxManager;
+
+		std::map<const G4VPhysicalVolume*, profileEntry> volumeProfile;
+		std::map<const G4ParticleDefinition*, profileEntry> particleProfile;
+		std::map<const G4VProcess*, profileEntry> processProfile;
+
+		clock_t lastClock;
+		clock_t eventStartClock;
+		clock_t runStartClock;
+
+		G4int numEvents;
+		long totalSteps;
+		long totalTracks;
+		long totalSecondaries;
+		G4double trackingTime;
+		G4double generationTime;
+		G4double eventTime;
+};
+
+#endif
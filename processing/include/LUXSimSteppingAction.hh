@@ -8,6 +8,10 @@
 *	13 March 2009 - Initial submission (Kareem)
 *	14-Sep-09 - Added support for recording optical photons (Kareem)
 *	31-Jan-11 - Added support for obtaining the record level in a step (Kareem)
+*	19-Oct-26 - Added the optical photon policies and the reflection count
+*	19-Oct-26 - Added the optical path of the current photon
+*	19-Oct-26 - The optical photon methods take a NULL component outside the
+*				detector components
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -32,6 +36,7 @@
 class G4UserEventAction;
 class G4Track;
 class G4Material;
+class G4OpBoundaryProcess;
 
 class LUXSimEventAction;
 class LUXSimDetectorComponent;
@@ -45,6 +50,12 @@ class LUXSimSteppingAction : public G4UserSteppingAction
 
 		void UserSteppingAction( const G4Step *theStep );
 
+	private:
+		//	The component is NULL if the photon isn't in a detector component
+		void ApplyOptPhotPolicy( const G4Step*, LUXSimDetectorComponent* );
+		G4bool IsOptPhotReflection( const G4Step* );
+		void RecordOptPhotPath( const G4Step*, LUXSimDetectorComponent* );
+
                 //      Primary particle information
                 LUXSimManager::primaryParticleInfo primaryParticles;
 
@@ -64,6 +75,12 @@ class LUXSimSteppingAction : public G4UserSteppingAction
 		LUXSimManager::stepRecord aStepRecord;
 		
 		G4Material *blackiumMat;
+
+		//	The tracks are stepped one at a time, so the reflections of the
+		//	current optical photon can be counted here
+		G4OpBoundaryProcess *boundaryProcess;
+		G4int optPhotBounces;
+		LUXSimManager::opticalPathRecord opticalPath;
   
                 std::map<G4int,bool> radIsoMap;
                 std::map<G4int,bool>::iterator itMap;
@@ -11,6 +11,23 @@
 *   24-Mar-12 - Added support for the event progress report UI hooks (Mike)
 *	23-Oct-12 - Added initialization for the global time of the primary particle
 *				if it's a radioactive nucleus (Kareem)
+*	19-Oct-26 - Event timing is reported to the run profiler when it's turned
+*				on
+*	19-Oct-26 - The progress report now includes event, step and track rates,
+*				optical photons and thermal electrons per event, output rate,
+*				resident memory and an ETA. The same numbers can be logged as
+*				JSON lines with /LUXSim/io/progressLog
+*	19-Oct-26 - The light map builder writes its line at the end of each event
+*				while it's running
+*	19-Oct-26 - The step, track, optical photon and thermal electron rates are
+*				only reported with the progress log, since counting them costs
+*				a call on every step. The log is appended to rather than
+*				overwritten, and each line has the run number.
+*	19-Oct-26 - The profiler's event timer is now started by the primary
+*				generator action, so primary generation counts as event overhead
+*	19-Oct-26 - The steps and tracks are counted again whatever the progress
+*				log setting, since the screen report always has their rates.
+*				The progress log only decides whether they go to the file.
 *
 */
 /////////////////////////////////////////////////////////////////////////////////
@@ -19,20 +36,30 @@
 //	C/C++ includes
 //
 #include <ctime>
+#include <cstdio>
+#include <unistd.h>
 
 //
 //	GEANT4 includes
 //
 #include "G4Event.hh"
+#include "G4Run.hh"
+#include "G4RunManager.hh"
 #include "G4TrajectoryContainer.hh"
 #include "G4Trajectory.hh"
 #include "G4VVisManager.hh"
+#include "G4Track.hh"
+#include "G4OpticalPhoton.hh"
 
 //
 //	LUXSim includes
 //
 #include "LUXSimEventAction.hh"
 #include "LUXSimManager.hh"
+#include "LUXSimProfiler.hh"
+#include "LUXSimOutput.hh"
+#include "LUXSimLightMap.hh"
+#include "G4ThermalElectron.hh"
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //					LUXSimEventAction()
@@ -42,13 +69,39 @@ LUXSimEventAction::LUXSimEventAction()
 {
 	luxManager = LUXSimManager::GetManager();
 	luxManager->Register( this );
+	
+	numSteps = numTracks = numOptPhot = numThermElec = 0;
+	numEventsSinceReport = 0;
+	bytesAtLastReport = 0;
+	opticalPhotonDef = NULL;
+	thermalElectronDef = NULL;
 }
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //					~LUXSimEventAction()
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 LUXSimEventAction::~LUXSimEventAction()
-{}
+{
+	if( progressLog.is_open() )
+		progressLog.close();
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					AddStep()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimEventAction::AddStep( const G4Track *aTrack )
+{
+	//	Called from the stepping action for every step, so this is kept to a
+	//	couple of comparisons
+	numSteps++;
+	if( aTrack->GetCurrentStepNumber() == 1 ) {
+		numTracks++;
+		if( aTrack->GetDefinition() == opticalPhotonDef )
+			numOptPhot++;
+		else if( aTrack->GetDefinition() == thermalElectronDef )
+			numThermElec++;
+	}
+}
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //					BeginOfEventAction()
@@ -59,6 +112,24 @@ void LUXSimEventAction::BeginOfEventAction(const G4Event* evt )
 	if( !eventNum ) {
 		luxManager->SetRunEndedCleanly( false );
 		time( &simStartTime );
+		
+		gettimeofday( &runStartTime, NULL );
+		lastReportTime = runStartTime;
+		numSteps = numTracks = numOptPhot = numThermElec = 0;
+		numEventsSinceReport = 0;
+		bytesAtLastReport = 0;
+		opticalPhotonDef = G4OpticalPhoton::OpticalPhotonDefinition();
+		thermalElectronDef = G4ThermalElectron::ThermalElectronDefinition();
+		
+		if( progressLog.is_open() )
+			progressLog.close();
+		if( luxManager->GetProgressLog() ) {
+			G4String logName = luxManager->GetOutputBaseName() +
+					"_progress.jsonl";
+			progressLog.open( logName.c_str(), std::ios::app );
+			if( !progressLog.is_open() )
+				G4cout << "Could not open progress log " << logName << G4endl;
+		}
 	}
 	
 	radioactivePrimaryTime = 0;
@@ -74,18 +145,27 @@ void LUXSimEventAction::EndOfEventAction( const G4Event* evt )
 	if( eventNum == (luxManager->GetNumEvents() - 1) )
 		luxManager->SetRunEndedCleanly( true );
 
-	// Print out periodic progress reports
+	// Print out periodic progress reports. The last event always goes to the
+	// progress log so that the log covers the whole run.
+	numEventsSinceReport++;
 	if( eventNum% (luxManager->GetEventProgressFreqnecy()) == 0 ) {
 		time( &simEndTime );
 		G4cout << "\n\tProcessing event " << eventNum << " at "
 			   << difftime( simEndTime, simStartTime ) << " seconds.";
+		PrintProgress();
 		G4cout.flush();
+	} else if( eventNum == (luxManager->GetNumEvents() - 1) &&
+			progressLog.is_open() ) {
+		PrintProgress();
 	} else if( luxManager->GetEventProgressFreqnecy() >= 10 &&
                 eventNum % (luxManager->GetEventProgressFreqnecy()/10) == 0 ) {
 		G4cout << ".";
         G4cout.flush();
 	}
 	
+	if( luxManager->GetLightMap() && luxManager->GetLightMap()->IsBuilding() )
+		luxManager->GetLightMap()->EndOfEvent();
+	
 	if( !luxManager->GetG4DecayBool() ){
 	  luxManager->RecordValues( eventNum );
 	  luxManager->ClearRecords();
@@ -105,4 +185,97 @@ void LUXSimEventAction::EndOfEventAction( const G4Event* evt )
 			trj->DrawTrajectory( 0 );
 		}
 	}
+	
+	if( eventNum == (luxManager->GetNumEvents() - 1) && progressLog.is_open() )
+		progressLog.close();
+	
+	if( luxManager->GetProfiling() )
+		luxManager->GetProfiler()->EndOfEvent();
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					PrintProgress()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimEventAction::PrintProgress()
+{
+	//	Rates are over the interval since the last report, so that slowdowns
+	//	show up right away. The ETA uses the average rate over the whole run.
+	struct timeval now;
+	gettimeofday( &now, NULL );
+	G4double elapsed = (now.tv_sec - runStartTime.tv_sec) +
+			1.e-6*(now.tv_usec - runStartTime.tv_usec);
+	G4double interval = (now.tv_sec - lastReportTime.tv_sec) +
+			1.e-6*(now.tv_usec - lastReportTime.tv_usec);
+	if( interval <= 0 ) interval = 1.e-6;
+
+	G4double bytesWritten = 0;
+	if( luxManager->GetOutput() )
+		bytesWritten = luxManager->GetOutput()->GetBytesWritten();
+
+	G4double eventRate = numEventsSinceReport / interval;
+	G4double stepRate = numSteps / interval;
+	G4double trackRate = numTracks / interval;
+	G4double optPhotPerEvent = 0, thermElecPerEvent = 0;
+	if( numEventsSinceReport ) {
+		optPhotPerEvent = numOptPhot / numEventsSinceReport;
+		thermElecPerEvent = numThermElec / numEventsSinceReport;
+	}
+	G4double byteRate = (bytesWritten - bytesAtLastReport) / interval;
+	G4double residentMemory = GetResidentMemory();
+	G4double eta = -1;
+	if( elapsed > 0 && eventNum >= 0 )
+		eta = (luxManager->GetNumEvents() - eventNum - 1) *
+				elapsed / (eventNum + 1);
+
+	if( eventNum% (luxManager->GetEventProgressFreqnecy()) == 0 ) {
+		G4cout << "\n\t\t" << eventRate << " events/s, "
+			   << stepRate << " steps/s, " << trackRate << " tracks/s, "
+			   << optPhotPerEvent << " optical photons/event, "
+			   << thermElecPerEvent << " thermal electrons/event, ";
+		G4cout << byteRate/1024. << " kB/s output, ";
+		if( residentMemory >= 0 )
+			G4cout << residentMemory << " MB resident, ";
+		G4cout << "ETA " << eta << " seconds.";
+	}
+
+	if( progressLog.is_open() ) {
+		progressLog << "{\"run\": "
+					<< G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID()
+					<< ", \"event\": " << eventNum
+					<< ", \"elapsed_s\": " << elapsed
+					<< ", \"events_per_s\": " << eventRate
+					<< ", \"steps_per_s\": " << stepRate
+					<< ", \"tracks_per_s\": " << trackRate
+					<< ", \"optical_photons_per_event\": " << optPhotPerEvent
+					<< ", \"thermal_electrons_per_event\": "
+					<< thermElecPerEvent
+					<< ", \"output_bytes\": " << bytesWritten
+					<< ", \"output_bytes_per_s\": " << byteRate
+					<< ", \"rss_mb\": " << residentMemory
+					<< ", \"eta_s\": " << eta << "}\n";
+		progressLog.flush();
+	}
+
+	lastReportTime = now;
+	bytesAtLastReport = bytesWritten;
+	numSteps = numTracks = numOptPhot = numThermElec = 0;
+	numEventsSinceReport = 0;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					GetResidentMemory()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4double LUXSimEventAction::GetResidentMemory()
+{
+	//	Resident set size in MB from /proc. Returns -1 where /proc isn't
+	//	available (e.g., OS X).
+	FILE *statm = fopen( "/proc/self/statm", "r" );
+	if( !statm )
+		return -1;
+	long totalPages = 0, residentPages = 0;
+	G4int numRead = fscanf( statm, "%ld %ld", &totalPages, &residentPages );
+	fclose( statm );
+	if( numRead != 2 )
+		return -1;
+	return (G4double)residentPages * sysconf( _SC_PAGESIZE ) / (1024.*1024.);
 }
@@ -0,0 +1,338 @@
+////////////////////////////////////////////////////////////////////////////////
+/*	LUXSimProfiler.cc
+*
+* This is the code file for the optional run profiler. CPU time is measured
+* with clock() and charged to a step in the interval between successive calls
+* to AddStep(), so each step carries the cost of its own transport and
+* physics. The event is timed from the start of primary generation. The time
+* up to the end of generation, and the time to stack each primary, is booked as
+* primary generation, so that the first step of an event isn't charged for it.
+* Any other time spent in an event outside of tracking (e.g., output) is
+* reported separately as event overhead.
+*
+********************************************************************************
+* Change log
+*	19-Oct-26 - Initial submission
+*	19-Oct-26 - Primary generation and stacking are timed on their own rather
+*				than charged to the first step of the event
+*
+*/
+////////////////////////////////////////////////////////////////////////////////
+
+//
+//	C/C++ includes
+//
+#include <iomanip>
+#include <algorithm>
+
+//
+//	GEANT4 includes
+//
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4VProcess.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4ParticleDefinition.hh"
+
+//
+//	LUXSim includes
+//
+#include "LUXSimProfiler.hh"
+#include "LUXSimManager.hh"
+
+//
+//	Definitions
+//
+#define TABLE_ROWS 20
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					Name helpers and sorting
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+static G4String ProfileName( const G4VPhysicalVolume *vol )
+{
+	if( vol ) return vol->GetName();
+	return "unknown";
+}
+
+static G4String ProfileName( const G4ParticleDefinition *par )
+{
+	if( par ) return par->GetParticleName();
+	return "unknown";
+}
+
+static G4String ProfileName( const G4VProcess *proc )
+{
+	if( proc ) return proc->GetProcessName();
+	return "primary";
+}
+
+static bool ByCPUTime( const LUXSimProfiler::profileEntry &a,
+		const LUXSimProfiler::profileEntry &b )
+{
+	if( a.cpuTime != b.cpuTime ) return a.cpuTime > b.cpuTime;
+	return a.steps > b.steps;
+}
+
+static G4double ClockToSeconds( clock_t ticks )
+{
+	return (G4double)ticks / CLOCKS_PER_SEC;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					LUXSimProfiler()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+LUXSimProfiler::LUXSimProfiler()
+{
+	luxManager = LUXSimManager::GetManager();
+	luxManager->Register( this );
+
+	BeginOfRun();
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					~LUXSimProfiler()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+LUXSimProfiler::~LUXSimProfiler() {}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					BeginOfRun()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimProfiler::BeginOfRun()
+{
+	//	The volume, particle and process pointers are only guaranteed to be
+	//	valid for the duration of a run, so everything is cleared here.
+	volumeProfile.clear();
+	particleProfile.clear();
+	processProfile.clear();
+
+	numEvents = 0;
+	totalSteps = 0;
+	totalTracks = 0;
+	totalSecondaries = 0;
+	trackingTime = 0.;
+	generationTime = 0.;
+	eventTime = 0.;
+
+	runStartClock = clock();
+	eventStartClock = runStartClock;
+	lastClock = runStartClock;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					BeginOfEvent()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimProfiler::BeginOfEvent()
+{
+	//	Called at the start of GeneratePrimaries
+	eventStartClock = clock();
+	lastClock = eventStartClock;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					EndOfPrimaryGeneration()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimProfiler::EndOfPrimaryGeneration()
+{
+	clock_t now = clock();
+	generationTime += ClockToSeconds( now - lastClock );
+	lastClock = now;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					EndOfEvent()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimProfiler::EndOfEvent()
+{
+	eventTime += ClockToSeconds( clock() - eventStartClock );
+	numEvents++;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					AddStep()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimProfiler::AddStep( const G4Step *theStep )
+{
+	clock_t now = clock();
+	G4double dt = ClockToSeconds( now - lastClock );
+	lastClock = now;
+
+	G4Track *theTrack = theStep->GetTrack();
+	G4bool firstStep = ( theTrack->GetCurrentStepNumber() == 1 );
+
+	profileEntry &volEntry = volumeProfile[ theStep->GetPreStepPoint()->
+			GetPhysicalVolume() ];
+	profileEntry &parEntry = particleProfile[ theTrack->GetDefinition() ];
+	profileEntry &procEntry = processProfile[ theStep->GetPostStepPoint()->
+			GetProcessDefinedStep() ];
+
+	volEntry.steps++;
+	volEntry.cpuTime += dt;
+	parEntry.steps++;
+	parEntry.cpuTime += dt;
+	procEntry.steps++;
+	procEntry.cpuTime += dt;
+
+	//	Tracks are counted against the volume they start in, their species,
+	//	and the process that created them (which is not the same entry as the
+	//	step-limiting process, but it shares the process table).
+	if( firstStep ) {
+		volEntry.tracks++;
+		parEntry.tracks++;
+		processProfile[ theTrack->GetCreatorProcess() ].tracks++;
+		totalTracks++;
+	}
+
+	totalSteps++;
+	trackingTime += dt;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					AddSecondary()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimProfiler::AddSecondary( const G4Track *aTrack )
+{
+	//	Primaries come through the stacking action as well, but they are
+	//	already accounted for as tracks. They're stacked before the first
+	//	step, so the time up to here belongs to primary generation.
+	if( !aTrack->GetParentID() ) {
+		EndOfPrimaryGeneration();
+		return;
+	}
+
+	volumeProfile[ aTrack->GetVolume() ].secondaries++;
+	particleProfile[ aTrack->GetDefinition() ].secondaries++;
+	processProfile[ aTrack->GetCreatorProcess() ].secondaries++;
+	totalSecondaries++;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					Sorted()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+template <class T>
+std::vector<LUXSimProfiler::profileEntry> LUXSimProfiler::Sorted(
+		std::map<const T*, profileEntry> &profile )
+{
+	//	Different volumes can share a name (e.g., the PMTs), so entries are
+	//	merged by name before sorting.
+	std::map<G4String, profileEntry> byName;
+	typename std::map<const T*, profileEntry>::iterator it;
+	for( it=profile.begin(); it!=profile.end(); it++ ) {
+		G4String name = ProfileName( it->first );
+		profileEntry &entry = byName[name];
+		entry.name = name;
+		entry.steps += it->second.steps;
+		entry.tracks += it->second.tracks;
+		entry.secondaries += it->second.secondaries;
+		entry.cpuTime += it->second.cpuTime;
+	}
+
+	std::vector<profileEntry> sorted;
+	std::map<G4String, profileEntry>::iterator nameIt;
+	for( nameIt=byName.begin(); nameIt!=byName.end(); nameIt++ )
+		sorted.push_back( nameIt->second );
+	std::sort( sorted.begin(), sorted.end(), ByCPUTime );
+
+	return sorted;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					PrintTable()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimProfiler::PrintTable( G4String title,
+		std::vector<profileEntry> &table )
+{
+	G4cout << G4endl << "\t" << title << G4endl;
+	G4cout << "\t" << std::setw(28) << std::left << "name" << std::right
+		   << std::setw(14) << "steps" << std::setw(12) << "tracks"
+		   << std::setw(14) << "secondaries" << std::setw(12) << "CPU (s)"
+		   << std::setw(9) << "CPU %" << G4endl;
+
+	G4int numRows = (G4int)table.size();
+	if( numRows > TABLE_ROWS ) numRows = TABLE_ROWS;
+	for( G4int i=0; i<numRows; i++ ) {
+		G4double fraction = 0.;
+		if( trackingTime > 0. )
+			fraction = 100.*table[i].cpuTime / trackingTime;
+		G4cout << "\t" << std::setw(28) << std::left
+			   << table[i].name.substr(0,27) << std::right
+			   << std::setw(14) << table[i].steps
+			   << std::setw(12) << table[i].tracks
+			   << std::setw(14) << table[i].secondaries
+			   << std::setw(12) << std::fixed << std::setprecision(3)
+			   << table[i].cpuTime
+			   << std::setw(9) << std::setprecision(1) << fraction
+			   << G4endl;
+		G4cout.unsetf( std::ios::fixed );
+		G4cout << std::setprecision(6);
+	}
+	if( (G4int)table.size() > numRows )
+		G4cout << "\t(" << table.size() - numRows << " more entries in the "
+			   << "profile file)" << G4endl;
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					WriteTable()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimProfiler::WriteTable( std::ofstream &file, G4String category,
+		std::vector<profileEntry> &table )
+{
+	for( G4int i=0; i<(G4int)table.size(); i++ )
+		file << category << "\t" << table[i].name << "\t" << table[i].steps
+			 << "\t" << table[i].tracks << "\t" << table[i].secondaries
+			 << "\t" << table[i].cpuTime << "\n";
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//					EndOfRun()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimProfiler::EndOfRun( G4int runID )
+{
+	G4double runTime = ClockToSeconds( clock() - runStartClock );
+	G4double overheadTime = eventTime - trackingTime - generationTime;
+	if( overheadTime < 0. ) overheadTime = 0.;
+
+	std::vector<profileEntry> volumes = Sorted( volumeProfile );
+	std::vector<profileEntry> particles = Sorted( particleProfile );
+	std::vector<profileEntry> processes = Sorted( processProfile );
+
+	//	Screen summary
+	G4cout << G4endl << "Profile for run " << runID << ": " << numEvents
+		   << " events, " << totalSteps << " steps, " << totalTracks
+		   << " tracks, " << totalSecondaries << " secondaries" << G4endl;
+	G4cout << "\tCPU time in run:      " << runTime << " s" << G4endl;
+	G4cout << "\tCPU time in tracking: " << trackingTime << " s" << G4endl;
+	G4cout << "\tCPU time in primary generation: " << generationTime << " s"
+		   << G4endl;
+	G4cout << "\tCPU time in events outside of tracking: " << overheadTime
+		   << " s" << G4endl;
+	if( numEvents )
+		G4cout << "\tCPU time per event:   " << eventTime/numEvents << " s"
+			   << G4endl;
+
+	PrintTable( "By volume", volumes );
+	PrintTable( "By particle", particles );
+	PrintTable( "By process (steps and CPU by step-limiting process, tracks "
+			"and secondaries by creator process)", processes );
+
+	//	Machine-readable file, named to match the binary output of this run
+	G4String fileName = luxManager->GetOutputBaseName() + "_profile.txt";
+	std::ofstream profileFile( fileName.c_str() );
+	if( !profileFile.is_open() ) {
+		G4cout << "Could not open profile file " << fileName << G4endl;
+		return;
+	}
+
+	profileFile << "# run\t" << runID << "\n";
+	profileFile << "# events\t" << numEvents << "\n";
+	profileFile << "# cpu_run_s\t" << runTime << "\n";
+	profileFile << "# cpu_tracking_s\t" << trackingTime << "\n";
+	profileFile << "# cpu_generation_s\t" << generationTime << "\n";
+	profileFile << "# cpu_event_overhead_s\t" << overheadTime << "\n";
+	profileFile << "category\tname\tsteps\ttracks\tsecondaries\tcpu_s\n";
+	WriteTable( profileFile, "volume", volumes );
+	WriteTable( profileFile, "particle", particles );
+	WriteTable( profileFile, "process", processes );
+	profileFile.close();
+
+	G4cout << G4endl << "Profile saved to " << fileName << G4endl;
+}
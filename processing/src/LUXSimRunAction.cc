@@ -6,6 +6,8 @@
 ********************************************************************************
 * Change log
 *	13 March 2009 - Initial submission (Kareem)
+*	19-Oct-26 - Starts and reports the run profiler when it's turned on
+*	19-Oct-26 - Clears the generators' copy of the last nucleus limits
 *
 */
 ////////////////////////////////////////////////////////////////////////////////
@@ -20,6 +22,8 @@
 //
 #include "LUXSimRunAction.hh"
 #include "LUXSimManager.hh"
+#include "LUXSimProfiler.hh"
+#include "LUXSimSource.hh"
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
 //					LUXSimRunAction()
@@ -45,6 +49,11 @@ void LUXSimRunAction::BeginOfRunAction( const G4Run* aRun )
 	time( &startTime );
 	luxManager->InitialiseEventCount();
 	
+	//	A macro may have set /grdm/nucleusLimits since the last run
+	LUXSimSource::ResetNucleusLimits();
+	
+	if( luxManager->GetProfiling() )
+		luxManager->GetProfiler()->BeginOfRun();
 }
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -58,5 +67,8 @@ void LUXSimRunAction::EndOfRunAction( const G4Run* aRun )
 	G4double timeDifference = difftime( endTime, startTime );
 	G4cout << G4endl << "Run " << aRun->GetRunID() << " time to completion: "
 		   << timeDifference << " seconds" << G4endl;
+	
+	if( luxManager->GetProfiling() )
+		luxManager->GetProfiler()->EndOfRun( aRun->GetRunID() );
 
 }
@@ -8,6 +8,8 @@
 ********************************************************************************
 * Change log
 *   06-Oct-2015 - Initial submission (David W)
+*   19-Oct-2026 - Secondaries are reported to the run profiler when it's
+*                 turned on
 */
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -21,6 +23,7 @@
 //LUXSim includes
 //
 #include "LUXSimStackingAction.hh"
+#include "LUXSimProfiler.hh"
 
 
 
@@ -47,6 +50,9 @@ G4ClassificationOfNewTrack LUXSimStackingAction::ClassifyNewTrack( const G4Track
   
   G4ClassificationOfNewTrack result( fUrgent );  
   
+  if( luxManager->GetProfiling() )
+    luxManager->GetProfiler()->AddSecondary( aTrack );
+  
   if(luxManager->GetG4DecayBool()){
     lastTime = aTrack->GetGlobalTime();
     std::map<G4int,bool> radIsoMap = luxManager->GetRadioIsotopeMap();
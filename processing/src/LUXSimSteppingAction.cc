@@ -37,6 +37,31 @@
 *                 liquid xenon is greater than the upper limit set in the
 *                 /LUXSim/io/upperEnergyHack command (Kareem)
 *   06-Oct-2015 - Changes to accommodate the G4Decay generator (David W).
+*   19-Oct-2026 - Steps are reported to the run profiler when it's turned on
+*   19-Oct-2026 - Steps are counted for the throughput report
+*   19-Oct-2026 - Steps in a parameterised volume (e.g., parameterised grid
+*                 wires) are recorded against the enclosing component
+*   19-Oct-2026 - Added the optical photon policies: photons can be killed
+*                 on entering a volume, after a number of reflections or
+*                 after a path length, or put through Russian roulette
+*   19-Oct-2026 - The optical path of each photon is added up, and written
+*                 to the optical path file when the photon reaches a
+*                 photocathode, if /LUXSim/io/opticalPaths is on
+*   19-Oct-2026 - The Rayleigh scatters of an optical fast path step are
+*                 added to the optical path
+*   19-Oct-2026 - Steps are only counted for the progress report when the
+*                 progress log is on
+*   19-Oct-2026 - The detector component of an optical photon step is found
+*                 once with a dynamic_cast, and the policy is used by
+*                 reference, instead of scanning the component list for the
+*                 policy and again for the optical path record
+*   19-Oct-2026 - A roulette threshold of 0 bounces plays the roulette from
+*                 the first reflection
+*   19-Oct-2026 - On a reflection, the optical photon policy is that of the
+*                 volume the photon stays in, and a kill volume only kills
+*                 photons that actually enter it
+*   19-Oct-2026 - Steps are counted for the progress report again, whether
+*                 or not the progress log is on
 */
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -48,6 +73,16 @@
 #include "G4VProcess.hh"
 #include "G4EventManager.hh"
 #include "G4StackManager.hh"
+#include "G4OpticalPhoton.hh"
+#include "G4OpBoundaryProcess.hh"
+#include "G4ProcessManager.hh"
+#include "G4SteppingManager.hh"
+#include "G4Event.hh"
+#include "G4LogicalBorderSurface.hh"
+#include "G4LogicalSkinSurface.hh"
+#include "G4LogicalVolume.hh"
+#include "G4SurfaceProperty.hh"
+#include "Randomize.hh"
 
 //
 //	LUXSim includes
@@ -57,6 +92,10 @@
 #include "LUXSimDetectorComponent.hh"
 #include "LUXSimMaterials.hh"
 #include "LUXSimEventAction.hh"
+#include "LUXSimProfiler.hh"
+#include "LUXSimOpticalTrackInformation.hh"
+#include "LUXSimOutput.hh"
+#include "LUXSimOpticalFastModel.hh"
 
 //
 //	Definitions
@@ -76,6 +115,9 @@ LUXSimSteppingAction::LUXSimSteppingAction()
 
 	optPhotRecordLevel = 0;
 	thermElecRecordLevel = 0;
+
+	boundaryProcess = 0;
+	optPhotBounces = 0;
 }
 
 //------++++++------++++++------++++++------++++++------++++++------++++++------
@@ -91,18 +133,41 @@ void LUXSimSteppingAction::UserSteppingAction( const G4Step* theStep )
 	//	Initialize step specifics
 	theTrack = theStep->GetTrack();
     
+    luxManager->GetEvent()->AddStep( theTrack );
+    if( luxManager->GetProfiling() )
+        luxManager->GetProfiler()->AddStep( theStep );
+    
     if( luxManager->Get100keVHack() &&
            luxManager->GetLiquidXenonEnergy() > luxManager->Get100keVHack() )
         theTrack->SetTrackStatus( fStopAndKill );
     else {
         trackPosition = theStep->GetPostStepPoint()->GetPosition();
         particleDirection = theStep->GetPreStepPoint()->GetMomentumDirection();
-        recordLevel = luxManager->GetComponentRecordLevel(
-                (LUXSimDetectorComponent*)theTrack->GetVolume() );
-        optPhotRecordLevel = luxManager->GetComponentRecordLevelOptPhot(
-                (LUXSimDetectorComponent*)theTrack->GetVolume() );
-        thermElecRecordLevel = luxManager->GetComponentRecordLevelThermElec(
-                            (LUXSimDetectorComponent*)theTrack->GetVolume() );
+
+        //  Parameterised volumes aren't detector components, so anything in
+        //  them goes to the volume that holds them. LUXSimManager::BeamOn
+        //  won't let that volume be recorded, since the wire would be lost.
+        LUXSimDetectorComponent *theComponent =
+                (LUXSimDetectorComponent*)theTrack->GetVolume();
+        if( theTrack->GetVolume() && theTrack->GetVolume()->IsParameterised() )
+            theComponent = (LUXSimDetectorComponent*)
+                    theTrack->GetTouchable()->GetVolume(1);
+
+        recordLevel = luxManager->GetComponentRecordLevel( theComponent );
+        optPhotRecordLevel =
+                luxManager->GetComponentRecordLevelOptPhot( theComponent );
+        thermElecRecordLevel =
+                luxManager->GetComponentRecordLevelThermElec( theComponent );
+        
+        //  Only detector components have an optical photon policy and an ID.
+        //  The dynamic_cast tells them apart without another scan of the
+        //  component list, which matters because optical photons take most of
+        //  the steps.
+        LUXSimDetectorComponent *optPhotComponent = 0;
+        if( theTrack->GetDefinition() ==
+                G4OpticalPhoton::OpticalPhotonDefinition() )
+            optPhotComponent = dynamic_cast<LUXSimDetectorComponent*>(
+                    (G4VPhysicalVolume*)theComponent );
         
         //	Record relevant parameters in the step record
         aStepRecord.stepNumber = theTrack->GetCurrentStepNumber();
@@ -214,29 +279,29 @@ void LUXSimSteppingAction::UserSteppingAction( const G4Step* theStep )
             aStepRecord.energyDeposition = 0;
         
             if( optPhotRecordLevel )
-                luxManager->AddDeposition(
-                        (LUXSimDetectorComponent*)theTrack->GetVolume(),
-                        aStepRecord );
+                luxManager->AddDeposition( theComponent, aStepRecord );
             
             if( optPhotRecordLevel == 1 || optPhotRecordLevel == 3 )
                 theTrack->SetTrackStatus( fStopAndKill );
 
+            if( luxManager->GetRecordOpticalPaths() )
+                RecordOptPhotPath( theStep, optPhotComponent );
+            
+            if( luxManager->GetUseOptPhotPolicies() )
+                ApplyOptPhotPolicy( theStep, optPhotComponent );
+
         } else if ( aStepRecord.particleName == "thermalelectron" ){
 
             aStepRecord.energyDeposition = 0;
 
             if( thermElecRecordLevel )
-                luxManager->AddDeposition(
-                        (LUXSimDetectorComponent*)theTrack->GetVolume(),
-                        aStepRecord );
+                luxManager->AddDeposition( theComponent, aStepRecord );
 
             if( thermElecRecordLevel == 1 || thermElecRecordLevel == 3 )
                 theTrack->SetTrackStatus( fStopAndKill );
 
         } else
-            luxManager->AddDeposition(
-                    (LUXSimDetectorComponent*)theTrack->GetVolume(),
-                    aStepRecord );
+            luxManager->AddDeposition( theComponent, aStepRecord );
         
         //	Kill the particle if the current volume is made of blackium, or if
         //	the record level is set to 4. The blackium support is kept for
@@ -267,3 +332,180 @@ void LUXSimSteppingAction::UserSteppingAction( const G4Step* theStep )
         }
     }
 }
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//				ApplyOptPhotPolicy()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimSteppingAction::ApplyOptPhotPolicy( const G4Step* theStep,
+        LUXSimDetectorComponent *theComponent )
+{
+    //  Count the reflections since the photon was made
+    if( theTrack->GetCurrentStepNumber() == 1 )
+        optPhotBounces = 0;
+    G4bool bounced = IsOptPhotReflection( theStep );
+    if( bounced )
+        optPhotBounces++;
+    
+    //  The post-step volume of a reflection is the one on the far side of the
+    //  surface, which the photon never enters. Its policy is that of the
+    //  volume it was in, and kill volumes only act on photons entering them.
+    if( bounced ) {
+        const G4StepPoint *preStepPoint = theStep->GetPreStepPoint();
+        G4VPhysicalVolume *preVolume = preStepPoint->GetPhysicalVolume();
+        if( preVolume && preVolume->IsParameterised() )
+            preVolume = preStepPoint->GetTouchable()->GetVolume(1);
+        theComponent = dynamic_cast<LUXSimDetectorComponent*>( preVolume );
+    }
+    
+    if( theTrack->GetTrackStatus() == fStopAndKill || !theComponent )
+        return;
+    
+    const LUXSimDetectorComponent::optPhotPolicy &policy =
+            theComponent->GetOptPhotPolicy();
+    
+    if( ( policy.kill && !bounced ) ||
+            ( policy.maxBounces && optPhotBounces >= policy.maxBounces ) ||
+            ( policy.maxPathLength > 0 &&
+              theTrack->GetTrackLength() > policy.maxPathLength ) ) {
+        theTrack->SetTrackStatus( fStopAndKill );
+        return;
+    }
+    
+    //  Past the roulette threshold, every reflection either kills the photon
+    //  or raises its weight, so that the mean number of photons reaching the
+    //  photocathodes doesn't change. A threshold of 0 means every reflection.
+    if( bounced && optPhotBounces > policy.rouletteBounces &&
+            policy.rouletteSurvival < 1 ) {
+        if( G4UniformRand() >= policy.rouletteSurvival ) {
+            theTrack->SetTrackStatus( fStopAndKill );
+            return;
+        }
+        
+        LUXSimOpticalTrackInformation *info =
+                dynamic_cast<LUXSimOpticalTrackInformation*>(
+                theTrack->GetUserInformation() );
+        if( !info ) {
+            info = new LUXSimOpticalTrackInformation();
+            theTrack->SetUserInformation( info );
+        }
+        info->SetWeight( info->GetWeight() / policy.rouletteSurvival );
+    }
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//				IsOptPhotReflection()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+G4bool LUXSimSteppingAction::IsOptPhotReflection( const G4Step* theStep )
+{
+    //  The boundary process can't be found in the constructor, because the
+    //  physics list doesn't exist yet
+    if( !boundaryProcess ) {
+        G4ProcessVector *processes = G4OpticalPhoton::OpticalPhoton()->
+                GetProcessManager()->GetProcessList();
+        for( G4int i=0; i<(G4int)processes->size(); i++ )
+            if( (*processes)[i]->GetProcessName() == "OpBoundary" )
+                boundaryProcess = (G4OpBoundaryProcess*)(*processes)[i];
+        if( !boundaryProcess )
+            return false;
+    }
+    
+    //  The boundary process status is only meaningful when the step ended on
+    //  a boundary
+    if( theStep->GetPostStepPoint()->GetStepStatus() != fGeomBoundary )
+        return false;
+    
+    G4OpBoundaryProcessStatus status = boundaryProcess->GetStatus();
+    return( status == FresnelReflection || status == TotalInternalReflection ||
+            status == LambertianReflection || status == LobeReflection ||
+            status == SpikeReflection || status == BackScattering );
+}
+
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+//				RecordOptPhotPath()
+//------++++++------++++++------++++++------++++++------++++++------++++++------
+void LUXSimSteppingAction::RecordOptPhotPath( const G4Step* theStep,
+        LUXSimDetectorComponent *theComponent )
+{
+    if( theTrack->GetCurrentStepNumber() == 1 ) {
+        opticalPath.materials.clear();
+        opticalPath.surfaces.clear();
+    }
+    
+    //  Path length and Rayleigh scatters, by the material the step was in
+    const G4Material *material = theStep->GetPreStepPoint()->GetMaterial();
+    G4int m = 0;
+    while( m < (G4int)opticalPath.materials.size() &&
+            opticalPath.materials[m].material != material )
+        m++;
+    if( m == (G4int)opticalPath.materials.size() ) {
+        LUXSimManager::optPathMaterial newMaterial;
+        newMaterial.material = material;
+        newMaterial.pathLength = 0;
+        newMaterial.numRayleigh = 0;
+        opticalPath.materials.push_back( newMaterial );
+    }
+    opticalPath.materials[m].pathLength += theStep->GetStepLength();
+    if( aStepRecord.stepProcess == "OpRayleigh" )
+        opticalPath.materials[m].numRayleigh++;
+    else if( aStepRecord.stepProcess == "OpFastPath" )
+        opticalPath.materials[m].numRayleigh +=
+                LUXSimOpticalFastModel::GetNumRayleigh();
+    
+    //  Reflections, by optical surface. The surface is looked up the same way
+    //  the boundary process looks it up: a border surface between the two
+    //  volumes first, then a skin surface of the volume being entered or left.
+    if( IsOptPhotReflection( theStep ) ) {
+        G4VPhysicalVolume *prePV = theStep->GetPreStepPoint()->
+                GetPhysicalVolume();
+        G4VPhysicalVolume *postPV = theStep->GetPostStepPoint()->
+                GetPhysicalVolume();
+        G4LogicalSurface *logicalSurface =
+                G4LogicalBorderSurface::GetSurface( prePV, postPV );
+        if( !logicalSurface ) {
+            G4bool enteredDaughter = ( postPV->GetMotherLogical() ==
+                    prePV->GetLogicalVolume() );
+            G4LogicalVolume *firstLV = enteredDaughter ?
+                    postPV->GetLogicalVolume() : prePV->GetLogicalVolume();
+            G4LogicalVolume *secondLV = enteredDaughter ?
+                    prePV->GetLogicalVolume() : postPV->GetLogicalVolume();
+            logicalSurface = G4LogicalSkinSurface::GetSurface( firstLV );
+            if( !logicalSurface )
+                logicalSurface = G4LogicalSkinSurface::GetSurface( secondLV );
+        }
+        
+        LUXSimManager::optPathSurface reflection;
+        reflection.surface = logicalSurface ?
+                logicalSurface->GetSurfaceProperty() : 0;
+        reflection.preMaterial = reflection.surface ? 0 : material;
+        reflection.postMaterial = reflection.surface ? 0 :
+                theStep->GetPostStepPoint()->GetMaterial();
+        
+        G4int s = 0;
+        while( s < (G4int)opticalPath.surfaces.size() &&
+                ( opticalPath.surfaces[s].surface != reflection.surface ||
+                  opticalPath.surfaces[s].preMaterial !=
+                        reflection.preMaterial ||
+                  opticalPath.surfaces[s].postMaterial !=
+                        reflection.postMaterial ) )
+            s++;
+        if( s == (G4int)opticalPath.surfaces.size() ) {
+            reflection.numReflections = 0;
+            opticalPath.surfaces.push_back( reflection );
+        }
+        opticalPath.surfaces[s].numReflections++;
+    }
+    
+    //  The photon is written out when it reaches a photocathode, whether or
+    //  not it makes a phe there. The phe are the secondaries of this step.
+    if( aStepRecord.stepProcess == "pheConv" ) {
+        opticalPath.eventNumber = G4EventManager::GetEventManager()->
+                GetConstCurrentEvent()->GetEventID();
+        opticalPath.trackID = theTrack->GetTrackID();
+        opticalPath.volumeID = theComponent ? theComponent->GetID() : 0;
+        opticalPath.numPhe = fpSteppingManager->GetfN2ndariesPostStepDoIt();
+        opticalPath.weight =
+                LUXSimOpticalTrackInformation::GetTrackWeight( theTrack );
+        opticalPath.energy = theStep->GetPreStepPoint()->GetKineticEnergy();
+        luxManager->GetOutput()->RecordOpticalPath( opticalPath );
+    }
+}
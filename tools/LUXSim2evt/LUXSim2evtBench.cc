@@ -0,0 +1,100 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+//
+//  LUXSim2evtBench.cc
+//
+//  Microbenchmark for the pulse generation in LUXSim2evt. This drives
+//  LUXSim2evtPulse::GeneratePulseVec on synthetic photon arrival times with
+//  the same pulse parameters LUXSim2evt uses for the default gains, and
+//  reports the time per call. No .bin file is needed.
+//
+//  Build and run with "make bench" in this directory.
+//
+//////////////////////////////////////////////////////////////////////////////
+//
+//  Change Log:
+//
+//  19 Oct   2026 - Initial Submission
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//
+//  C/C++ includes
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <vector>
+#include <iostream>
+
+//
+//  LUXSim2evt includes
+//
+
+#include "LUXSim2evtPulse.hh"
+#include "LUXSim2evtMethods.hh"
+
+using namespace std;
+
+//  Each pulse size is called repeatedly for at least this long, so the slow
+//  S2-sized pulses get fewer calls than the single photoelectrons.
+#define MIN_BENCH_TIME 0.5 /*s*/
+
+double Seconds() {
+    struct timeval tv;
+    gettimeofday( &tv, NULL );
+    return tv.tv_sec + 1.e-6*tv.tv_usec;
+}
+
+//============================================================================
+//            BenchPulse
+//============================================================================
+// Times GeneratePulseVec for pulses of numPhotons photons spread over
+// spreadTime ns. The pulse is rebuilt for each call, as it is in LUXSim2evt.
+void BenchPulse(const char* label, int numPhotons, double spreadTime) {
+    vector<double> photon_times(numPhotons);
+    for(int i=0; i<numPhotons; i++)
+        photon_times[i] = 1000. + Rand()*spreadTime;
+
+    long calls = 0;
+    unsigned long long samples = 0;
+    double start = Seconds();
+    double elapsed = 0;
+    while(elapsed < MIN_BENCH_TIME) {
+        LUXSim2evtPulse* pulse = new LUXSim2evtPulse();
+        pulse->SetTimeOffset(0);
+        pulse->SetGain(16); // mVns, as for the flat gains in LUXSim2evt
+        pulse->SetSpheSigma(7.5);
+        pulse->SetRiseTime(0.80);
+        pulse->SetFallTime(14.3);
+        pulse->SetAmplitude(1.04286*.001*7.5*
+                (pulse->GetGain()/(pulse->GetRiseTime()-pulse->GetFallTime())));
+        pulse->GeneratePulseVec(photon_times);
+        samples += pulse->GetData().size();
+        delete pulse;
+        calls++;
+        elapsed = Seconds() - start;
+    }
+
+    printf("  %-32s %10ld %14.1f %12.1f\n", label, calls, 1.e9*elapsed/calls,
+            (double)samples/calls);
+}
+
+//============================================================================
+//            main
+//============================================================================
+int main() {
+    srand(1001);
+
+    cout << endl << "LUXSim2evt pulse generation microbenchmark" << endl;
+    printf("  %-32s %10s %14s %12s\n", "kernel", "calls", "ns/call",
+            "samples");
+    BenchPulse("GeneratePulseVec (1 phe)", 1, 0.);
+    BenchPulse("GeneratePulseVec (10 phe, S1)", 10, 100.);
+    BenchPulse("GeneratePulseVec (100 phe, S1)", 100, 100.);
+    BenchPulse("GeneratePulseVec (1000 phe, S2)", 1000, 2000.);
+    cout << endl;
+
+    return 0;
+}
@@ -0,0 +1,249 @@
+################################################################################
+# LUXSimOpticalReweight.py for the LUXSim package
+#
+# Change log:
+# 19 Oct 2026 - Initial submission
+#
+################################################################################
+#
+# This script reweights a LUXSim run for different optical parameters, using
+# the optical path file written with
+#
+#     /LUXSim/io/opticalPaths true
+#
+# That file (<outputName><seed>_optPaths.bin) has a record for every photon
+# that reached a photocathode: the path length and number of Rayleigh scatters
+# in each material, and the number of reflections off each optical surface.
+# The probability of that path changes with the optical parameters as
+#
+#     reflectivity R -> R'         (R'/R)^k             for k reflections
+#     absorption length A -> A'    exp( -L/A' + L/A )   for a path length L
+#     Rayleigh length S -> S'      (S/S')^n exp( -L/S' + L/S )
+#                                                       for n scatters
+#
+# and the product of these factors is the weight of the photon. The weighted
+# sum of the phe of the photons in an event is the mean number of phe the
+# event would have had with the new parameters, so one run can stand in for
+# a whole scan of the parameters.
+#
+# Run with:
+#     $ python LUXSimOpticalReweight.py LUXOut123_optPaths.bin \
+#           --reflectivity liquidXeTeflonSurface 0.95 0.90,0.975,0.99 \
+#           --absorption liquidXe 1e5 500,1000,5000 \
+#           --rayleigh liquidXe 300 300,300,400
+#
+# Lengths are in mm, as set in LUXSimMaterials, and "inf" is an infinite
+# length. The new values can be a comma-separated list, one per point of the
+# scan; a parameter with a single new value keeps it for every point. Each
+# line of the output has the event number, the phe in the run, and then the
+# reweighted phe for each point (or, with --weights, the ratio of the
+# reweighted to the original phe).
+#
+# Run without any parameters to list the materials and surfaces in the file,
+# with the number of photons that went through each.
+#
+# Only the photons that reached a photocathode are recorded, which is all
+# that's needed for the phe counts, but not for anything that depends on the
+# photons that were lost. The reflectivity of a surface is the probability of
+# reflecting off it, as it is for the painted PTFE surfaces; a transmission
+# through a surface with a reflectivity isn't counted. The reweighted counts
+# are unbiased, but get noisier the further the new parameters are from the
+# ones in the run, because fewer of the simulated paths look like the typical
+# path with the new parameters.
+#
+################################################################################
+
+import sys
+from math import exp
+from struct import unpack, calcsize
+
+
+def ReadValues(file, fmt):
+    data = file.read(calcsize(fmt))
+    if len(data) < calcsize(fmt):
+        return None
+    return unpack(fmt, data)
+
+
+def ReadOpticalPaths(fileName):
+    # Returns the material and surface names, and a list of photons, each of
+    # which is (event, phe, materials, surfaces), with materials a list of
+    # (index, path length, Rayleigh scatters) and surfaces a list of (index,
+    # reflections). The photon weight from the optical photon roulette is
+    # already in the phe count.
+    materialNames = {}
+    surfaceNames = {}
+    photons = []
+    file = open(fileName, 'rb')
+    while True:
+        recordType = ReadValues(file, '=i')
+        if recordType is None:
+            break
+        recordType = recordType[0]
+        if recordType == 1 or recordType == 2:
+            index, size = ReadValues(file, '=ii')
+            name = file.read(size).decode()
+            if recordType == 1:
+                materialNames[index] = name
+            else:
+                surfaceNames[index] = name
+        elif recordType == 3:
+            event, track, volume, phe, weight, energy = \
+                ReadValues(file, '=iiiidd')
+            materials = []
+            for i in range(ReadValues(file, '=i')[0]):
+                materials.append(ReadValues(file, '=idi'))
+            surfaces = []
+            for i in range(ReadValues(file, '=i')[0]):
+                surfaces.append(ReadValues(file, '=ii'))
+            photons.append((event, phe, materials, surfaces))
+        else:
+            sys.stderr.write("Unknown record type %d in %s\n"
+                             % (recordType, fileName))
+            sys.exit(1)
+    file.close()
+    return materialNames, surfaceNames, photons
+
+
+def InverseLength(length):
+    return 1. / float(length)
+
+
+def ParseArguments(argv):
+    # Each parameter is (kind, name, nominal value, [new values])
+    fileName = None
+    printWeights = False
+    parameters = []
+    i = 1
+    while i < len(argv):
+        if argv[i] in ('--reflectivity', '--absorption', '--rayleigh'):
+            if i + 3 >= len(argv):
+                sys.stderr.write("%s needs a name, the value in the run and "
+                                 "the new values\n" % argv[i])
+                sys.exit(1)
+            newValues = [float(v) for v in argv[i+3].split(',')]
+            parameters.append((argv[i][2:], argv[i+1], float(argv[i+2]),
+                               newValues))
+            i += 4
+        elif argv[i] == '--weights':
+            printWeights = True
+            i += 1
+        elif fileName is None:
+            fileName = argv[i]
+            i += 1
+        else:
+            sys.stderr.write("Unknown argument %s\n" % argv[i])
+            sys.exit(1)
+    if fileName is None:
+        sys.stderr.write("Usage: python LUXSimOpticalReweight.py FILE "
+                         "[--reflectivity SURFACE R NEW_R[,...]] "
+                         "[--absorption MATERIAL LENGTH NEW_LENGTH[,...]] "
+                         "[--rayleigh MATERIAL LENGTH NEW_LENGTH[,...]] "
+                         "[--weights]\n")
+        sys.exit(1)
+    return fileName, printWeights, parameters
+
+
+def main(argv):
+    fileName, printWeights, parameters = ParseArguments(argv)
+    materialNames, surfaceNames, photons = ReadOpticalPaths(fileName)
+
+    if not parameters:
+        materialCounts = dict((i, 0) for i in materialNames)
+        surfaceCounts = dict((i, 0) for i in surfaceNames)
+        for event, phe, materials, surfaces in photons:
+            for index, length, scatters in materials:
+                materialCounts[index] += 1
+            for index, reflections in surfaces:
+                surfaceCounts[index] += 1
+        print("%d photons" % len(photons))
+        print("Materials:")
+        for i in sorted(materialNames):
+            print("    %-40s %d" % (materialNames[i], materialCounts[i]))
+        print("Surfaces:")
+        for i in sorted(surfaceNames):
+            print("    %-40s %d" % (surfaceNames[i], surfaceCounts[i]))
+        return
+
+    numPoints = max(len(p[3]) for p in parameters)
+    for kind, name, nominal, newValues in parameters:
+        if len(newValues) != 1 and len(newValues) != numPoints:
+            sys.stderr.write("The %s of %s has %d new values, but the scan "
+                             "has %d points\n" % (kind, name, len(newValues),
+                                                  numPoints))
+            sys.exit(1)
+        names = surfaceNames if kind == 'reflectivity' else materialNames
+        if name not in names.values():
+            sys.stderr.write("Warning: no photon in %s went through %s\n"
+                             % (fileName, name))
+
+    # For each point of the scan, the factors by surface and material index
+    reflectionFactors = []
+    absorptionTerms = []
+    rayleighFactors = []
+    rayleighTerms = []
+    for point in range(numPoints):
+        reflectionFactor = {}
+        absorptionTerm = {}
+        rayleighFactor = {}
+        rayleighTerm = {}
+        for kind, name, nominal, newValues in parameters:
+            new = newValues[min(point, len(newValues) - 1)]
+            if kind == 'reflectivity':
+                for i in surfaceNames:
+                    if surfaceNames[i] == name:
+                        reflectionFactor[i] = new / nominal
+            elif kind == 'absorption':
+                for i in materialNames:
+                    if materialNames[i] == name:
+                        absorptionTerm[i] = InverseLength(new) - \
+                            InverseLength(nominal)
+            else:
+                for i in materialNames:
+                    if materialNames[i] == name:
+                        rayleighFactor[i] = nominal / new
+                        rayleighTerm[i] = InverseLength(new) - \
+                            InverseLength(nominal)
+        reflectionFactors.append(reflectionFactor)
+        absorptionTerms.append(absorptionTerm)
+        rayleighFactors.append(rayleighFactor)
+        rayleighTerms.append(rayleighTerm)
+
+    events = []
+    phePerEvent = {}
+    reweightedPerEvent = {}
+    for event, phe, materials, surfaces in photons:
+        if event not in phePerEvent:
+            events.append(event)
+            phePerEvent[event] = 0
+            reweightedPerEvent[event] = [0.] * numPoints
+        phePerEvent[event] += phe
+        if phe == 0:
+            continue
+        for point in range(numPoints):
+            weight = 1.
+            exponent = 0.
+            for index, reflections in surfaces:
+                if index in reflectionFactors[point]:
+                    weight *= reflectionFactors[point][index] ** reflections
+            for index, length, scatters in materials:
+                if index in absorptionTerms[point]:
+                    exponent -= length * absorptionTerms[point][index]
+                if index in rayleighTerms[point]:
+                    weight *= rayleighFactors[point][index] ** scatters
+                    exponent -= length * rayleighTerms[point][index]
+            reweightedPerEvent[event][point] += phe * weight * exp(exponent)
+
+    for event in events:
+        values = reweightedPerEvent[event]
+        if printWeights:
+            if phePerEvent[event]:
+                values = [v / phePerEvent[event] for v in values]
+            else:
+                values = [1.] * numPoints
+        print("%d %d %s" % (event, phePerEvent[event],
+                            ' '.join('%.6g' % v for v in values)))
+
+
+if __name__ == '__main__':
+    main(sys.argv)
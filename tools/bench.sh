@@ -0,0 +1,172 @@
+#!/usr/bin/env bash
+################################################################################
+# Shell script to run the LUXSim benchmark suite. Each macro in
+# LUXSimMacros/bench is run with a fixed seed and event count, and the wall
+# time, CPU time and peak memory of the run are written as one tab-separated
+# line per workload. The results can be compared against a saved baseline to
+# catch performance regressions.
+#
+# Change log:
+#
+# 19-Oct-2026 - Initial submission
+#
+################################################################################
+
+# === Instructions ===
+#
+# From the base LUXSim dir, after building, run
+#
+#     make bench
+#
+# or call the script directly:
+#
+#     ./tools/bench.sh [-o results.tsv] [-b baseline.tsv] [-t tolerance] \
+#                      [-p] [macro ...]
+#
+#   -o  Where to write the results (default ./LUXSimBench.tsv). Save this file
+#       to use it as a baseline later.
+#   -b  Compare against a baseline results file. Any workload whose wall or CPU
+#       time is more than the tolerance above the baseline is flagged, and the
+#       script exits with status 1.
+#   -t  Tolerance for the comparison, in percent (default 10).
+#   -p  Also turn on /LUXSim/io/profile and keep the per-workload profile and
+#       log files next to the results.
+#
+# With no macros given, every LUXSimMacros/bench/*.mac is run. The binary
+# output of each run goes to a scratch directory that is deleted at the end.
+
+results=./LUXSimBench.tsv
+baseline=
+tolerance=10
+profile=0
+
+while getopts "o:b:t:p" opt; do
+    case $opt in
+        o) results=$OPTARG ;;
+        b) baseline=$OPTARG ;;
+        t) tolerance=$OPTARG ;;
+        p) profile=1 ;;
+        *) echo "Usage: $0 [-o results.tsv] [-b baseline.tsv] [-t tolerance] [-p] [macro ...]"
+           exit 2 ;;
+    esac
+done
+shift $((OPTIND-1))
+
+if [ ! -x ./LUXSimExecutable ]; then
+    echo "./LUXSimExecutable not found. Build LUXSim and run this from the"
+    echo "top-level LUXSim directory."
+    exit 2
+fi
+
+if [ -n "$baseline" ] && [ ! -r "$baseline" ]; then
+    echo "Cannot read baseline file $baseline"
+    exit 2
+fi
+
+macros=("$@")
+if [ ${#macros[@]} -eq 0 ]; then
+    macros=(./LUXSimMacros/bench/*.mac)
+fi
+
+# GNU time gives us the peak resident memory. Without it (e.g., OS X) the
+# memory column is reported as -1.
+gnutime=
+if /usr/bin/time -f "%e" true > /dev/null 2>&1; then
+    gnutime=/usr/bin/time
+fi
+
+scratch=$(mktemp -d /tmp/LUXSimBench.XXXXXX)
+logdir=$(dirname "$results")/LUXSimBenchLogs
+[ $profile -eq 1 ] && mkdir -p "$logdir"
+
+# Results header. Keep the column order stable; the comparison below and any
+# external monitoring depend on it.
+printf "workload\twall_s\tcpu_s\tmaxrss_kb\tevents\tstatus\n" > "$results"
+
+for macro in "${macros[@]}"; do
+    name=$(basename "$macro" .mac)
+    events=$(grep '^/LUXSim/beamOn' "$macro" | awk '{n+=$2} END {print n+0}')
+
+    # The wrapper macro points the output at the scratch directory and supplies
+    # the exit, so the bench macros themselves stay runnable by hand.
+    wrapper=$scratch/$name.wrapper.mac
+    echo "/LUXSim/io/outputDir $scratch"     > "$wrapper"
+    [ $profile -eq 1 ] && echo "/LUXSim/io/profile true" >> "$wrapper"
+    echo "/control/execute $macro"          >> "$wrapper"
+    echo "exit"                             >> "$wrapper"
+
+    echo "Running $name ($events events)..."
+    timefile=$scratch/$name.time
+    logfile=$scratch/$name.log
+    if [ -n "$gnutime" ]; then
+        $gnutime -f "%e %U %S %M" -o "$timefile" \
+            ./LUXSimExecutable -f "$wrapper" > "$logfile" 2>&1
+        status=$?
+        read wall user sys maxrss < "$timefile"
+        cpu=$(echo "$user + $sys" | bc)
+    else
+        start=$(date +%s.%N)
+        ./LUXSimExecutable -f "$wrapper" > "$logfile" 2>&1
+        status=$?
+        end=$(date +%s.%N)
+        wall=$(echo "$end - $start" | bc)
+        cpu=-1
+        maxrss=-1
+    fi
+
+    if [ $status -eq 0 ] && grep -q "Run did not end cleanly" "$logfile"; then
+        status=1
+    fi
+    [ $status -eq 0 ] && state=ok || state=failed
+
+    printf "%s\t%s\t%s\t%s\t%s\t%s\n" "$name" "$wall" "$cpu" "$maxrss" \
+        "$events" "$state" >> "$results"
+
+    if [ $profile -eq 1 ]; then
+        cp "$logfile" "$logdir/"
+        cp "$scratch"/*_profile.txt "$logdir/" 2>/dev/null
+        rm -f "$scratch"/*_profile.txt
+    fi
+    rm -f "$scratch"/*.bin "$scratch"/*.bin.tmp
+done
+
+rm -rf "$scratch"
+
+echo
+column -t -s $'\t' "$results" 2>/dev/null || cat "$results"
+echo
+echo "Results saved to $results"
+
+[ -z "$baseline" ] && exit 0
+
+# Compare against the baseline. Workloads missing from either file are listed
+# but don't count as regressions.
+echo
+echo "Comparison against $baseline (tolerance $tolerance%):"
+awk -F'\t' -v tol="$tolerance" '
+    FNR == 1 { next }
+    NR == FNR { bwall[$1] = $2; bcpu[$1] = $3; brss[$1] = $4; next }
+    {
+        if( !($1 in bwall) ) {
+            printf "  %-22s  not in baseline\n", $1
+            next
+        }
+        flag = ""
+        if( $6 != "ok" ) flag = "  FAILED"
+        else if( bwall[$1] > 0 && $2 > bwall[$1]*(1 + tol/100.) )
+            flag = "  REGRESSION"
+        else if( bcpu[$1] > 0 && $3 > bcpu[$1]*(1 + tol/100.) )
+            flag = "  REGRESSION"
+        if( flag != "" ) bad = 1
+        wr = ( bwall[$1] > 0 ) ? 100.*($2 - bwall[$1])/bwall[$1] : 0
+        cr = ( bcpu[$1] > 0 && $3 >= 0 ) ? 100.*($3 - bcpu[$1])/bcpu[$1] : 0
+        mr = ( brss[$1] > 0 && $4 >= 0 ) ? 100.*($4 - brss[$1])/brss[$1] : 0
+        printf "  %-22s  wall %+7.1f%%  cpu %+7.1f%%  rss %+7.1f%%%s\n", \
+            $1, wr, cr, mr, flag
+        seen[$1] = 1
+    }
+    END {
+        for( w in bwall ) if( !(w in seen) )
+            printf "  %-22s  not run\n", w
+        exit bad
+    }' "$baseline" "$results"